@@ -0,0 +1,46 @@
+#pragma once
+
+#include <babocar-core/types.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+namespace bcr {
+namespace bench {
+
+/* @brief Measures average execution time of a function.
+ * @tparam F Type of the function.
+ * @param func The function to measure.
+ * @param numRuns Number of runs to average.
+ * @returns The average execution time in microseconds.
+ **/
+template <typename F>
+float64_t measure_us(F func, uint32_t numRuns) {
+    func(); // warm-up
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numRuns; ++i) {
+        func();
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<float64_t, std::micro>(end - start).count() / numRuns;
+}
+
+/* @brief Prints benchmark result.
+ * @param name The benchmark name.
+ * @param time_us The measured time in microseconds.
+ * @param numItems Number of items processed during one run - used for throughput calculation.
+ **/
+inline void report(const char *name, float64_t time_us, uint32_t numItems = 1) {
+    std::printf("%-48s %12.3f us %14.3f Mitems/s\n", name, time_us, numItems / time_us);
+}
+
+/* @brief Prevents the compiler from optimizing away a value.
+ * @param value The value.
+ **/
+template <typename T>
+void do_not_optimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
+} // namespace bcr
@@ -0,0 +1,46 @@
+#include <babocar-core/cluster_tracker.hpp>
+
+#include "bench.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace bcr;
+
+int main() {
+    static constexpr uint32_t NUM_TRACKS = 200;
+    static constexpr uint32_t NUM_FRAMES = 1000;
+    const second_t d_time(0.05);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float64_t> posDist(-20.0, 20.0), velDist(-1.0, 1.0);
+    std::normal_distribution<float64_t> noise(0.0, 0.01);
+
+    std::vector<Point2d> pos(NUM_TRACKS), vel(NUM_TRACKS);
+    for (uint32_t i = 0; i < NUM_TRACKS; ++i) {
+        pos[i] = { posDist(gen), posDist(gen) };
+        vel[i] = { velDist(gen), velDist(gen) };
+    }
+
+    // pre-generates frames so that only the association is measured
+    std::vector<std::vector<Point2m>> frames(NUM_FRAMES, std::vector<Point2m>(NUM_TRACKS));
+    for (std::vector<Point2m>& frame : frames) {
+        for (uint32_t i = 0; i < NUM_TRACKS; ++i) {
+            pos[i] += vel[i] * d_time.get();
+            frame[i] = { meter_t(pos[i].X + noise(gen)), meter_t(pos[i].Y + noise(gen)) };
+        }
+        std::shuffle(frame.begin(), frame.end(), gen);
+    }
+
+    static ClusterTracker<NUM_TRACKS> tracker(meter_t(0.5));
+    uint32_t ids[NUM_TRACKS];
+    uint32_t frameIdx = 0;
+
+    const float64_t time_us = bench::measure_us([&]() {
+        const std::vector<Point2m>& frame = frames[frameIdx++ % NUM_FRAMES];
+        bench::do_not_optimize(tracker.update(frame.data(), frame.size(), d_time, ids));
+    }, NUM_FRAMES - 1);
+
+    bench::report("ClusterTracker<200>::update (200 clusters)", time_us, NUM_TRACKS);
+    return 0;
+}
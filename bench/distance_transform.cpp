@@ -0,0 +1,86 @@
+#include <babocar-core/distance_transform.hpp>
+#include <babocar-core/random.hpp>
+
+#include "bench.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace bcr;
+
+/* Measures the distance transform of a 1024x1024 grid (51.2 m at 5 cm): full recalculation with different thread counts,
+ * incremental update after a few changed cells (e.g. new obstacles detected between frames), and interpolated queries.
+ */
+
+namespace {
+
+static constexpr uint32_t SIZE = 1024;
+static constexpr uint32_t NUM_QUERIES = 100000;
+
+typedef DistanceTransform<SIZE> transform_type;
+
+// track walls on a 2 m grid with gaps, and random clutter
+bool isOccupied(uint32_t x, uint32_t y) {
+    return ((x % 40 == 0 || y % 40 == 0) && (x + y) % 97 > 10) || hash32(x * SIZE + y) % 500 == 0;
+}
+
+} // namespace
+
+int main() {
+    const std::unique_ptr<transform_type> dt(new transform_type(meter_t(0.05)));
+
+    const uint32_t threadCounts[] = { 1, 2, 4 };
+    for (uint32_t numThreads : threadCounts) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "full update      %u thread", numThreads);
+        // alternates between two maps so that every row and column changes
+        bench::report(name, bench::measure_us([&]() {
+            dt->assign([](uint32_t x, uint32_t y) { return isOccupied(x + 1, y + 1); });
+            dt->update(numThreads);
+            dt->assign(isOccupied);
+            dt->update(numThreads);
+            bench::do_not_optimize(dt);
+        }, 5) / 2, SIZE * SIZE);
+    }
+
+    bench::report("(assign only)", bench::measure_us([&]() {
+        dt->assign([](uint32_t x, uint32_t y) { return isOccupied(x, y) != ((x ^ y) == 1); });
+        dt->assign(isOccupied);
+        bench::do_not_optimize(dt);
+    }, 5) / 2, SIZE * SIZE);
+    dt->update();
+
+    // 10 cells toggled per frame
+    xorshift32 random(5);
+    uint32_t numColumns = 0, numUpdates = 0;
+    std::vector<uint32_t> changed(20);
+    bench::report("incremental update, 10 cells", bench::measure_us([&]() {
+        for (uint32_t i = 0; i < 10; ++i) {
+            changed[2 * i] = random() % SIZE;
+            changed[2 * i + 1] = random() % SIZE;
+            dt->set(changed[2 * i], changed[2 * i + 1], !isOccupied(changed[2 * i], changed[2 * i + 1]));
+        }
+        numColumns += dt->update();
+        for (uint32_t i = 0; i < 10; ++i) {
+            dt->set(changed[2 * i], changed[2 * i + 1], isOccupied(changed[2 * i], changed[2 * i + 1]));
+        }
+        numColumns += dt->update();
+        numUpdates += 2;
+    }, 100) / 2);
+    std::printf("  recalculated columns per update: %u\n", numColumns / numUpdates);
+
+    std::vector<Point2m> queries(NUM_QUERIES);
+    for (uint32_t i = 0; i < NUM_QUERIES; ++i) {
+        const float64_t x = (random() % 51200) * 0.001;
+        queries[i] = Point2m(meter_t(x), meter_t((random() % 51200) * 0.001));
+    }
+    bench::report("bilinear query", bench::measure_us([&]() {
+        float64_t sum = 0.0;
+        for (uint32_t i = 0; i < NUM_QUERIES; ++i) {
+            sum += dt->distance(queries[i]).get();
+        }
+        bench::do_not_optimize(sum);
+    }, 20), NUM_QUERIES);
+
+    return 0;
+}
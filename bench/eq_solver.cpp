@@ -0,0 +1,251 @@
+#include <babocar-core/eq_solver.hpp>
+#include <babocar-core/random.hpp>
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace bcr;
+
+/* Compares the textbook quadratic formula with the stable formulation (scalar and batch),
+ * and measures the relative error of the smaller root against a long double reference, when B^2 >> 4*A*C.
+ * The batch loop is only vectorized with -fno-math-errno.
+ *
+ * Measures the execution time and the accuracy of the cubic, quartic and general polynomial solvers.
+ * The polynomials are built from random roots (at least 0.5 apart) in [-10, 10], the reference roots are calculated
+ * with long double Newton iterations on the rounded coefficients (so the rounding of the coefficients is not counted as error).
+ * The error is relative for roots larger than 1, absolute otherwise.
+ */
+
+namespace {
+
+static constexpr uint32_t SIZE = 4096;
+
+template <typename T>
+std::pair<T, T> solve_quadratic_textbook(const T& A, const T& B, const T& C) {
+    const T det = B * B - 4 * A * C;
+    std::pair<T, T> result = { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() };
+    if (det >= 0) {
+        const T sq = std::sqrt(det);
+        result.first  = (-B + sq) / (2 * A);
+        result.second = (-B - sq) / (2 * A);
+    }
+    return result;
+}
+
+template <typename T>
+void run(const char *typeName) {
+    std::vector<T> A(SIZE), B(SIZE), C(SIZE), x1(SIZE), x2(SIZE);
+    std::vector<uint32_t> numRoots(SIZE);
+
+    xorshift32 rng;
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        A[i] = static_cast<T>(0.5 + rng.uniform01());
+        B[i] = static_cast<T>(-1.0 - 1000.0 * rng.uniform01());
+        C[i] = static_cast<T>(0.5 + rng.uniform01());
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "textbook          %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            const std::pair<T, T> r = solve_quadratic_textbook(A[i], B[i], C[i]);
+            x1[i] = r.first;
+            x2[i] = r.second;
+        }
+        bench::do_not_optimize(x1);
+        bench::do_not_optimize(x2);
+    }, 1000), SIZE);
+
+    std::snprintf(name, sizeof(name), "stable scalar     %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            const std::pair<T, T> r = solve_quadratic(A[i], B[i], C[i]);
+            x1[i] = r.first;
+            x2[i] = r.second;
+        }
+        bench::do_not_optimize(x1);
+        bench::do_not_optimize(x2);
+    }, 1000), SIZE);
+
+    std::snprintf(name, sizeof(name), "stable batch      %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        bench::do_not_optimize(solve_quadratic(A.data(), B.data(), C.data(), SIZE, x1.data(), x2.data(), numRoots.data()));
+        bench::do_not_optimize(x1);
+        bench::do_not_optimize(x2);
+    }, 1000), SIZE);
+
+    // accuracy of the smaller root (the second root is the larger one as B is negative)
+    float64_t maxErrTextbook = 0.0, maxErrStable = 0.0;
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        const long double a = A[i], b = B[i], c = C[i];
+        const long double ref = (2 * c) / (-b + std::sqrt(b * b - 4 * a * c));
+        maxErrTextbook = bcr::max(maxErrTextbook, static_cast<float64_t>(std::fabs((solve_quadratic_textbook(A[i], B[i], C[i]).second - ref) / ref)));
+        maxErrStable = bcr::max(maxErrStable, static_cast<float64_t>(std::fabs((solve_quadratic(A[i], B[i], C[i]).second - ref) / ref)));
+    }
+    std::printf("max relative error of smaller root, %s: textbook %.3e, stable %.3e\n", typeName, maxErrTextbook, maxErrStable);
+}
+
+// multiplies polynomial (coeffs[i] is the coefficient of x^i) by (x - root)
+void multiply_root(long double *coeffs, uint32_t degree, long double root) {
+    coeffs[degree + 1] = coeffs[degree];
+    for (uint32_t i = degree; i > 0; --i) {
+        coeffs[i] = coeffs[i - 1] - root * coeffs[i];
+    }
+    coeffs[0] = -root * coeffs[0];
+}
+
+long double polish_reference(const long double *coeffs, uint32_t degree, long double x) {
+    for (uint32_t it = 0; it < 50; ++it) {
+        long double p = coeffs[degree], d = 0;
+        for (uint32_t i = degree; i-- > 0;) {
+            d = d * x + p;
+            p = p * x + coeffs[i];
+        }
+        if (d == 0) {
+            break;
+        }
+        x -= p / d;
+    }
+    return x;
+}
+
+template <typename T, uint32_t degree>
+struct polynomial_set {
+    static constexpr uint32_t NUM = 1024;
+    T coeffs[NUM][degree + 1];          // coeffs[k][i] is the coefficient of x^i
+    long double ref[NUM][degree];       // reference roots, increasing
+    uint32_t numRef[NUM];               // number of real roots
+
+    // numReal roots are real, the rest of the roots are complex conjugate pairs
+    explicit polynomial_set(uint32_t numReal) {
+        xorshift32 rng(degree * 1000 + numReal);
+        for (uint32_t k = 0; k < NUM; ++k) {
+            long double c[degree + 1] = { 1 };
+            uint32_t d = 0;
+            long double roots[degree];
+            for (uint32_t i = 0; i < numReal; ++i) {
+                roots[i] = -10 + 20 * static_cast<long double>(rng.uniform01());
+                bool close = false;
+                for (uint32_t j = 0; j < i; ++j) {
+                    close |= std::fabs(roots[i] - roots[j]) < 0.5L;
+                }
+                if (close) {
+                    --i;
+                    continue;
+                }
+                multiply_root(c, d++, roots[i]);
+            }
+            for (; d + 2 <= degree;) {
+                // x^2 - 2*re*x + re^2 + im^2
+                const long double re = -10 + 20 * static_cast<long double>(rng.uniform01()), im = 0.5L + 5 * static_cast<long double>(rng.uniform01());
+                long double quad[degree + 1];
+                for (uint32_t i = 0; i <= degree; ++i) {
+                    quad[i] = 0;
+                }
+                for (uint32_t i = 0; i <= d; ++i) {
+                    quad[i] += c[i] * (re * re + im * im);
+                    quad[i + 1] += c[i] * -2 * re;
+                    quad[i + 2] += c[i];
+                }
+                d += 2;
+                for (uint32_t i = 0; i <= d; ++i) {
+                    c[i] = quad[i];
+                }
+            }
+            const long double scale = 0.5L + static_cast<long double>(rng.uniform01());   // leading coefficient
+            long double rounded[degree + 1];
+            for (uint32_t i = 0; i <= degree; ++i) {
+                this->coeffs[k][i] = static_cast<T>(c[i] * scale);
+                rounded[i] = this->coeffs[k][i];
+            }
+            std::sort(roots, roots + numReal);
+            for (uint32_t i = 0; i < numReal; ++i) {
+                this->ref[k][i] = polish_reference(rounded, degree, roots[i]);
+            }
+            this->numRef[k] = numReal;
+        }
+    }
+
+    // returns the maximum error of the roots, or infinity if the number of roots is wrong
+    float64_t error(uint32_t k, const T *roots, uint32_t n) const {
+        if (n != this->numRef[k]) {
+            return std::numeric_limits<float64_t>::infinity();
+        }
+        float64_t err = 0.0;
+        for (uint32_t i = 0; i < n; ++i) {
+            err = bcr::max(err, static_cast<float64_t>(std::fabs(roots[i] - this->ref[k][i]) / bcr::max(1.0L, std::fabs(this->ref[k][i]))));
+        }
+        return err;
+    }
+};
+
+template <typename T>
+void run_polynomials(const char *typeName) {
+    char name[64];
+
+    for (uint32_t numReal = 1; numReal <= 3; numReal += 2) {
+        const polynomial_set<T, 3> set(numReal);
+        T roots[3];
+        float64_t err = 0.0;
+        for (uint32_t k = 0; k < set.NUM; ++k) {
+            const uint32_t n = solve_cubic(set.coeffs[k][3], set.coeffs[k][2], set.coeffs[k][1], set.coeffs[k][0], roots);
+            err = bcr::max(err, set.error(k, roots, n));
+        }
+        std::snprintf(name, sizeof(name), "solve_cubic       %s, %u real", typeName, numReal);
+        bench::report(name, bench::measure_us([&]() {
+            for (uint32_t k = 0; k < set.NUM; ++k) {
+                bench::do_not_optimize(solve_cubic(set.coeffs[k][3], set.coeffs[k][2], set.coeffs[k][1], set.coeffs[k][0], roots));
+                bench::do_not_optimize(roots);
+            }
+        }, 100), set.NUM);
+        std::printf("    max error: %.3e\n", err);
+    }
+
+    for (uint32_t numReal = 0; numReal <= 4; numReal += 2) {
+        const polynomial_set<T, 4> set(numReal);
+        T roots[4];
+        float64_t err = 0.0;
+        for (uint32_t k = 0; k < set.NUM; ++k) {
+            const uint32_t n = solve_quartic(set.coeffs[k][4], set.coeffs[k][3], set.coeffs[k][2], set.coeffs[k][1], set.coeffs[k][0], roots);
+            err = bcr::max(err, set.error(k, roots, n));
+        }
+        std::snprintf(name, sizeof(name), "solve_quartic     %s, %u real", typeName, numReal);
+        bench::report(name, bench::measure_us([&]() {
+            for (uint32_t k = 0; k < set.NUM; ++k) {
+                bench::do_not_optimize(solve_quartic(set.coeffs[k][4], set.coeffs[k][3], set.coeffs[k][2], set.coeffs[k][1], set.coeffs[k][0], roots));
+                bench::do_not_optimize(roots);
+            }
+        }, 100), set.NUM);
+        std::printf("    max error: %.3e\n", err);
+    }
+
+    for (uint32_t numReal = 4; numReal <= 6; numReal += 2) {
+        const polynomial_set<T, 6> set(numReal);
+        T roots[6];
+        float64_t err = 0.0;
+        for (uint32_t k = 0; k < set.NUM; ++k) {
+            const uint32_t n = solve_polynomial<6>(set.coeffs[k], 6, T(-20), T(20), roots);
+            err = bcr::max(err, set.error(k, roots, n));
+        }
+        std::snprintf(name, sizeof(name), "solve_polynomial  %s, deg 6, %u real", typeName, numReal);
+        bench::report(name, bench::measure_us([&]() {
+            for (uint32_t k = 0; k < set.NUM; ++k) {
+                bench::do_not_optimize(solve_polynomial<6>(set.coeffs[k], 6, T(-20), T(20), roots));
+                bench::do_not_optimize(roots);
+            }
+        }, 100), set.NUM);
+        std::printf("    max error: %.3e\n", err);
+    }
+}
+
+} // namespace
+
+int main() {
+    run<float32_t>("float");
+    run<float64_t>("double");
+    run_polynomials<float32_t>("float");
+    run_polynomials<float64_t>("double");
+    return 0;
+}
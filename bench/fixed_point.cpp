@@ -0,0 +1,84 @@
+#include <babocar-core/units.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+/* Compares unit arithmetic throughput of floating-point and fixed-point storage types.
+ * On x86 the hardware FPU makes double and float fast, on an FPU-less microcontroller every floating-point operation
+ * is a library call. The software floating-point cost is approximated here with __float128, which is emulated on x86 as well
+ * (it is an upper bound, as quad precision emulation is slower than double precision emulation).
+ */
+
+namespace {
+
+static constexpr uint32_t SIZE = 4096;
+
+template <typename S>
+void run(const char *name) {
+    typedef with_storage<meter_t, S> distance_type;
+    typedef with_storage<m_per_sec_t, S> speed_type;
+    typedef with_storage<second_t, S> time_type;
+
+    std::vector<distance_type> pos(SIZE), target(SIZE);
+    std::vector<speed_type> speed(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        pos[i] = distance_type(S(0.001 * i));
+        target[i] = distance_type(S(0.002 * i + 0.5));
+        speed[i] = speed_type(S(0.1 + 0.0001 * i));
+    }
+
+    const time_type dt(S(0.005));
+    const S kp(0.8);
+
+    // position integration and proportional speed controller
+    const float64_t us = bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            pos[i] += speed[i] * dt;
+            speed[i] = speed_type((target[i] - pos[i]).template get<true>() * kp);
+        }
+        bench::do_not_optimize(pos);
+        bench::do_not_optimize(speed);
+    }, 1000);
+
+    bench::report(name, us, SIZE);
+}
+
+#ifdef __SIZEOF_FLOAT128__
+void runSoftFloat(const char *name) {
+    typedef __float128 S;
+    std::vector<S> pos(SIZE), target(SIZE), speed(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        pos[i] = 0.001 * i;
+        target[i] = 0.002 * i + 0.5;
+        speed[i] = 0.1 + 0.0001 * i;
+    }
+
+    const S dt = 0.005, kp = 0.8;
+    const float64_t us = bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            pos[i] += speed[i] * dt;
+            speed[i] = (target[i] - pos[i]) * kp;
+        }
+        bench::do_not_optimize(pos);
+        bench::do_not_optimize(speed);
+    }, 1000);
+
+    bench::report(name, us, SIZE);
+}
+#endif // __SIZEOF_FLOAT128__
+
+} // namespace
+
+int main() {
+    run<float64_t>("float64_t (hardware FPU)");
+    run<float32_t>("float32_t (hardware FPU)");
+    run<q16_16_t>("q16_16_t");
+    run<q32_32_t>("q32_32_t");
+#ifdef __SIZEOF_FLOAT128__
+    runSoftFloat("software floating point (__float128 proxy)");
+#endif // __SIZEOF_FLOAT128__
+    return 0;
+}
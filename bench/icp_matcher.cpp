@@ -0,0 +1,103 @@
+#include <babocar-core/icp_matcher.hpp>
+#include <babocar-core/random.hpp>
+#include <babocar-core/scan_geometry.hpp>
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <memory>
+
+using namespace bcr;
+
+/* Measures frame-to-frame matching of synthetic 2000-beam lidar scans of a room with obstacles, taken from two poses.
+ * The correspondence search is timed with different thread counts - the threads are started in every iteration,
+ * so multithreading only pays off for large scans.
+ */
+
+namespace {
+
+static constexpr uint32_t NUM_BEAMS = 2000;
+
+typedef IcpMatcher<NUM_BEAMS> matcher_type;
+
+// walls of the room and the sides of two boxes, as (x1, y1, x2, y2)
+const float32_t WALLS[][4] = {
+    { 0.0f, 0.0f, 8.0f, 0.0f }, { 8.0f, 0.0f, 8.0f, 3.0f }, { 8.0f, 3.0f, 5.0f, 3.0f }, { 5.0f, 3.0f, 5.0f, 6.0f },
+    { 5.0f, 6.0f, 0.0f, 6.0f }, { 0.0f, 6.0f, 0.0f, 0.0f },
+    { 2.0f, 4.0f, 2.6f, 4.0f }, { 2.6f, 4.0f, 2.6f, 4.5f }, { 2.6f, 4.5f, 2.0f, 4.5f }, { 2.0f, 4.5f, 2.0f, 4.0f },
+    { 6.5f, 1.0f, 7.0f, 1.5f }, { 7.0f, 1.5f, 6.5f, 2.0f }, { 6.5f, 2.0f, 6.0f, 1.5f }, { 6.0f, 1.5f, 6.5f, 1.0f }
+};
+
+// simulates the ranges measured from a pose, with gaussian range noise
+void scan(const ScanGeometry<NUM_BEAMS>& geometry, const Pose& pose, float32_t *ranges, xorshift32& random) {
+    for (uint32_t i = 0; i < geometry.size(); ++i) {
+        float64_t s, c;
+        bcr::sincos(pose.angle + geometry.angle(i), s, c);
+        const float32_t ox = static_cast<float32_t>(pose.pos.X.get()), oy = static_cast<float32_t>(pose.pos.Y.get());
+        float32_t range = 30.0f;
+        for (const float32_t *w : WALLS) {
+            // ray-segment intersection: o + t * d = a + u * (b - a)
+            const float32_t ex = w[2] - w[0], ey = w[3] - w[1];
+            const float32_t den = static_cast<float32_t>(c) * ey - static_cast<float32_t>(s) * ex;
+            if (std::abs(den) < 1e-9f) {
+                continue;
+            }
+            const float32_t ax = w[0] - ox, ay = w[1] - oy;
+            const float32_t t = (ax * ey - ay * ex) / den;
+            const float32_t u = (ax * static_cast<float32_t>(s) - ay * static_cast<float32_t>(c)) / den;
+            if (t > 0.0f && u >= 0.0f && u <= 1.0f) {
+                range = bcr::min(range, t);
+            }
+        }
+        ranges[i] = range + 0.01f * random.normal();
+    }
+}
+
+} // namespace
+
+int main() {
+    static const ScanGeometry<NUM_BEAMS> geometry(radian_t(-3.14159265), radian_t(6.28318531 / NUM_BEAMS), NUM_BEAMS, meter_t(0.05), meter_t(30.0));
+    const Pose pose1 = { Point2m(meter_t(3.0), meter_t(2.0)), radian_t(0.1) };
+    const Pose pose2 = { Point2m(meter_t(3.15), meter_t(2.08)), radian_t(0.16) };
+    const SE2f expected = SE2f(pose1).inverse().compose(SE2f(pose2));
+
+    xorshift32 random(7);
+    float32_t ranges[NUM_BEAMS];
+    Point2f ref[NUM_BEAMS], points[NUM_BEAMS];
+    scan(geometry, pose1, ranges, random);
+    const uint32_t numRef = geometry.toPoints(ranges, ref);
+    scan(geometry, pose2, ranges, random);
+    const uint32_t numPoints = geometry.toPoints(ranges, points);
+
+    const matcher_type::Metric metrics[] = { matcher_type::Metric::POINT_TO_POINT, matcher_type::Metric::POINT_TO_LINE };
+    const char *const metricNames[] = { "point-to-point", "point-to-line " };
+    const uint32_t threadCounts[] = { 1, 2, 4 };
+
+    for (uint32_t m = 0; m < 2; ++m) {
+        const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5), metrics[m]));
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "setReference     %s", metricNames[m]);
+        bench::report(name, bench::measure_us([&]() {
+            matcher->setReference(ref, numRef);
+            bench::do_not_optimize(matcher);
+        }, 1000), numRef);
+
+        matcher_type::Result result;
+        SE2f transform;
+        for (uint32_t numThreads : threadCounts) {
+            std::snprintf(name, sizeof(name), "match            %s %u thread", metricNames[m], numThreads);
+            bench::report(name, bench::measure_us([&]() {
+                transform = SE2f();
+                result = matcher->match(points, numPoints, transform, numThreads);
+                bench::do_not_optimize(transform);
+            }, 100), numPoints);
+        }
+
+        std::printf("  iterations: %u, inliers: %u / %u, position error: %.2f mm, angle error: %.3f mrad\n", result.iterations, result.numInliers, numPoints,
+            1000.0f * std::hypot(transform.translation().X - expected.translation().X, transform.translation().Y - expected.translation().Y),
+            1000.0 * std::abs((transform.angle() - expected.angle()).get()));
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <babocar-core/map_file.hpp>
+#include <babocar-core/random.hpp>
+
+#include "bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace bcr;
+
+/* Measures the startup time of a 100 MB map: parsing a text grid (one integer per cell) into a heap array,
+ * reading the binary file into a heap array, and opening the memory-mapped binary file - without and with 1000 random cell queries.
+ * The files are in the page cache (written just before), so the results show the CPU cost, not the disk throughput.
+ */
+
+namespace {
+
+static constexpr uint32_t TILE_BITS = 4;
+static constexpr uint32_t TILE_CELLS = 1u << (2 * TILE_BITS);
+static constexpr uint32_t SIZE_TILES = 448;                             // 200704 tiles, 102.8 MB
+static constexpr uint32_t SIZE = SIZE_TILES << TILE_BITS;               // 7168 x 7168 cells
+static constexpr uint32_t NUM_QUERIES = 1000;
+
+// synthetic track map: walls on a 2 m grid (5 cm cells), free space between them, a few unknown regions
+int16_t cellValue(uint32_t x, uint32_t y) {
+    return x % 40 == 0 || y % 40 == 0 ? 3584 : (x / 1000 + y / 1000) % 5 == 0 ? 0 : -2048;
+}
+
+void writeText(const char *fileName) {
+    FILE *file = std::fopen(fileName, "w");
+    std::fprintf(file, "%u %u 0.05\n", SIZE, SIZE);
+    std::vector<char> line;
+    for (uint32_t y = 0; y < SIZE; ++y) {
+        line.clear();
+        for (uint32_t x = 0; x < SIZE; ++x) {
+            char buffer[8];
+            const int len = std::snprintf(buffer, sizeof(buffer), x + 1 < SIZE ? "%d " : "%d\n", cellValue(x, y));
+            line.insert(line.end(), buffer, buffer + len);
+        }
+        std::fwrite(line.data(), 1, line.size(), file);
+    }
+    std::fclose(file);
+}
+
+void writeBinary(const char *fileName) {
+    std::vector<int16_t> data(static_cast<size_t>(SIZE_TILES) * SIZE_TILES * TILE_CELLS);
+    std::vector<Point2i> keys;
+    std::vector<const int16_t*> tiles;
+    for (uint32_t ty = 0; ty < SIZE_TILES; ++ty) {
+        for (uint32_t tx = 0; tx < SIZE_TILES; ++tx) {
+            int16_t *const tile = &data[keys.size() * TILE_CELLS];
+            for (uint32_t i = 0; i < TILE_CELLS; ++i) {
+                tile[i] = cellValue((tx << TILE_BITS) + (i & 15), (ty << TILE_BITS) + (i >> TILE_BITS));
+            }
+            keys.push_back(Point2i(tx, ty));
+            tiles.push_back(tile);
+        }
+    }
+    writeMapFile(fileName, meter_t(0.05), TILE_BITS, keys.data(), tiles.data(), static_cast<uint32_t>(keys.size()));
+}
+
+// parses the text grid into a row-major heap array
+std::vector<int16_t> parseText(const char *fileName) {
+    FILE *file = std::fopen(fileName, "rb");
+    std::fseek(file, 0, SEEK_END);
+    std::vector<char> text(static_cast<size_t>(std::ftell(file)) + 1);
+    std::fseek(file, 0, SEEK_SET);
+    text.resize(std::fread(text.data(), 1, text.size() - 1, file) + 1);
+    text.back() = '\0';
+    std::fclose(file);
+
+    char *p = text.data();
+    const uint32_t width = std::strtoul(p, &p, 10), height = std::strtoul(p, &p, 10);
+    std::strtod(p, &p);
+    std::vector<int16_t> cells(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < cells.size(); ++i) {
+        cells[i] = static_cast<int16_t>(std::strtol(p, &p, 10));
+    }
+    return cells;
+}
+
+std::vector<char> readBinary(const char *fileName) {
+    FILE *file = std::fopen(fileName, "rb");
+    std::fseek(file, 0, SEEK_END);
+    std::vector<char> data(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    data.resize(std::fread(data.data(), 1, data.size(), file));
+    std::fclose(file);
+    return data;
+}
+
+} // namespace
+
+int main() {
+    const std::string textName = "/tmp/babocar_core_bench_map.txt", binaryName = "/tmp/babocar_core_bench_map.bin";
+    writeText(textName.c_str());
+    writeBinary(binaryName.c_str());
+    std::printf("text size: %.1f MB, binary size: %.1f MB\n", readBinary(textName.c_str()).size() * 1e-6, readBinary(binaryName.c_str()).size() * 1e-6);
+
+    xorshift32 random(1);
+    std::vector<Point2i> queries(NUM_QUERIES);
+    for (uint32_t i = 0; i < NUM_QUERIES; ++i) {
+        const int32_t x = random() % SIZE;
+        queries[i] = Point2i(x, random() % SIZE);
+    }
+
+    bench::report("text parse -> heap array", bench::measure_us([&]() {
+        bench::do_not_optimize(parseText(textName.c_str()));
+    }, 3));
+
+    bench::report("binary read -> heap array", bench::measure_us([&]() {
+        bench::do_not_optimize(readBinary(binaryName.c_str()));
+    }, 3));
+
+    bench::report("MapFile::open (mmap)", bench::measure_us([&]() {
+        MapFile map;
+        map.open(binaryName.c_str());
+        bench::do_not_optimize(map);
+    }, 10));
+
+    bench::report("MapFile::open + 1000 random queries", bench::measure_us([&]() {
+        MapFile map;
+        map.open(binaryName.c_str());
+        int32_t sum = 0;
+        for (uint32_t i = 0; i < NUM_QUERIES; ++i) {
+            sum += map.cell(queries[i]);
+        }
+        bench::do_not_optimize(sum);
+    }, 10));
+
+    std::remove(textName.c_str());
+    std::remove(binaryName.c_str());
+    return 0;
+}
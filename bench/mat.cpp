@@ -0,0 +1,172 @@
+#include <babocar-core/mat.hpp>
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace bcr;
+
+/* Compares the fixed-size matrix with a naive implementation (runtime dimensions, triple loop)
+ * and with heap-allocated nested vectors (as in the hand-rolled filters).
+ */
+
+namespace {
+
+static constexpr uint32_t NUM = 1024;
+
+void multiply_naive(const float64_t *a, const float64_t *b, float64_t *result, uint32_t R, uint32_t K, uint32_t C) {
+    for (uint32_t i = 0; i < R; ++i) {
+        for (uint32_t j = 0; j < C; ++j) {
+            float64_t s = 0.0;
+            for (uint32_t k = 0; k < K; ++k) {
+                s += a[i * K + k] * b[k * C + j];
+            }
+            result[i * C + j] = s;
+        }
+    }
+}
+
+typedef std::vector<std::vector<float64_t>> heap_mat;
+
+heap_mat multiply_heap(const heap_mat& a, const heap_mat& b) {
+    heap_mat result(a.size(), std::vector<float64_t>(b[0].size(), 0.0));
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b[0].size(); ++j) {
+            for (size_t k = 0; k < b.size(); ++k) {
+                result[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T, uint32_t N>
+void run_multiply() {
+    typedef mat<T, N, N> mat_t;
+    std::vector<mat_t> a(NUM), b(NUM), r(NUM);
+    for (uint32_t m = 0; m < NUM; ++m) {
+        for (uint32_t i = 0; i < N * N; ++i) {
+            a[m][i] = static_cast<T>((m + i) % 7) * T(0.25);
+            b[m][i] = static_cast<T>((m * i) % 5) * T(0.5);
+        }
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "mat<%s, %u, %u> multiply", sizeof(T) == 4 ? "float" : "double", N, N);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t m = 0; m < NUM; ++m) {
+            r[m] = a[m] * b[m];
+        }
+        bench::do_not_optimize(r);
+    }, 1000), NUM);
+
+    if (sizeof(T) == 8) {
+        std::vector<float64_t> ra(NUM * N * N), rb(NUM * N * N), rr(NUM * N * N);
+        std::vector<heap_mat> ha(NUM, heap_mat(N, std::vector<float64_t>(N))), hb = ha, hr;
+        for (uint32_t m = 0; m < NUM; ++m) {
+            for (uint32_t i = 0; i < N * N; ++i) {
+                ra[m * N * N + i] = ha[m][i / N][i % N] = static_cast<float64_t>(a[m][i]);
+                rb[m * N * N + i] = hb[m][i / N][i % N] = static_cast<float64_t>(b[m][i]);
+            }
+        }
+        hr.resize(NUM);
+
+        std::snprintf(name, sizeof(name), "naive %ux%u multiply (runtime size)", N, N);
+        bench::report(name, bench::measure_us([&]() {
+            for (uint32_t m = 0; m < NUM; ++m) {
+                multiply_naive(&ra[m * N * N], &rb[m * N * N], &rr[m * N * N], N, N, N);
+            }
+            bench::do_not_optimize(rr);
+        }, 1000), NUM);
+
+        std::snprintf(name, sizeof(name), "heap %ux%u multiply (nested vectors)", N, N);
+        bench::report(name, bench::measure_us([&]() {
+            for (uint32_t m = 0; m < NUM; ++m) {
+                hr[m] = multiply_heap(ha[m], hb[m]);
+            }
+            bench::do_not_optimize(hr);
+        }, 100), NUM);
+    }
+}
+
+// covariance propagation and Cholesky solve of a 3-state filter: P = F * P * F^T + Q, x = P^-1 * b
+void run_filter() {
+    const mat3d F(1.0, 0.0, -0.01, 0.0, 1.0, 0.02, 0.0, 0.0, 1.0);
+    const mat3d Q = mat3d::diagonal(mat<float64_t, 3, 1>(1e-4, 1e-4, 1e-5));
+    const mat<float64_t, 3, 1> b(1.0, 2.0, 3.0);
+
+    mat3d P = mat3d::identity();
+    mat<float64_t, 3, 1> x;
+    bench::report("mat3d F*P*F^T + Q, solveCholesky", bench::measure_us([&]() {
+        for (uint32_t m = 0; m < NUM; ++m) {
+            P = F * P * F.transpose() + Q;
+            P.solveCholesky(b, x);
+            bench::do_not_optimize(x);
+        }
+        P = mat3d::identity();
+    }, 1000), NUM);
+
+    std::vector<float64_t> Fn(F.data(), F.data() + 9), Qn(Q.data(), Q.data() + 9), Pn(9), tmp(9), Ft(9);
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            Ft[j * 3 + i] = Fn[i * 3 + j];
+        }
+    }
+    std::vector<float64_t> xn(3);
+    bench::report("naive F*P*F^T + Q, Cholesky solve", bench::measure_us([&]() {
+        for (uint32_t m = 0; m < NUM; ++m) {
+            multiply_naive(Fn.data(), Pn.data(), tmp.data(), 3, 3, 3);
+            multiply_naive(tmp.data(), Ft.data(), Pn.data(), 3, 3, 3);
+            for (uint32_t i = 0; i < 9; ++i) {
+                Pn[i] += Qn[i];
+            }
+            // Cholesky with runtime size
+            std::vector<float64_t> L(9, 0.0);
+            for (uint32_t j = 0; j < 3; ++j) {
+                float64_t d = Pn[j * 3 + j];
+                for (uint32_t k = 0; k < j; ++k) {
+                    d -= L[j * 3 + k] * L[j * 3 + k];
+                }
+                L[j * 3 + j] = std::sqrt(d);
+                for (uint32_t i = j + 1; i < 3; ++i) {
+                    float64_t s = Pn[i * 3 + j];
+                    for (uint32_t k = 0; k < j; ++k) {
+                        s -= L[i * 3 + k] * L[j * 3 + k];
+                    }
+                    L[i * 3 + j] = s / L[j * 3 + j];
+                }
+            }
+            for (uint32_t i = 0; i < 3; ++i) {
+                float64_t s = b[i];
+                for (uint32_t k = 0; k < i; ++k) {
+                    s -= L[i * 3 + k] * xn[k];
+                }
+                xn[i] = s / L[i * 3 + i];
+            }
+            for (uint32_t i = 3; i-- > 0;) {
+                float64_t s = xn[i];
+                for (uint32_t k = i + 1; k < 3; ++k) {
+                    s -= L[k * 3 + i] * xn[k];
+                }
+                xn[i] = s / L[i * 3 + i];
+            }
+            bench::do_not_optimize(xn);
+        }
+        std::fill(Pn.begin(), Pn.end(), 0.0);
+        Pn[0] = Pn[4] = Pn[8] = 1.0;
+    }, 1000), NUM);
+}
+
+} // namespace
+
+int main() {
+    run_multiply<float32_t, 2>();
+    run_multiply<float64_t, 2>();
+    run_multiply<float32_t, 3>();
+    run_multiply<float64_t, 3>();
+    run_multiply<float32_t, 4>();
+    run_multiply<float64_t, 4>();
+    run_filter();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <babocar-core/occupancy_grid.hpp>
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace bcr;
+
+/* Measures scan insertion into the tiled grid, compared to a row-major float array updated directly by the ray tracing
+ * (every cell is updated by every ray crossing it, the rays near the sensor write the same cells repeatedly).
+ * OccupancyGrid::insertScan skips the rays ending in the same cell as the previous one, castRay is measured without this.
+ * The scan is taken in a 12x8 m room with a 5 cm grid, the window is 51.2 x 51.2 m.
+ */
+
+namespace {
+
+static constexpr uint32_t NUM_BEAMS = 10000;
+
+typedef OccupancyGrid<64, 4> grid_type;
+
+// row-major float grid with direct updates
+struct NaiveGrid {
+    static constexpr int32_t SIZE = grid_type::SIZE;
+    std::vector<float32_t> cells;
+
+    NaiveGrid() : cells(SIZE * SIZE, 0.0f) {}
+
+    void update(int32_t x, int32_t y, float32_t inc) {
+        float32_t& c = this->cells[(y + SIZE / 2) * SIZE + x + SIZE / 2];
+        c = bcr::clamp(c + inc, -2.0f, 3.5f);
+    }
+
+    void castRay(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+        const int32_t dx = std::abs(x1 - x0), dy = -std::abs(y1 - y0);
+        const int32_t sx = x1 > x0 ? 1 : -1, sy = y1 > y0 ? 1 : -1;
+        int32_t err = dx + dy;
+        while (x0 != x1 || y0 != y1) {
+            this->update(x0, y0, -0.4f);
+            const int32_t e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+        this->update(x0, y0, 0.85f);
+    }
+};
+
+} // namespace
+
+int main() {
+    // ray intersections with the walls of the room around the sensor at (1.3, 0.7)
+    const float32_t sx = 1.3f, sy = 0.7f;
+    std::vector<Point2f> points(NUM_BEAMS);
+    for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+        const float32_t a = 2.0f * PI.get() * i / NUM_BEAMS;
+        const float32_t c = std::cos(a), s = std::sin(a);
+        const float32_t tx = (c > 0.0f ? 6.0f - sx : 6.0f + sx) / std::abs(c);
+        const float32_t ty = (s > 0.0f ? 4.0f - sy : 4.0f + sy) / std::abs(s);
+        const float32_t t = bcr::min(tx, ty);
+        points[i] = Point2f(sx + t * c, sy + t * s);
+    }
+
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.05)));
+    const Point2m sensor = Point2m(meter_t(sx), meter_t(sy));
+    bench::report("OccupancyGrid::insertScan  10k beams", bench::measure_us([&]() {
+        grid->insertScan(sensor, points.data(), NUM_BEAMS);
+        bench::do_not_optimize(grid);
+    }, 100), NUM_BEAMS);
+
+    bench::report("OccupancyGrid::castRay    10k beams", bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+            grid->castRay(sensor, Point2m(meter_t(points[i].X), meter_t(points[i].Y)));
+        }
+        bench::do_not_optimize(grid);
+    }, 100), NUM_BEAMS);
+    grid->applyUpdates();
+
+    bench::report("OccupancyGrid::recenter", bench::measure_us([&]() {
+        grid->recenter(Point2m(meter_t(1000), meter_t(0)));
+        grid->recenter(sensor);
+        bench::do_not_optimize(grid);
+    }, 1000));
+
+    NaiveGrid naive;
+    const Point2i from = grid->cell(sensor);
+    std::vector<Point2i> ends(NUM_BEAMS);
+    for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+        ends[i] = grid->cell(Point2m(meter_t(points[i].X), meter_t(points[i].Y)));
+    }
+    bench::report("row-major float, direct    10k beams", bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+            naive.castRay(from.X, from.Y, ends[i].X, ends[i].Y);
+        }
+        bench::do_not_optimize(naive.cells);
+    }, 100), NUM_BEAMS);
+
+    uint64_t numCells = 0;
+    for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+        numCells += bcr::max(std::abs(ends[i].X - from.X), std::abs(ends[i].Y - from.Y)) + 1;
+    }
+    std::printf("  traced cells per scan: %llu\n", static_cast<unsigned long long>(numCells));
+    uint32_t numOccupied = 0;
+    for (int32_t y = -100; y < 100; ++y) {
+        for (int32_t x = -140; x < 140; ++x) {
+            numOccupied += grid->logOdds(Point2i(x, y)) > 0.0f ? 1 : 0;
+        }
+    }
+    std::printf("  occupied cells: %u\n", numOccupied);
+    return 0;
+}
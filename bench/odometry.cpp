@@ -0,0 +1,101 @@
+#include <babocar-core/odometry.hpp>
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace bcr;
+
+/* Compares the batch arc integration with calling Odometry::update (midpoint rotation) for every sample.
+ * The reference trajectory integrates every sample with the exact arc in long double, with direct trigonometric calls.
+ */
+
+namespace {
+
+std::vector<OdometrySample> make_samples(float64_t rate, float64_t duration) {
+    const uint32_t num = static_cast<uint32_t>(rate * duration);
+    std::vector<OdometrySample> samples(num);
+    for (uint32_t i = 0; i < num; ++i) {
+        const float64_t t = i / rate;
+        // slalom: speed and angular velocity vary smoothly, constant within a sample
+        samples[i] = { second_t(1.0 / rate), m_per_sec_t(2.0 + std::sin(0.5 * t)), rad_per_sec_t(1.5 * std::sin(1.3 * t)) };
+    }
+    return samples;
+}
+
+Pose reference(const std::vector<OdometrySample>& samples) {
+    long double x = 0, y = 0, angle = 0;
+    for (const OdometrySample& s : samples) {
+        const long double dt = second_t(s.d_time).get(), v = s.speed.get(), w = s.ang_vel.get();
+        const long double a = w * dt;
+        if (std::abs(a) < 1e-12L) {
+            x += v * dt * std::cos(angle);
+            y += v * dt * std::sin(angle);
+        } else {
+            x += v / w * (std::sin(angle + a) - std::sin(angle));
+            y += v / w * (std::cos(angle) - std::cos(angle + a));
+        }
+        angle += a;
+    }
+    return { Point2m(meter_t(static_cast<float64_t>(x)), meter_t(static_cast<float64_t>(y))), radian_t(static_cast<float64_t>(angle)) };
+}
+
+float64_t pos_error(const Pose& a, const Pose& b) {
+    return std::hypot((a.pos.X - b.pos.X).get(), (a.pos.Y - b.pos.Y).get());
+}
+
+Odometry start() {
+    Odometry odom;
+    odom.pose = { Point2m(meter_t(0), meter_t(0)), radian_t(0) };
+    odom.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+    return odom;
+}
+
+void run(float64_t rate) {
+    const std::vector<OdometrySample> samples = make_samples(rate, 60.0);
+    const uint32_t num = static_cast<uint32_t>(samples.size());
+    const Pose ref = reference(samples);
+
+    // the current method needs the speed vector in the frame of the pose for every sample
+    Odometry single;
+    const float64_t singleUs = bench::measure_us([&]() {
+        single = start();
+        for (const OdometrySample& s : samples) {
+            single.twist = { Point2mps(s.speed, m_per_sec_t(0)).rotate(single.pose.angle), s.ang_vel };
+            single.update(s.d_time);
+        }
+        bench::do_not_optimize(single);
+    }, 10);
+
+    Odometry batch;
+    const float64_t batchUs = bench::measure_us([&]() {
+        batch = start();
+        batch.update(samples.data(), num);
+        bench::do_not_optimize(batch);
+    }, 10);
+
+    std::vector<Pose> trajectory(num / 20);
+    const float64_t trajectoryUs = bench::measure_us([&]() {
+        Odometry odom = start();
+        odom.update(samples.data(), num, trajectory.data(), 20);
+        bench::do_not_optimize(trajectory);
+    }, 10);
+
+    std::printf("%.0f Hz, 60 s - position error: single %.3e m, batch %.3e m; angle error: single %.3e rad, batch %.3e rad\n", rate,
+        pos_error(ref, single.pose), pos_error(ref, batch.pose),
+        std::abs((ref.angle - single.pose.angle).get()), std::abs((ref.angle - batch.pose.angle).get()));
+
+    bench::report("Odometry::update per sample", singleUs, num);
+    bench::report("Odometry::update batch", batchUs, num);
+    bench::report("Odometry::update batch, trajectory / 20", trajectoryUs, num);
+}
+
+} // namespace
+
+int main() {
+    run(1000.0);
+    run(2000.0);
+    run(5000.0);
+    return 0;
+}
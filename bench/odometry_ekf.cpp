@@ -0,0 +1,64 @@
+#include <babocar-core/odometry_ekf.hpp>
+
+#include "bench.hpp"
+
+using namespace bcr;
+
+/* Measures the cost of the filter steps - the predict step runs at 1 kHz, so it must fit in a fraction of the 1 ms period.
+ */
+
+namespace {
+
+static constexpr uint32_t NUM = 1000;
+
+template <typename T>
+void run(const char *typeName) {
+    Odometry initial;
+    initial.pose = { Point2m(meter_t(0), meter_t(0)), radian_t(0) };
+    initial.twist = { Point2mps(m_per_sec_t(1), m_per_sec_t(0)), rad_per_sec_t(0.1) };
+    OdometryEKF<T> ekf(initial, OdometryEKF<T>::covariance_type::identity() * T(0.01), T(0.1), T(0.1));
+    const mat<T, 3, 3> poseCov = mat<T, 3, 3>::identity() * T(0.01);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "predict        %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM; ++i) {
+            ekf.predict(millisecond_t(1));
+        }
+        bench::do_not_optimize(ekf.state());
+    }, 100), NUM);
+
+    std::snprintf(name, sizeof(name), "updateSpeed    %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM; ++i) {
+            ekf.updateSpeed(m_per_sec_t(1 + (i & 1) * 0.01), T(0.01));
+        }
+        bench::do_not_optimize(ekf.state());
+    }, 100), NUM);
+
+    std::snprintf(name, sizeof(name), "updateAngVel   %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM; ++i) {
+            ekf.updateAngVel(rad_per_sec_t(0.1 + (i & 1) * 0.01), T(0.001));
+        }
+        bench::do_not_optimize(ekf.state());
+    }, 100), NUM);
+
+    std::snprintf(name, sizeof(name), "predict+updatePose %s", typeName);
+    bench::report(name, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < NUM; ++i) {
+            ekf.predict(millisecond_t(1));
+            const Pose fix = { Point2m(meter_t(0.01 * (i & 3)), meter_t(0)), radian_t(0.1) };
+            ekf.updatePose(fix, poseCov);
+        }
+        bench::do_not_optimize(ekf.state());
+    }, 100), NUM);
+}
+
+} // namespace
+
+int main() {
+    run<float32_t>("float");
+    run<float64_t>("double");
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <babocar-core/particle_filter.hpp>
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <memory>
+
+using namespace bcr;
+
+/* Measures the cost of the filter steps for different particle counts, localizing in a synthetic map of range beacons.
+ * The measurement weighting is timed with different thread counts - the threads are started in every call,
+ * so multithreading only pays off for large particle sets.
+ */
+
+namespace {
+
+static constexpr uint32_t CAPACITY = 100000;
+static constexpr uint32_t NUM_BEACONS = 16;
+
+typedef ParticleFilter<CAPACITY> filter_type;
+
+// synthetic map - beacons on a 4x4 grid with 2 m spacing, and the measured ranges from the true position (1.3, 2.1)
+struct BeaconMap {
+    float32_t x[NUM_BEACONS], y[NUM_BEACONS], range[NUM_BEACONS];
+
+    BeaconMap() {
+        for (uint32_t i = 0; i < NUM_BEACONS; ++i) {
+            this->x[i] = 2.0f * (i % 4);
+            this->y[i] = 2.0f * (i / 4);
+            this->range[i] = std::hypot(this->x[i] - 1.3f, this->y[i] - 2.1f);
+        }
+    }
+
+    void operator()(const filter_type::Particles& p) const {
+        static constexpr float32_t k = -0.5f / (0.1f * 0.1f);
+        for (uint32_t i = 0; i < p.size; ++i) {
+            float32_t sum2 = 0.0f;
+            for (uint32_t b = 0; b < NUM_BEACONS; ++b) {
+                const float32_t dx = p.x[i] - this->x[b], dy = p.y[i] - this->y[b];
+                const float32_t r = std::sqrt(dx * dx + dy * dy) - this->range[b];
+                sum2 += r * r;
+            }
+            p.weight[i] *= std::exp(k * sum2);
+        }
+    }
+};
+
+void run(filter_type& pf, const BeaconMap& map, uint32_t numParticles) {
+    const Pose start = { Point2m(meter_t(1.3), meter_t(2.1)), radian_t(0.3) };
+    const Twist twist = { Point2mps(m_per_sec_t(1), m_per_sec_t(0)), rad_per_sec_t(0.5) };
+    const uint32_t numRuns = 10000000 / numParticles;
+    pf.reset(start, meter_t(0.5), radian_t(0.2), numParticles);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "predict          %6u", numParticles);
+    bench::report(name, bench::measure_us([&]() {
+        pf.predict(twist, millisecond_t(10));
+        bench::do_not_optimize(pf.x()[0]);
+    }, numRuns), numParticles);
+
+    const uint32_t threadCounts[] = { 1, 2, 4 };
+    for (uint32_t numThreads : threadCounts) {
+        std::snprintf(name, sizeof(name), "weight %u thread  %6u", numThreads, numParticles);
+        bench::report(name, bench::measure_us([&]() {
+            pf.reset(start, meter_t(0.5), radian_t(0.2), numParticles);
+            pf.weight(map, numThreads);
+            bench::do_not_optimize(pf.weights()[0]);
+        }, numRuns / 10 + 1), numParticles);
+    }
+
+    std::snprintf(name, sizeof(name), "resample         %6u", numParticles);
+    bench::report(name, bench::measure_us([&]() {
+        pf.resample();
+        bench::do_not_optimize(pf.x()[0]);
+    }, numRuns), numParticles);
+
+    std::snprintf(name, sizeof(name), "(reset)          %6u", numParticles);
+    bench::report(name, bench::measure_us([&]() {
+        pf.reset(start, meter_t(0.5), radian_t(0.2), numParticles);
+        bench::do_not_optimize(pf.x()[0]);
+    }, numRuns), numParticles);
+
+    pf.reset(start, meter_t(0.5), radian_t(0.2), numParticles);
+    pf.weight(map);
+    const Pose estimate = pf.estimate();
+    std::printf("  estimate error: %.3f m (effective size: %.0f)\n", estimate.pos.distance(start.pos).get(), pf.effectiveSize());
+}
+
+} // namespace
+
+int main() {
+    const std::unique_ptr<filter_type> pf(new filter_type(m_per_sec_t(0.1), rad_per_sec_t(0.1)));
+    const BeaconMap map;
+    const uint32_t particleCounts[] = { 1000, 10000, 100000 };
+    for (uint32_t numParticles : particleCounts) {
+        run(*pf, map, numParticles);
+    }
+    return 0;
+}
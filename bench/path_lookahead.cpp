@@ -0,0 +1,55 @@
+#include <babocar-core/path_lookahead.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+int main() {
+    static constexpr uint32_t NUM_POINTS = 2000;
+    static constexpr float32_t LOOKAHEAD = 1.5f;
+
+    std::vector<Point2f> path(NUM_POINTS);
+    std::vector<float32_t> x(NUM_POINTS), y(NUM_POINTS), t(NUM_POINTS);
+    for (uint32_t i = 0; i < NUM_POINTS; ++i) {
+        const float32_t a = 0.002f * i;
+        path[i] = { 50.0f * std::sin(a), 30.0f * std::sin(2.0f * a) };
+        x[i] = path[i].X;
+        y[i] = path[i].Y;
+    }
+
+    // one lap: the vehicle is at every path point once, and the lookahead point is searched in every cycle
+    bench::report("lineCircle + bounds check, from start", bench::measure_us([&]() {
+        for (uint32_t v = 0; v < NUM_POINTS; v += 10) {
+            Point2f result;
+            for (uint32_t i = 0; i + 1 < NUM_POINTS; ++i) {
+                const std::pair<Point2f, Point2f> intersections = bcr::lineCircle_intersection(Line2f(path[i], path[i + 1]), path[v], LOOKAHEAD);
+                const Point2f& p = intersections.first;
+                if (!std::isnan(p.X) && bcr::min(path[i].X, path[i + 1].X) <= p.X && p.X <= bcr::max(path[i].X, path[i + 1].X) && i >= v) {
+                    result = p;
+                    break;
+                }
+            }
+            bench::do_not_optimize(result);
+        }
+    }, 10), NUM_POINTS / 10);
+
+    bench::report("segmentCircle_exit batch, whole path", bench::measure_us([&]() {
+        for (uint32_t v = 0; v < NUM_POINTS; v += 10) {
+            bench::do_not_optimize(bcr::segmentCircle_exit(x.data(), y.data(), NUM_POINTS, path[v], LOOKAHEAD, t.data()));
+            bench::do_not_optimize(t);
+        }
+    }, 10), NUM_POINTS / 10);
+
+    bench::report("PathLookahead", bench::measure_us([&]() {
+        PathLookahead<float32_t> lookahead;
+        for (uint32_t v = 0; v < NUM_POINTS; v += 10) {
+            Point2f result;
+            bench::do_not_optimize(lookahead.find(path.data(), NUM_POINTS, path[v], LOOKAHEAD, result));
+            bench::do_not_optimize(result);
+        }
+    }, 10), NUM_POINTS / 10);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <babocar-core/ransac.hpp>
+
+#include "bench.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+// generates a scan of walls: numLines lines and 10% outliers
+std::vector<Point2f> generateScan(uint32_t numPoints, uint32_t numLines, std::mt19937& gen) {
+    std::uniform_real_distribution<float32_t> uniform(-10.0f, 10.0f), angle(0.0f, 3.1415926f);
+    std::normal_distribution<float32_t> noise(0.0f, 0.01f);
+
+    std::vector<Point2f> points;
+    const uint32_t numOutliers = numPoints / 10;
+    const uint32_t pointsPerLine = (numPoints - numOutliers) / numLines;
+
+    for (uint32_t l = 0; l < numLines; ++l) {
+        const Point2f origin(uniform(gen), uniform(gen));
+        const float32_t a = angle(gen);
+        const Point2f dir(std::cos(a), std::sin(a));
+        for (uint32_t i = 0; i < pointsPerLine; ++i) {
+            const float32_t t = uniform(gen);
+            points.push_back({ origin.X + dir.X * t - dir.Y * noise(gen), origin.Y + dir.Y * t + dir.X * noise(gen) });
+        }
+    }
+    while (points.size() < numPoints) {
+        points.push_back({ uniform(gen), uniform(gen) });
+    }
+    std::shuffle(points.begin(), points.end(), gen);
+    return points;
+}
+
+} // namespace
+
+int main() {
+    static constexpr uint32_t NUM_POINTS = 5000;
+    std::mt19937 gen(42);
+
+    for (uint32_t numLines = 3; numLines <= 6; ++numLines) {
+        const std::vector<Point2f> scan = generateScan(NUM_POINTS, numLines, gen);
+        std::vector<Point2f> points;
+        Line2f lines[8];
+        uint32_t numInliers[8];
+        uint32_t numExtracted = 0;
+
+        LineRansac<float32_t> ransac(0.03f, 100);
+        const float64_t time_us = bench::measure_us([&]() {
+            points = scan;
+            numExtracted = ransac.extract(points.data(), points.size(), lines, numInliers, 8);
+        }, 100);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "LineRansac::extract (5k points, %u lines)", numLines);
+        bench::report(name, time_us, NUM_POINTS);
+        std::printf("    extracted %u lines\n", numExtracted);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <babocar-core/scan_geometry.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+int main() {
+    static constexpr uint32_t NUM_BEAMS = 1080;
+    static const ScanGeometry<NUM_BEAMS> geometry(radian_t(-2.35619449), radian_t(4.71238898 / NUM_BEAMS), NUM_BEAMS, meter_t(0.05), meter_t(30.0));
+
+    std::vector<float32_t> ranges(NUM_BEAMS);
+    for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+        ranges[i] = i % 17 ? 1.0f + 0.01f * (i % 300) : 30.0f;
+    }
+
+    std::vector<Point2f> points(NUM_BEAMS);
+    std::vector<Point2m> pointsM(NUM_BEAMS);
+    std::vector<float32_t> x(NUM_BEAMS), y(NUM_BEAMS);
+    const Pose pose = { Point2m(meter_t(2.0), meter_t(-1.0)), radian_t(0.7) };
+    const SE2m transform(pose);
+
+    bench::report("normVec per beam        -> Point2f", bench::measure_us([&]() {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+            if (ranges[i] >= 0.05f && ranges[i] < 30.0f) {
+                points[n++] = Point2f::normVec(geometry.angle(i)) * ranges[i];
+            }
+        }
+        bench::do_not_optimize(points);
+    }, 1000), NUM_BEAMS);
+
+    bench::report("ScanGeometry            -> Point2f", bench::measure_us([&]() {
+        geometry.toPoints(ranges.data(), points.data());
+        bench::do_not_optimize(points);
+    }, 1000), NUM_BEAMS);
+
+    bench::report("ScanGeometry            -> SoA float", bench::measure_us([&]() {
+        geometry.toPoints(ranges.data(), x.data(), y.data());
+        bench::do_not_optimize(x);
+        bench::do_not_optimize(y);
+    }, 1000), NUM_BEAMS);
+
+    bench::report("normVec + SE2 per beam  -> Point2m", bench::measure_us([&]() {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+            if (ranges[i] >= 0.05f && ranges[i] < 30.0f) {
+                pointsM[n++] = transform.apply(Point2m::normVec(geometry.angle(i)) * static_cast<float64_t>(ranges[i]));
+            }
+        }
+        bench::do_not_optimize(pointsM);
+    }, 1000), NUM_BEAMS);
+
+    bench::report("ScanGeometry + Pose     -> Point2m", bench::measure_us([&]() {
+        geometry.toPoints(ranges.data(), pose, pointsM.data());
+        bench::do_not_optimize(pointsM);
+    }, 1000), NUM_BEAMS);
+
+    return 0;
+}
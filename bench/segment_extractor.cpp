@@ -0,0 +1,97 @@
+#include <babocar-core/ransac.hpp>
+#include <babocar-core/random.hpp>
+#include <babocar-core/scan_geometry.hpp>
+#include <babocar-core/segment_extractor.hpp>
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace bcr;
+
+/* Measures segment extraction from synthetic 360 degree lidar scans of a room with obstacles, for different beam counts.
+ * The sequential RANSAC extraction of the same scans is measured as a reference - it fits lines to arbitrary point subsets.
+ */
+
+namespace {
+
+static constexpr uint32_t MAX_BEAMS = 10000;
+static constexpr uint32_t MAX_SEGMENTS = 256;
+
+// walls of the room and the sides of two boxes, as (x1, y1, x2, y2)
+const float32_t WALLS[][4] = {
+    { 0.0f, 0.0f, 8.0f, 0.0f }, { 8.0f, 0.0f, 8.0f, 3.0f }, { 8.0f, 3.0f, 5.0f, 3.0f }, { 5.0f, 3.0f, 5.0f, 6.0f },
+    { 5.0f, 6.0f, 0.0f, 6.0f }, { 0.0f, 6.0f, 0.0f, 0.0f },
+    { 2.0f, 4.0f, 2.6f, 4.0f }, { 2.6f, 4.0f, 2.6f, 4.5f }, { 2.6f, 4.5f, 2.0f, 4.5f }, { 2.0f, 4.5f, 2.0f, 4.0f },
+    { 6.5f, 1.0f, 7.0f, 1.5f }, { 7.0f, 1.5f, 6.5f, 2.0f }, { 6.5f, 2.0f, 6.0f, 1.5f }, { 6.0f, 1.5f, 6.5f, 1.0f }
+};
+
+// simulates the ranges measured from a pose, with gaussian range noise
+void scan(const ScanGeometry<MAX_BEAMS>& geometry, const Pose& pose, float32_t *ranges, xorshift32& random) {
+    for (uint32_t i = 0; i < geometry.size(); ++i) {
+        float64_t s, c;
+        bcr::sincos(pose.angle + geometry.angle(i), s, c);
+        const float32_t ox = static_cast<float32_t>(pose.pos.X.get()), oy = static_cast<float32_t>(pose.pos.Y.get());
+        float32_t range = 30.0f;
+        for (const float32_t *w : WALLS) {
+            // ray-segment intersection: o + t * d = a + u * (b - a)
+            const float32_t ex = w[2] - w[0], ey = w[3] - w[1];
+            const float32_t den = static_cast<float32_t>(c) * ey - static_cast<float32_t>(s) * ex;
+            if (std::abs(den) < 1e-9f) {
+                continue;
+            }
+            const float32_t ax = w[0] - ox, ay = w[1] - oy;
+            const float32_t t = (ax * ey - ay * ex) / den;
+            const float32_t u = (ax * static_cast<float32_t>(s) - ay * static_cast<float32_t>(c)) / den;
+            if (t > 0.0f && u >= 0.0f && u <= 1.0f) {
+                range = bcr::min(range, t);
+            }
+        }
+        ranges[i] = range + 0.005f * random.normal();
+    }
+}
+
+} // namespace
+
+int main() {
+    const Pose pose = { Point2m(meter_t(3.0), meter_t(2.0)), radian_t(0.1) };
+    const uint32_t beamCounts[] = { 1000, 2000, 5000, 10000 };
+
+    SegmentExtractor<float32_t> extractor(0.03f, 0.015f, 0.15f);
+    LineRansac<float32_t> ransac(0.03f, 20);
+    std::vector<SegmentExtractor<float32_t>::Segment> segments(MAX_SEGMENTS);
+    std::vector<Line2<float32_t>> lines(MAX_SEGMENTS);
+    std::vector<uint32_t> numInliers(MAX_SEGMENTS);
+    std::vector<float32_t> ranges(MAX_BEAMS);
+    std::vector<Point2f> points(MAX_BEAMS), shuffled(MAX_BEAMS);
+
+    for (uint32_t numBeams : beamCounts) {
+        const std::unique_ptr<ScanGeometry<MAX_BEAMS>> geometry(new ScanGeometry<MAX_BEAMS>(radian_t(-3.14159265), radian_t(6.28318531 / numBeams), numBeams,
+            meter_t(0.05), meter_t(30.0)));
+        xorshift32 random(numBeams);
+        scan(*geometry, pose, ranges.data(), random);
+        const uint32_t numPoints = geometry->toPoints(ranges.data(), points.data());
+
+        uint32_t numSegments = 0;
+        char name[64];
+        std::snprintf(name, sizeof(name), "split-and-merge  %5u points", numPoints);
+        bench::report(name, bench::measure_us([&]() {
+            numSegments = extractor.extract(points.data(), numPoints, segments.data(), MAX_SEGMENTS);
+            bench::do_not_optimize(segments);
+        }, 200000 / numPoints), numPoints);
+
+        uint32_t numLines = 0;
+        std::snprintf(name, sizeof(name), "RANSAC extract   %5u points", numPoints);
+        bench::report(name, bench::measure_us([&]() {
+            shuffled.assign(points.begin(), points.begin() + numPoints);
+            numLines = ransac.extract(shuffled.data(), numPoints, lines.data(), numInliers.data(), 32);
+            bench::do_not_optimize(lines);
+        }, 2000 / numPoints + 1), numPoints);
+
+        std::printf("  segments: %u, RANSAC lines: %u\n", numSegments, numLines);
+    }
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <babocar-core/static_kmeans.hpp>
+
+#include "bench.hpp"
+
+#include <random>
+
+using namespace bcr;
+
+namespace {
+
+template <uint32_t maxPoints, uint32_t maxGroups>
+void run(std::mt19937& gen) {
+    std::uniform_real_distribution<float64_t> dist(0.0, 2.0);
+
+    static vec<Point2m, maxPoints> points;
+    points.clear();
+    while (points.size() < maxPoints) {
+        points.append(Point2m(meter_t(dist(gen)), meter_t(dist(gen))));
+    }
+
+    static StaticKMeans<maxPoints, maxGroups> kmeans(points);
+    static StaticKMeans2<maxPoints, maxGroups> kmeans2(points, centimeter_t(5));
+
+    std::printf("StaticKMeans<%u, %u>:  static memory %6zu B\n", maxPoints, maxGroups, StaticKMeans<maxPoints, maxGroups>::staticMemory());
+    std::printf("StaticKMeans2<%u, %u>: static memory %6zu B\n", maxPoints, maxGroups, StaticKMeans2<maxPoints, maxGroups>::staticMemory());
+
+    bench::report("StaticKMeans::run", bench::measure_us([]() { bench::do_not_optimize(kmeans.run(maxGroups)); }, 100), maxPoints);
+    bench::report("StaticKMeans2::run", bench::measure_us([]() { bench::do_not_optimize(kmeans2.run()); }, 100), maxPoints);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(42);
+    run<64, 4>(gen);
+    run<256, 8>(gen);
+    run<1024, 16>(gen);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <babocar-core/trig.hpp>
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+template <typename policy, typename T>
+void run(const char *name) {
+    static constexpr uint32_t SIZE = 4096;
+    std::vector<T> angles(SIZE), y(SIZE), x(SIZE), s(SIZE), c(SIZE), r(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        angles[i] = static_cast<T>(-10.0 + 20.0 * i / SIZE);
+        y[i] = static_cast<T>(std::sin(angles[i]) * (1 + i % 7));
+        x[i] = static_cast<T>(std::cos(angles[i]) * (1 + i % 5));
+    }
+
+    const float64_t sincos_us = bench::measure_us([&]() {
+        sincos_batch<policy>(angles.data(), s.data(), c.data(), SIZE);
+        bench::do_not_optimize(s);
+    }, 1000);
+
+    const float64_t atan2_us = bench::measure_us([&]() {
+        atan2_batch<policy>(y.data(), x.data(), r.data(), SIZE);
+        bench::do_not_optimize(r);
+    }, 1000);
+
+    float64_t errSinCos = 0, errAtan2 = 0;
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        errSinCos = std::max(errSinCos, std::abs(s[i] - std::sin(static_cast<float64_t>(angles[i]))));
+        errSinCos = std::max(errSinCos, std::abs(c[i] - std::cos(static_cast<float64_t>(angles[i]))));
+        errAtan2 = std::max(errAtan2, std::abs(r[i] - std::atan2(static_cast<float64_t>(y[i]), static_cast<float64_t>(x[i]))));
+    }
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s sincos (max err %.1e)", name, errSinCos);
+    bench::report(label, sincos_us, SIZE);
+    std::snprintf(label, sizeof(label), "%s atan2  (max err %.1e)", name, errAtan2);
+    bench::report(label, atan2_us, SIZE);
+}
+
+} // namespace
+
+int main() {
+    run<precise_trig, float64_t>("precise double");
+    run<fast_trig, float64_t>("fast    double");
+    run<coarse_trig, float64_t>("coarse  double");
+    run<precise_trig, float32_t>("precise float ");
+    run<fast_trig, float32_t>("fast    float ");
+    run<coarse_trig, float32_t>("coarse  float ");
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <babocar-core/container/unit_array.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+template <typename T>
+void run(const char *name) {
+    typedef typename T::storage_type value_type;
+    static constexpr uint32_t SIZE = 8192;
+
+    std::vector<T> a(SIZE), b(SIZE), r(SIZE);
+    std::vector<value_type> ra(SIZE), rb(SIZE), rr(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        ra[i] = static_cast<value_type>(1.0 + (i % 97) * 0.01);
+        rb[i] = static_cast<value_type>(2.0 - (i % 89) * 0.01);
+        a[i] = T(ra[i]);
+        b[i] = T(rb[i]);
+    }
+
+    const unit_span<const T> sa(a.data(), SIZE), sb(b.data(), SIZE);
+    const unit_span<T> sr(r.data(), SIZE);
+    char label[64];
+
+    std::snprintf(label, sizeof(label), "%s add        raw", name);
+    bench::report(label, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            rr[i] = ra[i] + rb[i];
+        }
+        bench::do_not_optimize(rr);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s add        unit_span", name);
+    bench::report(label, bench::measure_us([&]() {
+        add(sa, sb, sr);
+        bench::do_not_optimize(r);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s scale      raw", name);
+    bench::report(label, bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            rr[i] = ra[i] * static_cast<value_type>(0.5);
+        }
+        bench::do_not_optimize(rr);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s scale      unit_span", name);
+    bench::report(label, bench::measure_us([&]() {
+        scale(sa, static_cast<value_type>(0.5), sr);
+        bench::do_not_optimize(r);
+    }, 2000), SIZE);
+
+    value_type rawDot = 0;
+    std::snprintf(label, sizeof(label), "%s dot        raw", name);
+    bench::report(label, bench::measure_us([&]() {
+        value_type s = 0;
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            s += ra[i] * rb[i];
+        }
+        rawDot = s;
+        bench::do_not_optimize(rawDot);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s dot        unit_span", name);
+    bench::report(label, bench::measure_us([&]() {
+        const auto d = dot(sa, sb);
+        bench::do_not_optimize(d);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s min        raw", name);
+    bench::report(label, bench::measure_us([&]() {
+        value_type m = ra[0];
+        for (uint32_t i = 1; i < SIZE; ++i) {
+            m = ra[i] < m ? ra[i] : m;
+        }
+        bench::do_not_optimize(m);
+    }, 2000), SIZE);
+
+    std::snprintf(label, sizeof(label), "%s min        unit_span", name);
+    bench::report(label, bench::measure_us([&]() {
+        const T m = min(sa);
+        bench::do_not_optimize(m);
+    }, 2000), SIZE);
+}
+
+} // namespace
+
+int main() {
+    run<meter_t>("double");
+    run<meter_f_t>("float ");
+    return 0;
+}
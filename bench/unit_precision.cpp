@@ -0,0 +1,70 @@
+#include <babocar-core/point2.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+template <typename T>
+void run(const char *name) {
+    typedef typename T::storage_type value_type;
+    static constexpr uint32_t SIZE = 16384;
+
+    std::vector<Point2<T>> points(SIZE), transformed(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        points[i] = Point2<T>(T(static_cast<value_type>((i % 128) * 0.05)), T(static_cast<value_type>((i / 128) * 0.05)));
+    }
+
+    Point2<T> centroid;
+    const float64_t centroid_us = bench::measure_us([&]() {
+        Point2<T> sum(T::ZERO(), T::ZERO());
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            sum += points[i];
+        }
+        centroid = sum / SIZE;
+        bench::do_not_optimize(centroid);
+    }, 1000);
+
+    const value_type s = static_cast<value_type>(0.5), c = static_cast<value_type>(0.8660254);
+    const Point2<T> offset(T(static_cast<value_type>(1.5)), T(static_cast<value_type>(-0.5)));
+    const float64_t transform_us = bench::measure_us([&]() {
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            const Point2<T>& p = points[i];
+            transformed[i] = Point2<T>(p.X * c - p.Y * s + offset.X, p.X * s + p.Y * c + offset.Y);
+        }
+        bench::do_not_optimize(transformed);
+    }, 1000);
+
+    value_type minDist2 = 0;
+    const float64_t nearest_us = bench::measure_us([&]() {
+        const Point2<T> q(T(static_cast<value_type>(3.14)), T(static_cast<value_type>(2.71)));
+        value_type result = static_cast<value_type>(1e30);
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            const value_type dx = (points[i].X - q.X).get(), dy = (points[i].Y - q.Y).get();
+            const value_type d2 = dx * dx + dy * dy;
+            result = d2 < result ? d2 : result;
+        }
+        minDist2 = result;
+        bench::do_not_optimize(minDist2);
+    }, 1000);
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s centroid", name);
+    bench::report(label, centroid_us, SIZE);
+    std::snprintf(label, sizeof(label), "%s rotate + translate", name);
+    bench::report(label, transform_us, SIZE);
+    std::snprintf(label, sizeof(label), "%s nearest point", name);
+    bench::report(label, nearest_us, SIZE);
+}
+
+} // namespace
+
+int main() {
+    std::printf("sizeof(Point2m) = %u, sizeof(Point2m_f) = %u\n", static_cast<uint32_t>(sizeof(Point2m)), static_cast<uint32_t>(sizeof(Point2m_f)));
+    run<meter_t>("Point2m  ");
+    run<meter_f_t>("Point2m_f");
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <babocar-core/odometry_replay.hpp>
+#include <babocar-core/path_lookahead.hpp>
+#include <babocar-core/se2.hpp>
+#include <babocar-core/vehicle_sim.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+using namespace bcr;
+
+/* Runs a pure pursuit controller on a closed track as fast as possible, and measures the simulation throughput.
+ * The controller dead-reckons from the measured speed and angular velocity, and corrects with the delayed pose measurements.
+ * Usage: babocar-core-bench-vehicle_sim [scenario file] - the built-in oval track is used if no file is given.
+ */
+
+namespace {
+
+const char *DEFAULT_SCENARIO =
+    "# 30 m x 10 m oval, 2 ms steps, noisy sensors\n"
+    "seed 1\n"
+    "step_ms 2\n"
+    "duration_s 600\n"
+    "wheelbase_m 0.26\n"
+    "max_steering_deg 25\n"
+    "max_steering_rate_deg_per_s 360\n"
+    "speed_time_constant_ms 150\n"
+    "speed_noise_mps 0.05\n"
+    "ang_vel_noise_deg_per_s 2\n"
+    "sensor_latency_ms 4\n"
+    "pose_period_ms 100\n"
+    "pose_latency_ms 60\n"
+    "pose_noise_m 0.03\n"
+    "pose_noise_deg 1\n"
+    "target_speed_mps 3\n"
+    "start 0 -5 0\n"
+    "point 0 -5\n  point 10 -5\n point 12.5 -4.33\n point 14.33 -2.5\n point 15 0\n point 14.33 2.5\n point 12.5 4.33\n"
+    "point 10 5\n  point 0 5\n   point -2.5 4.33\n  point -4.33 2.5\n  point -5 0\n point -4.33 -2.5\n point -2.5 -4.33\n"
+    "point 0 -5\n";
+
+class PurePursuit {
+public:
+    PurePursuit(const VehicleScenario& scenario, float64_t lookahead)
+        : scenario_(scenario)
+        , lookahead_(lookahead)
+        , replay_(millisecond_t(500))
+        , laps_(0) {
+        this->replay_.reset(millisecond_t(0), scenario.start);
+        for (const Point2m& p : scenario.path) {
+            this->path_.push_back(Point2d(p.X.get(), p.Y.get()));
+        }
+    }
+
+    VehicleControl operator()(const VehicleMeasurement& m) {
+        this->replay_.update({ this->scenario_.params.step, m.speed, m.ang_vel });
+        if (m.hasPose) {
+            this->replay_.correct(m.poseTime, m.pose, 0.3);
+        }
+
+        const Pose& pose = this->replay_.odometry().pose;
+        const Point2d *path = this->path_.data();
+        const uint32_t numPoints = static_cast<uint32_t>(this->path_.size());
+        const Point2d pos(pose.pos.X.get(), pose.pos.Y.get());
+        Point2d target;
+        if (!this->lookahead_finder_.find(path, numPoints, pos, this->lookahead_, target)) {
+            // end of the closed track - starts the next lap
+            this->lookahead_finder_.reset();
+            ++this->laps_;
+            if (!this->lookahead_finder_.find(path, numPoints, pos, this->lookahead_, target)) {
+                return { m_per_sec_t(0), radian_t(0) };
+            }
+        }
+
+        // steering angle of the arc through the target point: tan(angle) = 2 * wheelbase * y / lookahead^2 (y in the vehicle frame)
+        const Point2d local = SE2d(pose).inverse().apply(target);
+        const float64_t ld2 = local.X * local.X + local.Y * local.Y;
+        const radian_t steering(std::atan(2 * this->scenario_.params.wheelbase.get() * local.Y / ld2));
+        return { this->scenario_.targetSpeed, steering };
+    }
+
+    uint32_t laps() const { return this->laps_; }
+    const Pose& pose() const { return this->replay_.odometry().pose; }
+
+private:
+    const VehicleScenario& scenario_;
+    const float64_t lookahead_;
+    std::vector<Point2d> path_;
+    OdometryReplay<512, 16> replay_;
+    PathLookahead<float64_t> lookahead_finder_;
+    uint32_t laps_;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    VehicleScenario scenario;
+    uint32_t errorLine = 0;
+    const Status status = argc > 1 ? loadScenario(argv[1], scenario, &errorLine) : parseScenario(DEFAULT_SCENARIO, scenario, &errorLine);
+    if (status != Status::OK) {
+        std::printf("Invalid scenario: %s (line %u)\n", getStatusString(status), errorLine);
+        return 1;
+    }
+
+    VehicleSim sim(scenario.params, scenario.start);
+    uint32_t numSteps = 0, laps = 0;
+    float64_t poseError = 0.0;
+    const float64_t us = bench::measure_us([&]() {
+        sim.reset(scenario.start);
+        PurePursuit controller(scenario, 1.0);
+        numSteps = sim.run(controller, scenario.duration);
+        laps = controller.laps();
+        poseError = controller.pose().pos.distance(sim.odometry().pose.pos).get();
+    }, 5);
+
+    std::printf("%.0f s simulated: %u laps, final estimated position error: %.3f m, %.0fx real time\n",
+        second_t(scenario.duration).get(), laps, poseError, second_t(scenario.duration).get() * 1e6 / us);
+    bench::report("VehicleSim + pure pursuit step", us, numSteps);
+    return 0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <babocar-core/unit_utils.hpp>
+
+namespace bcr {
+namespace detail {
+
+constexpr uint32_t QUARTER_SINE_TABLE_BITS = 8;                                 // Number of index bits of the quarter sine table.
+constexpr uint32_t QUARTER_SINE_TABLE_SIZE = 1u << QUARTER_SINE_TABLE_BITS;     // Number of segments of the quarter sine table.
+
+extern const float32_t QUARTER_SINE_TABLE[QUARTER_SINE_TABLE_SIZE + 1];         // Sine values in the range [0, PI/2].
+
+} // namespace detail
+
+/* @brief Binary angle - stores angle as an unsigned integer, where the full range of the integer covers 360 degrees.
+ * Overflow of the integer is the wrap-around of the angle, therefore the angle is always normalized,
+ * and additions, subtractions and comparisons are single integer operations.
+ * @tparam T Unsigned integer type of the stored value (uint16_t or uint32_t).
+ **/
+template <typename T>
+class binary_angle {
+public:
+    static_assert(std::is_unsigned<T>::value && sizeof(T) >= 2 && sizeof(T) <= 4, "Binary angle must be stored as uint16_t or uint32_t!");
+
+    typedef T value_type;                                       // Stored value type.
+    typedef typename std::make_signed<T>::type signed_type;     // Signed value type - for angles in the range [-180, 180) degrees.
+
+    static constexpr uint32_t NUM_BITS = sizeof(T) * 8;         // Number of bits of the stored value.
+
+    /* @brief Default constructor - sets angle to 0.
+     **/
+    constexpr binary_angle() : value_(0) {}
+
+    /* @brief Constructor - sets stored value.
+     * @param value The stored value (2^NUM_BITS is 360 degrees).
+     **/
+    constexpr explicit binary_angle(T value, void*) : value_(value) {}
+
+    /* @brief Constructor - converts angle to binary angle, rounding to the nearest representable value.
+     * @param angle The angle. Any value is accepted, it is wrapped to [0, 360) degrees.
+     **/
+    explicit binary_angle(radian_t angle) {
+        const float64_t value = angle.get() * (FULL_CIRCLE / (2 * PI.get()));
+        this->value_ = static_cast<T>(static_cast<int64_t>(value + (value >= 0.0 ? 0.5 : -0.5)));
+    }
+
+    static constexpr binary_angle ZERO() { return binary_angle(); }
+    static constexpr binary_angle DEG_45() { return binary_angle(static_cast<T>(1u << (NUM_BITS - 3)), nullptr); }
+    static constexpr binary_angle DEG_90() { return binary_angle(static_cast<T>(1u << (NUM_BITS - 2)), nullptr); }
+    static constexpr binary_angle DEG_180() { return binary_angle(static_cast<T>(1u << (NUM_BITS - 1)), nullptr); }
+
+    /* @brief Gets stored value.
+     * @returns The stored value in the range [0, 2^NUM_BITS).
+     **/
+    constexpr T get() const { return this->value_; }
+
+    /* @brief Gets stored value as a signed integer.
+     * @returns The stored value in the range [-2^(NUM_BITS-1), 2^(NUM_BITS-1)).
+     **/
+    constexpr signed_type getSigned() const { return static_cast<signed_type>(this->value_); }
+
+    /* @brief Converts binary angle to radian.
+     * @returns The angle in the range [-PI, PI).
+     **/
+    radian_t toRadian() const {
+        return radian_t(this->getSigned() * (2 * PI.get() / FULL_CIRCLE));
+    }
+
+    /* @brief Converts binary angle to radian.
+     * @returns The angle in the range [0, 2*PI).
+     **/
+    radian_t toRadian360() const {
+        return radian_t(this->value_ * (2 * PI.get() / FULL_CIRCLE));
+    }
+
+    /* @brief Calculates sine of the angle using linear interpolation in a quarter sine table.
+     * @returns The sine of the angle. Maximum absolute error is 5e-6.
+     **/
+    float32_t sin() const;
+
+    /* @brief Calculates cosine of the angle using linear interpolation in a quarter sine table.
+     * @returns The cosine of the angle. Maximum absolute error is 5e-6.
+     **/
+    float32_t cos() const {
+        return (*this + DEG_90()).sin();
+    }
+
+    /* @brief Rounds angle to the nearest multiple of 45 degrees.
+     * @returns The rounded angle.
+     **/
+    binary_angle round45() const {
+        return this->roundTo(NUM_BITS - 3);
+    }
+
+    /* @brief Rounds angle to the nearest multiple of 90 degrees.
+     * @returns The rounded angle.
+     **/
+    binary_angle round90() const {
+        return this->roundTo(NUM_BITS - 2);
+    }
+
+    binary_angle operator-() const { return binary_angle(static_cast<T>(-this->value_), nullptr); }
+
+    binary_angle& operator+=(const binary_angle& other) {
+        this->value_ = static_cast<T>(this->value_ + other.value_);
+        return *this;
+    }
+
+    binary_angle& operator-=(const binary_angle& other) {
+        this->value_ = static_cast<T>(this->value_ - other.value_);
+        return *this;
+    }
+
+    binary_angle operator+(const binary_angle& other) const { return binary_angle(static_cast<T>(this->value_ + other.value_), nullptr); }
+    binary_angle operator-(const binary_angle& other) const { return binary_angle(static_cast<T>(this->value_ - other.value_), nullptr); }
+
+    /* @brief Multiplies angle by an integer, wraps around.
+     * The multiplication is performed in an unsigned type of at least 32 bits - 16-bit operands would be promoted to int, and could overflow.
+     **/
+    binary_angle operator*(int32_t c) const {
+        typedef typename std::conditional<(sizeof(T) < sizeof(uint32_t)), uint32_t, T>::type U;
+        return binary_angle(static_cast<T>(static_cast<U>(this->value_) * static_cast<U>(c)), nullptr);
+    }
+
+    bool operator==(const binary_angle& other) const { return this->value_ == other.value_; }
+    bool operator!=(const binary_angle& other) const { return this->value_ != other.value_; }
+
+private:
+    static constexpr float64_t FULL_CIRCLE = static_cast<float64_t>(1ull << NUM_BITS);  // Value of 360 degrees.
+
+    binary_angle roundTo(uint32_t bits) const {
+        const T mask = static_cast<T>(~((static_cast<T>(1) << bits) - 1));
+        return binary_angle(static_cast<T>((this->value_ + (static_cast<T>(1) << (bits - 1))) & mask), nullptr);
+    }
+
+    T value_;   // The stored value.
+};
+
+template <typename T> constexpr uint32_t binary_angle<T>::NUM_BITS;
+template <typename T> constexpr float64_t binary_angle<T>::FULL_CIRCLE;
+
+template <typename T>
+float32_t binary_angle<T>::sin() const {
+    static constexpr uint32_t PHASE_BITS = NUM_BITS - 2;                                     // bits of the phase inside a quadrant
+    static constexpr uint32_t FRAC_BITS = PHASE_BITS - detail::QUARTER_SINE_TABLE_BITS;     // interpolation bits
+    static constexpr uint32_t QUADRANT = 1u << PHASE_BITS;
+
+    const uint32_t quadrant = this->value_ >> PHASE_BITS;
+    uint32_t phase = this->value_ & (QUADRANT - 1);
+    phase = (quadrant & 1) ? QUADRANT - phase : phase;      // second and fourth quadrants are mirrored
+
+    const uint32_t idx = phase >> FRAC_BITS;
+    const float32_t frac = static_cast<float32_t>(phase & ((1u << FRAC_BITS) - 1)) * (1.0f / (1u << FRAC_BITS));
+    const float32_t s0 = detail::QUARTER_SINE_TABLE[idx];
+    const float32_t s1 = detail::QUARTER_SINE_TABLE[idx + (idx < detail::QUARTER_SINE_TABLE_SIZE ? 1 : 0)];
+    const float32_t s = s0 + (s1 - s0) * frac;
+
+    return (quadrant & 2) ? -s : s;   // third and fourth quadrants are negative
+}
+
+/* @brief Checks if binary angle equals the reference with the given epsilon tolerance.
+ * @param value The value to compare to the reference.
+ * @param ref The reference.
+ * @param eps The epsilon tolerance.
+ * @returns Boolean value indicating if the difference of the angles is not greater than the tolerance (in any direction).
+ **/
+template <typename T>
+inline bool eq(const binary_angle<T>& value, const binary_angle<T>& ref, const binary_angle<T>& eps) {
+    // the magnitude is calculated in unsigned arithmetic - the signed negation of a 180 degree difference would overflow
+    const T diff = (value - ref).get();
+    return bcr::min(diff, static_cast<T>(-diff)) <= eps.get();
+}
+
+typedef binary_angle<uint16_t> bangle16_t;  // 16-bit binary angle - resolution: 0.0055 degrees.
+typedef binary_angle<uint32_t> bangle32_t;  // 32-bit binary angle - resolution: 8.4e-8 degrees.
+
+} // namespace bcr
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <babocar-core/point2.hpp>
+#include <babocar-core/container/vec.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Associates cluster centers (e.g. the output of KMeans or KMeans2) across frames by centroid proximity,
+ * and keeps persistent identifiers and velocity estimates for the tracked clusters.
+ * Candidate matches are looked up in a uniform grid hash of the predicted track positions (cell size equals the gate distance),
+ * then assigned greedily in increasing distance order. All storage is fixed-size, no dynamic allocation is performed.
+ * @tparam capacity_ Maximum number of tracks (and maximum number of clusters processed per frame).
+ **/
+template <uint32_t capacity_>
+class ClusterTracker {
+public:
+    static constexpr uint32_t INVALID_ID = 0;   // Identifier of clusters that could not be assigned to any track.
+
+    struct Track {
+        uint32_t id;        // Persistent track identifier.
+        Point2m pos;        // Estimated position.
+        Vec2mps vel;        // Estimated velocity.
+        uint32_t age;       // Number of frames the track has been associated with a cluster.
+        uint32_t missed;    // Number of consecutive frames without associated cluster.
+    };
+
+    /* @brief Constructor - sets association parameters.
+     * @param gate Maximum distance between a predicted track position and a cluster center to associate them.
+     * @param maxMissed Number of consecutive frames a track is kept alive without associated cluster.
+     * @param velGain Gain of the velocity low-pass filter (1 means the last measured velocity is used).
+     **/
+    explicit ClusterTracker(meter_t gate, uint32_t maxMissed = 3, float32_t velGain = 0.5f)
+        : gate_(gate.get())
+        , invGate_(1.0 / gate.get())
+        , maxMissed_(maxMissed)
+        , velGain_(velGain)
+        , nextId_(INVALID_ID + 1) {}
+
+    /* @brief Associates the cluster centers of the current frame to the tracks.
+     * @param centers The cluster centers.
+     * @param numCenters Number of cluster centers. Centers above the capacity are ignored.
+     * @param d_time Time elapsed since the previous update.
+     * @param ids Optional output array of the track identifiers assigned to the centers (INVALID_ID if not tracked).
+     * @returns Number of centers associated with already existing tracks.
+     **/
+    uint32_t update(const Point2m *centers, uint32_t numCenters, second_t d_time, uint32_t *ids = nullptr);
+
+    /* @brief Gets the tracks.
+     * @returns The tracks.
+     **/
+    const vec<Track, capacity_>& tracks() const { return this->tracks_; }
+
+    /* @brief Removes all tracks.
+     **/
+    void clear() { this->tracks_.clear(); }
+
+private:
+    static constexpr uint32_t MAX_CANDIDATES = 4;   // Maximum number of candidate tracks kept for each cluster.
+    static constexpr uint32_t NUM_BUCKETS = next_pow2(2 * capacity_);   // Number of hash buckets.
+    static constexpr uint32_t INVALID_IDX = 0xffffffffu;
+
+    struct Candidate {
+        float64_t dist2;
+        uint32_t track;
+        uint32_t cluster;
+
+        bool operator<(const Candidate& other) const { return this->dist2 < other.dist2; }
+    };
+
+    static uint32_t hash(int32_t cx, int32_t cy) {
+        return (static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u) & (NUM_BUCKETS - 1);
+    }
+
+    int32_t cell(float64_t coord) const {
+        return static_cast<int32_t>(std::floor(coord * this->invGate_));
+    }
+
+    const float64_t gate_, invGate_;
+    const uint32_t maxMissed_;
+    const float32_t velGain_;
+    uint32_t nextId_;
+    vec<Track, capacity_> tracks_;
+
+    // per-update working buffers, kept as members to keep stack usage low
+    float64_t predX_[capacity_], predY_[capacity_];
+    int32_t cellX_[capacity_], cellY_[capacity_];
+    uint32_t bucketHead_[NUM_BUCKETS];
+    uint32_t bucketNext_[capacity_];
+    uint32_t trackCluster_[capacity_];
+    uint32_t clusterTrack_[capacity_];
+    Candidate candidates_[capacity_ * MAX_CANDIDATES];
+};
+
+template <uint32_t capacity_> constexpr uint32_t ClusterTracker<capacity_>::INVALID_ID;
+template <uint32_t capacity_> constexpr uint32_t ClusterTracker<capacity_>::MAX_CANDIDATES;
+template <uint32_t capacity_> constexpr uint32_t ClusterTracker<capacity_>::NUM_BUCKETS;
+template <uint32_t capacity_> constexpr uint32_t ClusterTracker<capacity_>::INVALID_IDX;
+
+template <uint32_t capacity_>
+uint32_t ClusterTracker<capacity_>::update(const Point2m *centers, uint32_t numCenters, second_t d_time, uint32_t *ids) {
+    const uint32_t numClusters = bcr::min(numCenters, capacity_);
+    const uint32_t numTracks = this->tracks_.size();
+    const float64_t dt = d_time.get();
+    const float64_t gate2 = this->gate_ * this->gate_;
+
+    // predicts track positions and inserts them into the grid hash
+    for (uint32_t h = 0; h < NUM_BUCKETS; ++h) {
+        this->bucketHead_[h] = INVALID_IDX;
+    }
+    for (uint32_t i = 0; i < numTracks; ++i) {
+        const Track& t = this->tracks_[i];
+        this->predX_[i] = t.pos.X.get() + t.vel.X.get() * dt;
+        this->predY_[i] = t.pos.Y.get() + t.vel.Y.get() * dt;
+        this->cellX_[i] = this->cell(this->predX_[i]);
+        this->cellY_[i] = this->cell(this->predY_[i]);
+
+        const uint32_t h = hash(this->cellX_[i], this->cellY_[i]);
+        this->bucketNext_[i] = this->bucketHead_[h];
+        this->bucketHead_[h] = i;
+        this->trackCluster_[i] = INVALID_IDX;
+    }
+
+    // collects the nearest tracks inside the gate for every cluster from the neighbouring cells
+    uint32_t numCandidates = 0;
+    for (uint32_t j = 0; j < numClusters; ++j) {
+        const float64_t x = centers[j].X.get(), y = centers[j].Y.get();
+        const int32_t cx = this->cell(x), cy = this->cell(y);
+        Candidate *const first = &this->candidates_[numCandidates];
+        uint32_t num = 0;
+
+        this->clusterTrack_[j] = INVALID_IDX;
+
+        for (int32_t ny = cy - 1; ny <= cy + 1; ++ny) {
+            for (int32_t nx = cx - 1; nx <= cx + 1; ++nx) {
+                for (uint32_t i = this->bucketHead_[hash(nx, ny)]; i != INVALID_IDX; i = this->bucketNext_[i]) {
+                    if (this->cellX_[i] != nx || this->cellY_[i] != ny) {
+                        continue; // hash collision
+                    }
+
+                    const float64_t dx = this->predX_[i] - x, dy = this->predY_[i] - y;
+                    const Candidate c = { dx * dx + dy * dy, i, j };
+                    if (c.dist2 < gate2 && (num < MAX_CANDIDATES || c < first[num - 1])) {
+                        // keeps the candidate list sorted by insertion
+                        uint32_t k = num < MAX_CANDIDATES ? num++ : num - 1;
+                        for (; k > 0 && c < first[k - 1]; --k) {
+                            first[k] = first[k - 1];
+                        }
+                        first[k] = c;
+                    }
+                }
+            }
+        }
+        numCandidates += num;
+    }
+
+    // greedy assignment in increasing distance order
+    std::sort(this->candidates_, this->candidates_ + numCandidates);
+    uint32_t numAssigned = 0;
+    for (uint32_t k = 0; k < numCandidates && numAssigned < numClusters; ++k) {
+        const Candidate& c = this->candidates_[k];
+        if (this->trackCluster_[c.track] == INVALID_IDX && this->clusterTrack_[c.cluster] == INVALID_IDX) {
+            this->trackCluster_[c.track] = c.cluster;
+            this->clusterTrack_[c.cluster] = c.track;
+            ++numAssigned;
+        }
+    }
+
+    // updates assigned tracks, coasts and removes the unassigned ones
+    uint32_t numKept = 0;
+    for (uint32_t i = 0; i < numTracks; ++i) {
+        Track t = this->tracks_[i];
+        const uint32_t j = this->trackCluster_[i];
+
+        if (j != INVALID_IDX) {
+            if (dt > 0.0) {
+                const Vec2mps measVel = (centers[j] - t.pos) / d_time;
+                t.vel = t.age > 0 ? t.vel + (measVel - t.vel) * this->velGain_ : measVel;
+            }
+            t.pos = centers[j];
+            t.missed = 0;
+            ++t.age;
+        } else {
+            t.pos = { meter_t(this->predX_[i]), meter_t(this->predY_[i]) };
+            ++t.missed;
+        }
+
+        if (t.missed <= this->maxMissed_) {
+            if (j != INVALID_IDX && ids) {
+                ids[j] = t.id;
+            }
+            this->tracks_[numKept++] = t;
+        }
+    }
+    while (this->tracks_.size() > numKept) {
+        this->tracks_.remove(this->tracks_.end() - 1);
+    }
+
+    // starts new tracks for the unassigned clusters
+    for (uint32_t j = 0; j < numCenters; ++j) {
+        if (j < numClusters && this->clusterTrack_[j] != INVALID_IDX) {
+            continue;   // identifier has already been set
+        }
+
+        uint32_t id = INVALID_ID;
+        if (j < numClusters && this->tracks_.size() < capacity_) {
+            const Track t = { this->nextId_++, centers[j], { m_per_sec_t(0), m_per_sec_t(0) }, 0, 0 };
+            this->tracks_.append(t);
+            id = t.id;
+        }
+
+        if (ids) {
+            ids[j] = id;
+        }
+    }
+
+    return numAssigned;
+}
+
+} // namespace bcr
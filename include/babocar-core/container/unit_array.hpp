@@ -0,0 +1,485 @@
+#pragma once
+
+#include <babocar-core/units.hpp>
+
+namespace bcr {
+
+/* Unit-typed array views and fixed-size arrays.
+ *
+ * unit_span<T>     - non-owning view of contiguous unit values, T may be const-qualified for read-only views.
+ * unit_array<T, N> - fixed-size array of unit values.
+ *
+ * The elementwise operations work on the underlying storage values, the unit conversion factors are compile-time constants
+ * (and are optimized out when the units match), so the loops are the same as the ones written for raw arrays
+ * and can be vectorized by the compiler.
+ * Result dimensions of multiplications and divisions are checked through mul_dim and div_dim.
+ * Storage type conversions follow the mixed precision rules of units.hpp - the result must be able to store the operands without loss of precision.
+ */
+
+namespace detail {
+
+template <typename T>
+using unit_storage_of = typename std::conditional<std::is_const<T>::value, const typename T::storage_type, typename T::storage_type>::type;
+
+template <typename T>
+using non_const_unit = typename std::remove_const<T>::type;
+
+/* @brief Gets conversion factor between two units of the same dimension.
+ * @tparam from_t The source unit type.
+ * @tparam to_t The result unit type.
+ * @tparam V Type of the factor.
+ * @returns The conversion factor.
+ **/
+template <typename from_t, typename to_t, typename V>
+inline constexpr V unit_factor() {
+    return static_cast<V>(from_t::unit_inst_t::mul / to_t::unit_inst_t::mul);
+}
+
+} // namespace detail
+
+/* @brief Non-owning view of contiguous unit values.
+ * @tparam T The unit type (e.g. meter_t or const meter_t).
+ **/
+template <typename T>
+class unit_span {
+public:
+    static_assert(is_unit<detail::non_const_unit<T>>::value, "Element type must be a unit class!");
+
+    typedef T value_type;                                       // Element type.
+    typedef detail::unit_storage_of<T> storage_type;            // Underlying storage type of the elements.
+    static_assert(sizeof(T) == sizeof(storage_type), "Unit values must be stored as a single storage value!");
+
+    /* @brief Constructor - sets data and size.
+     * @param data Pointer to the first element.
+     * @param size Number of elements.
+     **/
+    unit_span(T *data, uint32_t size)
+        : data_(data)
+        , size_(size) {}
+
+    /* @brief Constructor - creates view of an array.
+     * @param data The array.
+     **/
+    template <uint32_t N>
+    unit_span(T (&data)[N])
+        : data_(data)
+        , size_(N) {}
+
+    /* @brief Constructor - creates read-only view from a mutable view.
+     * @param other The mutable view.
+     **/
+    template <typename T2, class = typename std::enable_if<std::is_same<const T2, T>::value>::type>
+    unit_span(const unit_span<T2>& other)
+        : data_(other.data())
+        , size_(other.size()) {}
+
+    T& operator[](uint32_t pos) const { return this->data_[pos]; }
+
+    /* @brief Gets number of elements.
+     * @returns The number of elements.
+     **/
+    uint32_t size() const { return this->size_; }
+
+    /* @brief Gets pointer to the first element.
+     * @returns Pointer to the first element.
+     **/
+    T* data() const { return this->data_; }
+
+    /* @brief Gets pointer to the underlying storage values.
+     * @returns Pointer to the storage value of the first element.
+     **/
+    storage_type* raw() const { return reinterpret_cast<storage_type*>(this->data_); }
+
+    T* begin() const { return this->data_; }
+    T* end() const { return this->data_ + this->size_; }
+
+    /* @brief Creates view of a range of the elements.
+     * @param offset Index of the first element of the range.
+     * @param count Number of elements in the range.
+     * @returns The view of the range.
+     **/
+    unit_span subspan(uint32_t offset, uint32_t count) const {
+        return unit_span(this->data_ + offset, count);
+    }
+
+private:
+    T *data_;           // Pointer to the first element.
+    uint32_t size_;     // Number of elements.
+};
+
+/* @brief Fixed-size array of unit values.
+ * @tparam T The unit type (e.g. meter_t).
+ * @tparam N Number of elements.
+ **/
+template <typename T, uint32_t N>
+class unit_array {
+public:
+    static_assert(is_unit<T>::value, "Element type must be a unit class!");
+
+    typedef T value_type;                               // Element type.
+    typedef typename T::storage_type storage_type;      // Underlying storage type of the elements.
+
+    /* @brief Default constructor - sets all elements to 0.
+     **/
+    unit_array() {}
+
+    /* @brief Constructor - sets all elements to the given value.
+     * @param value The value.
+     **/
+    explicit unit_array(const T& value) {
+        for (uint32_t i = 0; i < N; ++i) {
+            this->data_[i] = value;
+        }
+    }
+
+    T& operator[](uint32_t pos) { return this->data_[pos]; }
+    const T& operator[](uint32_t pos) const { return this->data_[pos]; }
+
+    /* @brief Gets number of elements.
+     * @returns The number of elements.
+     **/
+    static constexpr uint32_t size() { return N; }
+
+    T* data() { return this->data_; }
+    const T* data() const { return this->data_; }
+
+    storage_type* raw() { return this->span().raw(); }
+    const storage_type* raw() const { return this->span().raw(); }
+
+    T* begin() { return this->data_; }
+    const T* begin() const { return this->data_; }
+    T* end() { return this->data_ + N; }
+    const T* end() const { return this->data_ + N; }
+
+    /* @brief Creates view of the elements.
+     * @returns The view of the elements.
+     **/
+    unit_span<T> span() { return unit_span<T>(this->data_, N); }
+
+    /* @brief Creates read-only view of the elements.
+     * @returns The read-only view of the elements.
+     **/
+    unit_span<const T> span() const { return unit_span<const T>(this->data_, N); }
+
+private:
+    T data_[N];     // The elements.
+};
+
+/* @brief Adds elements of two views.
+ * @restrict Dimensions of the operands and the result must be the same.
+ * @restrict Size of the result must not be smaller than the size of the first operand.
+ * @param a The first operand.
+ * @param b The second operand - must not be smaller than the first operand.
+ * @param result The result view, may be the same as any of the operands.
+ **/
+template <typename A, typename B, typename R>
+void add(const unit_span<A>& a, const unit_span<B>& b, const unit_span<R>& result) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef detail::non_const_unit<B> b_t;
+    typedef typename R::storage_type value_type;
+    static_assert(a_t::dim == R::dim && b_t::dim == R::dim, "Dimensions do not match!");
+    static_assert(detail::is_lossless_storage_conversion<typename a_t::storage_type, value_type>::value &&
+                  detail::is_lossless_storage_conversion<typename b_t::storage_type, value_type>::value, "Result would lose precision!");
+
+    constexpr value_type ka = detail::unit_factor<a_t, R, value_type>(), kb = detail::unit_factor<b_t, R, value_type>();
+    const typename a_t::storage_type *pa = a.raw();
+    const typename b_t::storage_type *pb = b.raw();
+    value_type *pr = result.raw();
+    const uint32_t size = a.size();
+
+    for (uint32_t i = 0; i < size; ++i) {
+        pr[i] = pa[i] * ka + pb[i] * kb;
+    }
+}
+
+/* @brief Subtracts elements of the second view from the elements of the first one.
+ * @restrict Dimensions of the operands and the result must be the same.
+ * @restrict Size of the result must not be smaller than the size of the first operand.
+ * @param a The first operand.
+ * @param b The second operand - must not be smaller than the first operand.
+ * @param result The result view, may be the same as any of the operands.
+ **/
+template <typename A, typename B, typename R>
+void subtract(const unit_span<A>& a, const unit_span<B>& b, const unit_span<R>& result) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef detail::non_const_unit<B> b_t;
+    typedef typename R::storage_type value_type;
+    static_assert(a_t::dim == R::dim && b_t::dim == R::dim, "Dimensions do not match!");
+    static_assert(detail::is_lossless_storage_conversion<typename a_t::storage_type, value_type>::value &&
+                  detail::is_lossless_storage_conversion<typename b_t::storage_type, value_type>::value, "Result would lose precision!");
+
+    constexpr value_type ka = detail::unit_factor<a_t, R, value_type>(), kb = detail::unit_factor<b_t, R, value_type>();
+    const typename a_t::storage_type *pa = a.raw();
+    const typename b_t::storage_type *pb = b.raw();
+    value_type *pr = result.raw();
+    const uint32_t size = a.size();
+
+    for (uint32_t i = 0; i < size; ++i) {
+        pr[i] = pa[i] * ka - pb[i] * kb;
+    }
+}
+
+/* @brief Multiplies elements of two views.
+ * @restrict Dimension of the result must be the product of the dimensions of the operands.
+ * @restrict Size of the result must not be smaller than the size of the first operand.
+ * @param a The first operand.
+ * @param b The second operand - must not be smaller than the first operand.
+ * @param result The result view.
+ **/
+template <typename A, typename B, typename R>
+void multiply(const unit_span<A>& a, const unit_span<B>& b, const unit_span<R>& result) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef detail::non_const_unit<B> b_t;
+    typedef typename std::common_type<typename a_t::storage_type, typename b_t::storage_type>::type calc_type;
+    typedef typename R::storage_type value_type;
+    static_assert(detail::mul_dim<a_t::dim, b_t::dim>::value == R::dim, "Dimensions do not match!");
+    static_assert(detail::is_lossless_storage_conversion<calc_type, value_type>::value, "Result would lose precision!");
+
+    constexpr calc_type k = static_cast<calc_type>(a_t::unit_inst_t::mul * b_t::unit_inst_t::mul / R::unit_inst_t::mul);
+    const typename a_t::storage_type *pa = a.raw();
+    const typename b_t::storage_type *pb = b.raw();
+    value_type *pr = result.raw();
+    const uint32_t size = a.size();
+
+    for (uint32_t i = 0; i < size; ++i) {
+        pr[i] = pa[i] * pb[i] * k;
+    }
+}
+
+/* @brief Divides elements of the first view by the elements of the second one.
+ * @restrict Dimension of the result must be the quotient of the dimensions of the operands.
+ * @restrict Size of the result must not be smaller than the size of the first operand.
+ * @param a The first operand.
+ * @param b The second operand - must not be smaller than the first operand.
+ * @param result The result view.
+ **/
+template <typename A, typename B, typename R>
+void divide(const unit_span<A>& a, const unit_span<B>& b, const unit_span<R>& result) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef detail::non_const_unit<B> b_t;
+    typedef typename std::common_type<typename a_t::storage_type, typename b_t::storage_type>::type calc_type;
+    typedef typename R::storage_type value_type;
+    static_assert(detail::div_dim<a_t::dim, b_t::dim>::value == R::dim, "Dimensions do not match!");
+    static_assert(detail::is_lossless_storage_conversion<calc_type, value_type>::value, "Result would lose precision!");
+
+    constexpr calc_type k = static_cast<calc_type>(a_t::unit_inst_t::mul / b_t::unit_inst_t::mul / R::unit_inst_t::mul);
+    const typename a_t::storage_type *pa = a.raw();
+    const typename b_t::storage_type *pb = b.raw();
+    value_type *pr = result.raw();
+    const uint32_t size = a.size();
+
+    for (uint32_t i = 0; i < size; ++i) {
+        pr[i] = pa[i] / pb[i] * k;
+    }
+}
+
+/* @brief Multiplies elements of a view with a constant.
+ * @restrict Dimensions of the operand and the result must be the same.
+ * @restrict Size of the result must not be smaller than the size of the operand.
+ * @param a The operand.
+ * @param c The constant.
+ * @param result The result view, may be the same as the operand.
+ **/
+template <typename A, typename R>
+void scale(const unit_span<A>& a, typename R::storage_type c, const unit_span<R>& result) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef typename R::storage_type value_type;
+    static_assert(a_t::dim == R::dim, "Dimensions do not match!");
+    static_assert(detail::is_lossless_storage_conversion<typename a_t::storage_type, value_type>::value, "Result would lose precision!");
+
+    const value_type k = c * detail::unit_factor<a_t, R, value_type>();
+    const typename a_t::storage_type *pa = a.raw();
+    value_type *pr = result.raw();
+    const uint32_t size = a.size();
+
+    for (uint32_t i = 0; i < size; ++i) {
+        pr[i] = pa[i] * k;
+    }
+}
+
+/* @brief Calculates sum of the elements.
+ * @param a The view.
+ * @returns The sum of the elements.
+ **/
+template <typename A>
+detail::non_const_unit<A> sum(const unit_span<A>& a) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef typename a_t::storage_type value_type;
+
+    // independent partial sums break the dependency chain of the additions
+    value_type s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    const value_type *pa = a.raw();
+    const uint32_t size = a.size();
+    uint32_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        s0 += pa[i];
+        s1 += pa[i + 1];
+        s2 += pa[i + 2];
+        s3 += pa[i + 3];
+    }
+    for (; i < size; ++i) {
+        s0 += pa[i];
+    }
+    return a_t((s0 + s1) + (s2 + s3), nullptr);
+}
+
+/* @brief Gets minimum of the elements.
+ * @restrict The view must not be empty.
+ * @param a The view.
+ * @returns The minimum of the elements.
+ **/
+template <typename A>
+detail::non_const_unit<A> min(const unit_span<A>& a) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef typename a_t::storage_type value_type;
+
+    const value_type *pa = a.raw();
+    const uint32_t size = a.size();
+    value_type result = pa[0];
+    for (uint32_t i = 1; i < size; ++i) {
+        result = pa[i] < result ? pa[i] : result;
+    }
+    return a_t(result, nullptr);
+}
+
+/* @brief Gets maximum of the elements.
+ * @restrict The view must not be empty.
+ * @param a The view.
+ * @returns The maximum of the elements.
+ **/
+template <typename A>
+detail::non_const_unit<A> max(const unit_span<A>& a) {
+    typedef detail::non_const_unit<A> a_t;
+    typedef typename a_t::storage_type value_type;
+
+    const value_type *pa = a.raw();
+    const uint32_t size = a.size();
+    value_type result = pa[0];
+    for (uint32_t i = 1; i < size; ++i) {
+        result = pa[i] > result ? pa[i] : result;
+    }
+    return a_t(result, nullptr);
+}
+
+/* @brief Calculates dot product of two views.
+ * @param a The first operand.
+ * @param b The second operand - must not be smaller than the first operand.
+ * @returns The dot product - its dimension is the product of the dimensions of the operands.
+ **/
+template <typename A, typename B, typename R = decltype(std::declval<detail::non_const_unit<A>>() * std::declval<detail::non_const_unit<B>>())>
+R dot(const unit_span<A>& a, const unit_span<B>& b) {
+    typedef typename R::storage_type value_type;
+
+    value_type s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    const typename unit_span<A>::storage_type *pa = a.raw();
+    const typename unit_span<B>::storage_type *pb = b.raw();
+    const uint32_t size = a.size();
+    uint32_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        s0 += pa[i] * pb[i];
+        s1 += pa[i + 1] * pb[i + 1];
+        s2 += pa[i + 2] * pb[i + 2];
+        s3 += pa[i + 3] * pb[i + 3];
+    }
+    for (; i < size; ++i) {
+        s0 += pa[i] * pb[i];
+    }
+    return R((s0 + s1) + (s2 + s3), nullptr);
+}
+
+/* @brief Adds elements of two arrays.
+ * @returns The result array, in the unit of the first array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+unit_array<T1, N> operator+(const unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    unit_array<T1, N> result;
+    add(a.span(), b.span(), result.span());
+    return result;
+}
+
+/* @brief Subtracts elements of two arrays.
+ * @returns The result array, in the unit of the first array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+unit_array<T1, N> operator-(const unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    unit_array<T1, N> result;
+    subtract(a.span(), b.span(), result.span());
+    return result;
+}
+
+/* @brief Multiplies elements of two arrays.
+ * @returns The result array, its element type is the type of the product of the elements.
+ **/
+template <typename T1, typename T2, uint32_t N, typename R = decltype(std::declval<T1>() * std::declval<T2>())>
+unit_array<R, N> operator*(const unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    unit_array<R, N> result;
+    multiply(a.span(), b.span(), result.span());
+    return result;
+}
+
+/* @brief Divides elements of two arrays.
+ * @returns The result array, its element type is the type of the quotient of the elements.
+ **/
+template <typename T1, typename T2, uint32_t N, typename R = decltype(std::declval<T1>() / std::declval<T2>())>
+typename std::enable_if<is_unit<R>::value, unit_array<R, N>>::type operator/(const unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    unit_array<R, N> result;
+    divide(a.span(), b.span(), result.span());
+    return result;
+}
+
+/* @brief Multiplies elements of an array with a constant.
+ * @returns The result array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+typename std::enable_if<std::is_arithmetic<T2>::value, unit_array<T1, N>>::type operator*(const unit_array<T1, N>& a, const T2& c) {
+    unit_array<T1, N> result;
+    scale(a.span(), static_cast<typename T1::storage_type>(c), result.span());
+    return result;
+}
+
+/* @brief Multiplies elements of an array with a constant.
+ * @returns The result array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+typename std::enable_if<std::is_arithmetic<T2>::value, unit_array<T1, N>>::type operator*(const T2& c, const unit_array<T1, N>& a) {
+    return a * c;
+}
+
+/* @brief Divides elements of an array by a constant.
+ * @returns The result array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+typename std::enable_if<std::is_arithmetic<T2>::value, unit_array<T1, N>>::type operator/(const unit_array<T1, N>& a, const T2& c) {
+    unit_array<T1, N> result;
+    scale(a.span(), static_cast<typename T1::storage_type>(1) / static_cast<typename T1::storage_type>(c), result.span());
+    return result;
+}
+
+/* @brief Adds elements of another array to the elements of this array.
+ * @returns This array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+unit_array<T1, N>& operator+=(unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    add(a.span(), b.span(), a.span());
+    return a;
+}
+
+/* @brief Subtracts elements of another array from the elements of this array.
+ * @returns This array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+unit_array<T1, N>& operator-=(unit_array<T1, N>& a, const unit_array<T2, N>& b) {
+    subtract(a.span(), b.span(), a.span());
+    return a;
+}
+
+/* @brief Multiplies elements of this array with a constant.
+ * @returns This array.
+ **/
+template <typename T1, typename T2, uint32_t N>
+typename std::enable_if<std::is_arithmetic<T2>::value, unit_array<T1, N>&>::type operator*=(unit_array<T1, N>& a, const T2& c) {
+    scale(a.span(), static_cast<typename T1::storage_type>(c), a.span());
+    return a;
+}
+
+} // namespace bcr
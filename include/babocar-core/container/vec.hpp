@@ -153,7 +153,7 @@ public:
     }
 
     const_iterator begin() const {
-        return reinterpret_cast<T*>(this->data_);
+        return reinterpret_cast<const T*>(this->data_);
     }
 
     iterator end() {
@@ -161,7 +161,7 @@ public:
     }
 
     const_iterator end() const {
-        return reinterpret_cast<T*>(&this->data_[this->size_]);
+        return reinterpret_cast<const T*>(&this->data_[this->size_]);
     }
 
     uint32_t size() const { return this->size_; }
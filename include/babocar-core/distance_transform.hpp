@@ -0,0 +1,298 @@
+#pragma once
+
+#include <babocar-core/occupancy_grid.hpp>
+#include <babocar-core/parallel.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace bcr {
+
+/* @brief Exact Euclidean distance transform - the distance from every cell to the nearest occupied cell of a square grid.
+ * The transform is separable (Felzenszwalb-Huttenlocher): the first pass calculates the squared distances along the rows,
+ * the second pass calculates the lower envelope of the parabolas rooted at the row results along every column. Both passes are linear in the number of cells,
+ * and the rows and columns are independent, so they are split among multiple threads.
+ * The occupancy of the cells is stored, and only the rows containing changed cells are recalculated in the first pass.
+ * The second pass is only executed for the columns whose row results have changed - a changed cell only affects
+ * the columns between its nearest occupied neighbours in its row, so sparse changes between frames are cheap.
+ * The threads are started in every update, multithreading only pays off for large grids.
+ * The row results are stored column-major, so the second pass reads them sequentially - the first pass writes them in blocks of rows.
+ * @note The object stores 9 bytes per cell, large grids should be allocated statically or on the heap.
+ * @tparam size_ Number of cells along the sides of the grid.
+ **/
+template <uint32_t size_>
+class DistanceTransform {
+public:
+    static_assert(size_ >= 2 && size_ <= 4096, "Invalid size - the squared distances along the rows must be exact in 32-bit floating point!");
+
+    static constexpr float32_t MAX_DISTANCE = 2 * size_;    // Distance of the cells (in cells) if there is no occupied cell in the grid.
+
+    /* @brief Constructor - sets the cell geometry, with no occupied cells.
+     * @param resolution Side length of the cells.
+     * @param origin The lower-left corner of the grid.
+     **/
+    explicit DistanceTransform(meter_t resolution, const Point2m& origin = Point2m(meter_t(0), meter_t(0)))
+        : resolution_(resolution)
+        , origin_(origin) {
+        for (uint32_t i = 0; i < size_ * size_; ++i) {
+            this->occupied_[i] = 0;
+            this->rows_[i] = INF;
+            this->dist_[i] = MAX_DISTANCE;
+        }
+        for (uint32_t y = 0; y < size_; ++y) {
+            this->dirtyRows_[y] = 0;
+        }
+    }
+
+    /* @brief Sets the lower-left corner of the grid.
+     * @param origin The lower-left corner of the grid.
+     **/
+    void setOrigin(const Point2m& origin) { this->origin_ = origin; }
+
+    /* @brief Sets the occupancy of a cell. The distances are recalculated by update().
+     * @param x The X coordinate of the cell in the grid.
+     * @param y The Y coordinate of the cell in the grid.
+     * @param occupied Indicates if the cell is occupied.
+     **/
+    void set(uint32_t x, uint32_t y, bool occupied) {
+        uint8_t& cell = this->occupied_[y * size_ + x];
+        this->dirtyRows_[y] |= cell ^ static_cast<uint8_t>(occupied);
+        cell = static_cast<uint8_t>(occupied);
+    }
+
+    /* @brief Sets the occupancy of all cells. The distances are recalculated by update().
+     * @tparam F Type of the occupancy function - callable with signature bool(uint32_t x, uint32_t y).
+     * @param occupied The occupancy function.
+     **/
+    template <typename F>
+    void assign(F occupied) {
+        for (uint32_t y = 0; y < size_; ++y) {
+            for (uint32_t x = 0; x < size_; ++x) {
+                this->set(x, y, occupied(x, y));
+            }
+        }
+    }
+
+    /* @brief Sets the occupancy and the origin from the window of an occupancy grid. The distances are recalculated by update().
+     * @param grid The occupancy grid - its window must have the same size as the distance transform.
+     * @param threshold Cells with log-odds above the threshold are occupied.
+     **/
+    template <uint32_t sizeTiles_, uint32_t tileBits_>
+    void assign(const OccupancyGrid<sizeTiles_, tileBits_>& grid, float32_t threshold = 0.0f) {
+        static_assert(OccupancyGrid<sizeTiles_, tileBits_>::SIZE == size_, "The window of the grid must have the same size as the distance transform!");
+        const Point2i origin = grid.originCell();
+        this->resolution_ = grid.resolution();
+        this->origin_ = grid.origin();
+        this->assign([&grid, &origin, threshold](uint32_t x, uint32_t y) {
+            return grid.logOdds(Point2i(origin.X + static_cast<int32_t>(x), origin.Y + static_cast<int32_t>(y))) > threshold;
+        });
+    }
+
+    /* @brief Recalculates the distances after occupancy changes.
+     * @param numThreads Number of threads (1 means the calling thread only). Limited by detail::MAX_THREADS.
+     * @returns Number of recalculated columns.
+     **/
+    uint32_t update(uint32_t numThreads = 1);
+
+    /* @brief Gets the distance of a cell from the nearest occupied cell.
+     * @param x The X coordinate of the cell in the grid.
+     * @param y The Y coordinate of the cell in the grid.
+     * @returns The distance between the cell centers.
+     **/
+    meter_t distance(uint32_t x, uint32_t y) const {
+        return this->resolution_ * static_cast<float64_t>(this->dist_[x * size_ + y]);
+    }
+
+    /* @brief Gets the distance of a position from the nearest occupied cell, interpolated bilinearly between the cell centers.
+     * Positions outside the grid get the distance of the nearest border position.
+     * @param pos The position.
+     * @returns The interpolated distance.
+     **/
+    meter_t distance(const Point2m& pos) const;
+
+    /* @brief Gets the side length of the cells.
+     * @returns The resolution.
+     **/
+    meter_t resolution() const { return this->resolution_; }
+
+    /* @brief Gets the lower-left corner of the grid.
+     * @returns The lower-left corner of the grid.
+     **/
+    const Point2m& origin() const { return this->origin_; }
+
+private:
+    static constexpr float32_t INF = std::numeric_limits<float32_t>::infinity();
+    static constexpr uint32_t ROW_BLOCK = 8;    // Number of rows processed together in the first pass.
+
+    // first pass - calculates the squared distances to the nearest occupied cell in a block of rows, returns the ranges of changed columns of the rows
+    void transformRows(const uint32_t *ys, uint32_t numRows, uint32_t *minChanged, uint32_t *maxChanged);
+
+    // second pass - lower envelope of the parabolas rooted at the row results of the column
+    void transformColumn(uint32_t x);
+
+    meter_t resolution_;                    // Side length of the cells.
+    Point2m origin_;                        // Lower-left corner of the grid.
+    uint8_t occupied_[size_ * size_];       // Occupancy of the cells (row-major).
+    uint8_t dirtyRows_[size_];              // Indicates if the row contains changed cells.
+    float32_t rows_[size_ * size_];         // Squared distances along the rows in cells (column-major), infinite if the row is empty.
+    float32_t dist_[size_ * size_];         // Distances in cells (column-major).
+};
+
+template <uint32_t size_> constexpr float32_t DistanceTransform<size_>::MAX_DISTANCE;
+template <uint32_t size_> constexpr float32_t DistanceTransform<size_>::INF;
+template <uint32_t size_> constexpr uint32_t DistanceTransform<size_>::ROW_BLOCK;
+
+template <uint32_t size_>
+uint32_t DistanceTransform<size_>::update(uint32_t numThreads) {
+    // the ranges of the threads are given by the number of dirty rows and columns, so that the threads get equal work
+    uint32_t dirty[size_];
+    uint32_t numDirty = 0;
+    for (uint32_t y = 0; y < size_; ++y) {
+        if (this->dirtyRows_[y]) {
+            this->dirtyRows_[y] = 0;
+            dirty[numDirty++] = y;
+        }
+    }
+    if (numDirty == 0) {
+        return 0;
+    }
+
+    // every row records the range of its changed columns
+    uint32_t minChanged[size_], maxChanged[size_];
+    detail::parallel_for(numDirty, numThreads, [this, &dirty, &minChanged, &maxChanged](uint32_t begin, uint32_t end, uint32_t) {
+        for (uint32_t i = begin; i < end; i += ROW_BLOCK) {
+            this->transformRows(&dirty[i], bcr::min(end - i, ROW_BLOCK), &minChanged[i], &maxChanged[i]);
+        }
+    });
+
+    uint8_t changed[size_] = {};
+    for (uint32_t i = 0; i < numDirty; ++i) {
+        for (uint32_t x = minChanged[i]; x <= maxChanged[i] && x < size_; ++x) {
+            changed[x] = 1;
+        }
+    }
+    uint32_t columns[size_];
+    uint32_t numColumns = 0;
+    for (uint32_t x = 0; x < size_; ++x) {
+        if (changed[x]) {
+            columns[numColumns++] = x;
+        }
+    }
+
+    detail::parallel_for(numColumns, numThreads, [this, &columns](uint32_t begin, uint32_t end, uint32_t) {
+        for (uint32_t i = begin; i < end; ++i) {
+            this->transformColumn(columns[i]);
+        }
+    });
+    return numColumns;
+}
+
+template <uint32_t size_>
+void DistanceTransform<size_>::transformRows(const uint32_t *ys, uint32_t numRows, uint32_t *minChanged, uint32_t *maxChanged) {
+    // the 1D transform of a binary row is the squared distance to the nearest occupied cell, found by a forward and a backward sweep
+    float32_t d[ROW_BLOCK][size_];
+    for (uint32_t r = 0; r < numRows; ++r) {
+        const uint8_t *const occupied = &this->occupied_[ys[r] * size_];
+        float32_t *const row = d[r];
+
+        float32_t last = -INF;
+        for (uint32_t x = 0; x < size_; ++x) {
+            last = occupied[x] ? static_cast<float32_t>(x) : last;
+            row[x] = static_cast<float32_t>(x) - last;
+        }
+        last = INF;
+        for (uint32_t x = size_; x-- > 0;) {
+            last = occupied[x] ? static_cast<float32_t>(x) : last;
+            const float32_t dist = bcr::min(row[x], last - static_cast<float32_t>(x));
+            row[x] = dist * dist;
+        }
+        minChanged[r] = size_;
+        maxChanged[r] = 0;
+    }
+
+    // the results of the rows of the block are written together - consecutive rows are adjacent in the column-major storage
+    for (uint32_t x = 0; x < size_; ++x) {
+        float32_t *const column = &this->rows_[x * size_];
+        for (uint32_t r = 0; r < numRows; ++r) {
+            if (column[ys[r]] != d[r][x]) {
+                column[ys[r]] = d[r][x];
+                minChanged[r] = bcr::min(minChanged[r], x);
+                maxChanged[r] = x;
+            }
+        }
+    }
+}
+
+template <uint32_t size_>
+void DistanceTransform<size_>::transformColumn(uint32_t x) {
+    const float32_t *const f = &this->rows_[x * size_];
+    float32_t *const dist = &this->dist_[x * size_];
+
+    // v: roots of the parabolas of the lower envelope, z: boundaries of the envelope segments
+    // the row results are integers, the numerators of the intersections are calculated exactly in 32-bit integer arithmetic:
+    // (f[q] + q^2) - (f[p] + p^2) = (f[q] - f[p]) + (q - p) * (q + p), both terms are below size_^2
+    // the boundaries are compared to the cell indices, they are stored in 64-bit floating point so that the rounding cannot change the envelope
+    int32_t v[size_];
+    float64_t z[size_ + 1];
+    int32_t k = -1;
+    for (int32_t q = 0; q < static_cast<int32_t>(size_); ++q) {
+        if (f[q] == INF) {
+            continue;
+        }
+        const int32_t fq = static_cast<int32_t>(f[q]);
+        if (k < 0) {
+            k = 0;
+            v[0] = q;
+            z[0] = -std::numeric_limits<float64_t>::infinity();
+            z[1] = std::numeric_limits<float64_t>::infinity();
+            continue;
+        }
+
+        float64_t s;
+        while (true) {
+            const int32_t p = v[k];
+            s = static_cast<float64_t>((fq - static_cast<int32_t>(f[p])) + (q - p) * (q + p)) / static_cast<float64_t>(2 * (q - p));
+            if (s > z[k] || k == 0) {
+                break;
+            }
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<float64_t>::infinity();
+    }
+
+    if (k < 0) {
+        for (uint32_t q = 0; q < size_; ++q) {
+            dist[q] = MAX_DISTANCE;
+        }
+        return;
+    }
+
+    k = 0;
+    for (int32_t q = 0; q < static_cast<int32_t>(size_); ++q) {
+        while (z[k + 1] < static_cast<float64_t>(q)) {
+            ++k;
+        }
+        const float32_t dq = static_cast<float32_t>(q - v[k]);
+        dist[q] = std::sqrt(dq * dq + f[v[k]]);
+    }
+}
+
+template <uint32_t size_>
+meter_t DistanceTransform<size_>::distance(const Point2m& pos) const {
+    // continuous cell coordinates, relative to the center of the first cell
+    const float32_t fx = bcr::clamp(static_cast<float32_t>(((pos.X - this->origin_.X) / this->resolution_) - 0.5), 0.0f, static_cast<float32_t>(size_ - 1));
+    const float32_t fy = bcr::clamp(static_cast<float32_t>(((pos.Y - this->origin_.Y) / this->resolution_) - 0.5), 0.0f, static_cast<float32_t>(size_ - 1));
+    const uint32_t x = bcr::min(static_cast<uint32_t>(fx), size_ - 2), y = bcr::min(static_cast<uint32_t>(fy), size_ - 2);
+    const float32_t tx = fx - static_cast<float32_t>(x), ty = fy - static_cast<float32_t>(y);
+
+    const float32_t *const c0 = &this->dist_[x * size_ + y];
+    const float32_t *const c1 = c0 + size_;
+    const float32_t d0 = c0[0] + (c0[1] - c0[0]) * ty;
+    const float32_t d1 = c1[0] + (c1[1] - c1[0]) * ty;
+    return this->resolution_ * static_cast<float64_t>(d0 + (d1 - d0) * tx);
+}
+
+} // namespace bcr
@@ -6,27 +6,534 @@
 #include <utility>
 
 namespace bcr {
+namespace detail {
+
+/**
+ * @brief Solves quadratic equation which is in form: A*x^2 + B*x + C = 0, without branches (can be inlined into vectorized loops).
+ * The root with the larger magnitude is calculated as q/A, where q = -(B + sgn(B) * sqrt(det)) / 2,
+ * and the other one as C/q (product of the roots), so there is no cancellation when B^2 >> 4*A*C.
+ * Discriminants within the rounding error of zero (relative to B^2 and 4*A*C) are treated as one (double) root.
+ * The tolerance is relative, so equations with small coefficients (e.g. short segments in segmentCircle_exit()) are solved correctly.
+ * If A is zero, the equation is linear, and its root is C/q = -C/B.
+ * @param A The coefficient of x^2.
+ * @param B The coefficient of x.
+ * @param C The constant.
+ * @param x1 The first root: (-B + sqrt(det)) / (2*A), or the only root. NaN if there are no roots.
+ * @param x2 The second root: (-B - sqrt(det)) / (2*A). NaN if there is less than two roots.
+ * @returns Number of roots (0, 1 or 2).
+ */
+template <typename T>
+inline uint32_t solve_quadratic_stable(const T A, const T B, const T C, T& x1, T& x2) {
+    static_assert(std::is_floating_point<T>::value, "Quadratic equation can only be solved for floating point types!");
+
+    const T NaN = std::numeric_limits<T>::quiet_NaN();
+
+    const T B2 = B * B, AC4 = 4 * A * C;
+    const T det = B2 - AC4;
+    const T tol = 4 * std::numeric_limits<T>::epsilon() * (B2 + bcr::abs(AC4));  // rounding error bound of the discriminant
+    const bool linear = A == T(0);
+    const bool two = !linear & (det > tol);
+    const bool one = (linear & (B != T(0))) | (!linear & !two & (det >= -tol));
+
+    const T sq = std::sqrt(two | linear ? det : T(0));   // for linear equations det = B^2, so C/q = -C/B
+    const T q = T(-0.5) * (B + (B < T(0) ? -sq : sq));
+    // the divisions are not guarded (selected operands make the compiler branch around them), invalid results are not selected below
+    const T r1 = q / A;     // root with the larger magnitude
+    const T r2 = C / q;     // root with the smaller magnitude
+
+    // for two roots r1 is the first one if B is negative, the second one otherwise
+    // (the selections are flattened, nested conditional expressions prevent vectorization)
+    const bool firstIsR1 = (two & (B < T(0))) | (!two & !linear);
+    const T first = firstIsR1 ? r1 : r2;
+    const T second = firstIsR1 ? r2 : r1;
+    x1 = two | one ? first : NaN;
+    x2 = two ? second : NaN;
+    return 2 * static_cast<uint32_t>(two) + static_cast<uint32_t>(one);
+}
+
+} // namespace detail
 
 /**
  * @brief Solves quadratic equation which is in form: A*x^2 + B*x + C
+ * @returns The roots: (-B + sqrt(det)) / (2*A) and (-B - sqrt(det)) / (2*A). Missing roots are NaN.
+ * If the discriminant is zero (within its rounding error) or A is zero, the only root is the first one.
  */
 template <typename T>
 std::pair<T, T> solve_quadratic(const T& A, const T& B, const T& C) {
-    const T det = B*B - 4 * A * C;
+    std::pair<T, T> result;
+    detail::solve_quadratic_stable(A, B, C, result.first, result.second);
+    return result;
+}
 
-    std::pair<T, T> result = { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() };
+/**
+ * @brief Solves multiple quadratic equations in form: A[i]*x^2 + B[i]*x + C[i] (structure of arrays).
+ * The loop is branch-free, so it can be vectorized by the compiler for float and double (std::sqrt needs -fno-math-errno for that).
+ * @param A The coefficients of x^2.
+ * @param B The coefficients of x.
+ * @param C The constants.
+ * @param size Number of equations.
+ * @param x1 The first roots, see solve_quadratic(). NaN if an equation has no roots.
+ * @param x2 The second roots, see solve_quadratic(). NaN if an equation has less than two roots.
+ * @param numRoots The number of roots of the equations (0, 1 or 2).
+ * @returns Number of equations that have at least one root.
+ */
+template <typename T>
+uint32_t solve_quadratic(const T *A, const T *B, const T *C, uint32_t size, T *x1, T *x2, uint32_t *numRoots) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        const uint32_t n = detail::solve_quadratic_stable(A[i], B[i], C[i], x1[i], x2[i]);
+        numRoots[i] = n;
+        count += n != 0 ? 1 : 0;
+    }
+    return count;
+}
 
-    if (isZero(det)) {
-        result.first = -B / (2 * A);
-    } else if (det > 0) {
-        const T sq = sqrt(det);
+namespace detail {
 
-        result.first  = (-B + sq) / (2 * A);
-        result.second = (-B - sq) / (2 * A);
+/**
+ * @brief Evaluates polynomial and its derivative using the Horner scheme.
+ * @param coeffs The coefficients - coeffs[i] is the coefficient of x^i.
+ * @param degree The degree of the polynomial.
+ * @param x The variable.
+ * @param value The value of the polynomial.
+ * @param deriv The value of the derivative.
+ * @returns The rounding error bound of the value (values within the bound are not distinguishable from zero).
+ */
+template <typename T>
+inline T eval_polynomial(const T *coeffs, uint32_t degree, const T x, T& value, T& deriv) {
+    const T ax = bcr::abs(x);
+    T p = coeffs[degree], d = T(0), bound = bcr::abs(p) / 2;
+    for (uint32_t i = degree; i-- > 0;) {
+        d = d * x + p;
+        p = p * x + coeffs[i];
+        bound = bound * ax + bcr::abs(p);
     }
+    value = p;
+    deriv = d;
+    return (2 * bound - bcr::abs(p)) * std::numeric_limits<T>::epsilon();
+}
 
-    return result;
+/**
+ * @brief Improves root of a polynomial with Newton iterations. A step is only accepted if it decreases the absolute value of the polynomial.
+ * @param coeffs The coefficients - coeffs[i] is the coefficient of x^i.
+ * @param degree The degree of the polynomial.
+ * @param x The root.
+ * @returns The improved root.
+ */
+template <typename T>
+inline T polish_root(const T *coeffs, uint32_t degree, T x) {
+    static constexpr uint32_t MAX_ITERATIONS = 3;
+
+    T p, d;
+    eval_polynomial(coeffs, degree, x, p, d);
+    for (uint32_t i = 0; i < MAX_ITERATIONS && p != T(0) && d != T(0); ++i) {
+        const T next = x - p / d;
+        T pNext, dNext;
+        eval_polynomial(coeffs, degree, next, pNext, dNext);
+        if (!(bcr::abs(pNext) < bcr::abs(p))) {
+            break;
+        }
+        x = next;
+        p = pNext;
+        d = dNext;
+    }
+    return x;
 }
 
-} // namespace bcr
+/**
+ * @brief Polishes a double root estimate of a polynomial, which may be two close real roots.
+ * The quadratic factors of the closed-form solvers cannot separate roots closer than their own rounding error, but the polynomial can:
+ * if its value at the estimate is distinguishable from zero, the roots of its Taylor polynomial of degree 2 around the estimate
+ * are polished with Newton iterations. Otherwise (or if the Taylor polynomial has no real roots) the estimate is polished as one root.
+ * @restrict The degree must be at most 4.
+ * @param coeffs The coefficients - coeffs[i] is the coefficient of x^i.
+ * @param degree The degree of the polynomial.
+ * @param x The double root estimate.
+ * @param x1 The first root.
+ * @param x2 The second root, if there are two roots.
+ * @returns Number of roots (1 or 2).
+ */
+template <typename T>
+inline uint32_t polish_double_root(const T *coeffs, uint32_t degree, const T x, T& x1, T& x2) {
+    T deriv[4];
+    for (uint32_t i = 0; i < degree; ++i) {
+        deriv[i] = coeffs[i + 1] * static_cast<T>(i + 1);
+    }
+
+    T p, d, dd, unused;
+    const T bound = eval_polynomial(coeffs, degree, x, p, unused);
+    eval_polynomial(deriv, degree - 1, x, d, dd);
+
+    T h1, h2;
+    if (bcr::abs(p) > bound && solve_quadratic_stable(dd / 2, d, p, h1, h2) == 2) {
+        x1 = polish_root(coeffs, degree, x + h1);
+        x2 = polish_root(coeffs, degree, x + h2);
+        if (x1 != x2) {
+            return 2;
+        }
+    }
+    x1 = polish_root(coeffs, degree, x);
+    return 1;
+}
+
+/**
+ * @brief Sorts roots in increasing order (insertion sort, for a few elements).
+ * @param roots The roots.
+ * @param size Number of roots.
+ */
+template <typename T>
+inline void sort_roots(T *roots, uint32_t size) {
+    for (uint32_t i = 1; i < size; ++i) {
+        const T r = roots[i];
+        uint32_t j = i;
+        for (; j > 0 && roots[j - 1] > r; --j) {
+            roots[j] = roots[j - 1];
+        }
+        roots[j] = r;
+    }
+}
+
+/**
+ * @brief Finds the root of a polynomial that is monotonic in the given interval, using Newton iterations safeguarded by bisection.
+ * The iteration follows the computed sign of the polynomial until the bracket collapses - it does not stop at the rounding error bound,
+ * which is usually far larger than the actual rounding error for ill-conditioned roots.
+ * @restrict The polynomial must have different signs at the interval endpoints.
+ * @param coeffs The coefficients - coeffs[i] is the coefficient of x^i.
+ * @param degree The degree of the polynomial.
+ * @param lo The lower endpoint of the interval.
+ * @param hi The upper endpoint of the interval.
+ * @param fLo The value of the polynomial at the lower endpoint.
+ * @returns The root.
+ */
+template <typename T>
+T bracketed_root(const T *coeffs, uint32_t degree, T lo, T hi, const T fLo) {
+    static constexpr uint32_t MAX_ITERATIONS = 100;
+
+    const bool increasing = fLo < T(0);     // lo is on the negative side if the polynomial is increasing
+    T x = (lo + hi) / 2;
+    for (uint32_t i = 0; i < MAX_ITERATIONS; ++i) {
+        T p, d;
+        eval_polynomial(coeffs, degree, x, p, d);
+        if (p == T(0)) {
+            break;
+        }
+        if ((p < T(0)) == increasing) {
+            lo = x;
+        } else {
+            hi = x;
+        }
 
+        // Newton step if it stays inside the bracket, bisection otherwise
+        T next = d != T(0) ? x - p / d : lo;
+        if (!(next > lo && next < hi)) {
+            next = (lo + hi) / 2;
+        }
+        if (next == x || hi - lo <= std::numeric_limits<T>::epsilon() * bcr::max(bcr::abs(lo), bcr::abs(hi))) {
+            x = next;
+            break;
+        }
+        x = next;
+    }
+    return x;
+}
+
+} // namespace detail
+
+/**
+ * @brief Solves cubic equation which is in form: A*x^3 + B*x^2 + C*x + D = 0
+ * The closed-form roots (Cardano's formula for one real root, trigonometric formula for three real roots)
+ * are polished with Newton iterations on the original polynomial.
+ * If A is zero, the quadratic equation is solved.
+ * The accuracy is limited by the conditioning of the roots (the rounding error of the polynomial value divided by the derivative).
+ * Measured by bench/eq_solver against a long double reference, for roots in [-10, 10] at least 0.5 apart:
+ * max. error 1e-5 (float), 2e-14 (double) - relative for roots larger than 1, absolute otherwise.
+ * Double root estimates are checked on the original polynomial (see detail::polish_double_root()), so close roots are separated
+ * if the polynomial between them is distinguishable from zero.
+ * Roots of multiplicity 2 or 3 are ill-conditioned, their error is about eps^(1/2) or eps^(1/3),
+ * and they may be returned once or multiple times depending on rounding.
+ * @param A The coefficient of x^3.
+ * @param B The coefficient of x^2.
+ * @param C The coefficient of x.
+ * @param D The constant.
+ * @param roots The real roots in increasing order - must have space for 3 values.
+ * @returns Number of real roots (0 - 3).
+ */
+template <typename T>
+uint32_t solve_cubic(const T& A, const T& B, const T& C, const T& D, T *roots) {
+    static_assert(std::is_floating_point<T>::value, "Cubic equation can only be solved for floating point types!");
+
+    uint32_t n = 0;
+    if (A == T(0)) {
+        T x1, x2;
+        n = detail::solve_quadratic_stable(B, C, D, x1, x2);
+        roots[0] = x1;
+        roots[1] = x2;
+        if (n == 1 && B != T(0)) {
+            // double root, or two roots closer than the rounding error of the discriminant
+            const T coeffs[3] = { D, C, B };
+            n = detail::polish_double_root(coeffs, 2, x1, roots[0], roots[1]);
+        }
+    } else {
+        // x^3 + a*x^2 + b*x + c = 0
+        const T a = B / A, b = C / A, c = D / A;
+        const T a_3 = a / 3;
+        const T Q = (a * a - 3 * b) / 9;
+        const T R = (a * (2 * a * a - 9 * b) + 27 * c) / 54;
+        const T R2 = R * R, Q3 = Q * Q * Q;
+
+        if (R2 < Q3) {
+            // three real roots
+            const T sqQ = std::sqrt(Q);
+            const T theta = std::acos(bcr::max(T(-1), bcr::min(T(1), R / (sqQ * Q))));
+            const T TWO_PI = static_cast<T>(6.28318530717958647692528676656);
+            roots[0] = -2 * sqQ * std::cos(theta / 3) - a_3;
+            roots[1] = -2 * sqQ * std::cos((theta + TWO_PI) / 3) - a_3;
+            roots[2] = -2 * sqQ * std::cos((theta - TWO_PI) / 3) - a_3;
+            n = 3;
+        } else {
+            // one real root, and a double root if the complex roots coincide
+            const T U = -std::copysign(std::cbrt(bcr::abs(R) + std::sqrt(R2 - Q3)), R);
+            const T V = U != T(0) ? Q / U : T(0);
+            roots[0] = U + V - a_3;
+            n = 1;
+            if (bcr::abs(U - V) <= std::sqrt(std::numeric_limits<T>::epsilon()) * bcr::abs(U)) {
+                roots[1] = -(U + V) / 2 - a_3;
+                n = 2;
+            }
+        }
+
+        const T coeffs[4] = { D, C, B, A };
+        roots[0] = detail::polish_root(coeffs, 3, roots[0]);
+        if (n == 2) {
+            // double root, or two close roots
+            n = 1 + detail::polish_double_root(coeffs, 3, roots[1], roots[1], roots[2]);
+        } else {
+            for (uint32_t i = 1; i < n; ++i) {
+                roots[i] = detail::polish_root(coeffs, 3, roots[i]);
+            }
+        }
+    }
+
+    detail::sort_roots(roots, n);
+    return n;
+}
+
+/**
+ * @brief Solves quartic equation which is in form: A*x^4 + B*x^3 + C*x^2 + D*x + E = 0
+ * The roots are calculated with Ferrari's method (the quartic is factored into two quadratics using a root of the resolvent cubic),
+ * then polished with Newton iterations on the original polynomial.
+ * If A is zero, the cubic equation is solved.
+ * The accuracy is limited by the conditioning of the roots (the rounding error of the polynomial value divided by the derivative).
+ * Measured by bench/eq_solver against a long double reference, for roots in [-10, 10] at least 0.5 apart:
+ * max. error 8e-5 (float), 3e-13 (double) - relative for roots larger than 1, absolute otherwise.
+ * Double roots of the quadratic factors are checked on the original polynomial (see detail::polish_double_root()),
+ * so close roots are separated if the polynomial between them is distinguishable from zero.
+ * Multiple roots are ill-conditioned, and may be returned once or multiple times depending on rounding.
+ * @param A The coefficient of x^4.
+ * @param B The coefficient of x^3.
+ * @param C The coefficient of x^2.
+ * @param D The coefficient of x.
+ * @param E The constant.
+ * @param roots The real roots in increasing order - must have space for 4 values.
+ * @returns Number of real roots (0 - 4).
+ */
+template <typename T>
+uint32_t solve_quartic(const T& A, const T& B, const T& C, const T& D, const T& E, T *roots) {
+    static_assert(std::is_floating_point<T>::value, "Quartic equation can only be solved for floating point types!");
+
+    if (A == T(0)) {
+        return solve_cubic(B, C, D, E, roots);
+    }
+
+    // x^4 + a*x^3 + b*x^2 + c*x + d = 0, x = y - a/4 -> y^4 + p*y^2 + q*y + r = 0
+    const T a = B / A, b = C / A, c = D / A, d = E / A;
+    const T a2 = a * a;
+    const T p = b - T(3) / 8 * a2;
+    const T q = c - a * b / 2 + a2 * a / 8;
+    const T r = d - a * c / 4 + a2 * b / 16 - T(3) / 256 * a2 * a2;
+
+    // double roots of the quadratic factors are flagged, they may be two close roots of the quartic
+    uint32_t n = 0;
+    bool twice[4] = { false, false, false, false };
+    T x1, x2;
+    if (bcr::abs(q) <= std::numeric_limits<T>::epsilon() * (bcr::abs(c) + bcr::abs(a * b) + bcr::abs(a2 * a))) {
+        // biquadratic: z^2 + p*z + r = 0, y = +-sqrt(z)
+        const uint32_t nz = detail::solve_quadratic_stable(T(1), p, r, x1, x2);
+        const T z[2] = { x1, x2 };
+        for (uint32_t i = 0; i < nz; ++i) {
+            if (z[i] >= T(0)) {
+                const T y = std::sqrt(z[i]);
+                twice[n] = nz == 1;
+                roots[n++] = y;
+                if (y != T(0)) {
+                    twice[n] = nz == 1;
+                    roots[n++] = -y;
+                }
+            }
+        }
+    } else {
+        // resolvent cubic: m^3 + p*m^2 + (p^2/4 - r)*m - q^2/8 = 0 - it has a positive root as q is not zero
+        T m[3];
+        const uint32_t nm = solve_cubic(T(1), p, p * p / 4 - r, -q * q / 8, m);
+        const T s = std::sqrt(2 * bcr::max(m[nm - 1], std::numeric_limits<T>::min()));
+        const T k = p / 2 + m[nm - 1];
+        const T l = q / (2 * s);
+
+        // (y^2 - s*y + k + l) * (y^2 + s*y + k - l) = 0
+        n = detail::solve_quadratic_stable(T(1), -s, k + l, x1, x2);
+        roots[0] = x1;
+        roots[1] = x2;
+        twice[0] = n == 1;
+        const uint32_t n2 = detail::solve_quadratic_stable(T(1), s, k - l, x1, x2);
+        roots[n] = x1;
+        roots[n + 1] = x2;
+        twice[n] = n2 == 1;
+        n += n2;
+    }
+
+    // a flagged root stands for two roots, so the split roots fit in the array
+    const T coeffs[5] = { E, D, C, B, A };
+    const uint32_t numEstimates = n;
+    for (uint32_t i = 0; i < numEstimates; ++i) {
+        if (twice[i]) {
+            n += detail::polish_double_root(coeffs, 4, roots[i] - a / 4, roots[i], roots[n]) - 1;
+        } else {
+            roots[i] = detail::polish_root(coeffs, 4, roots[i] - a / 4);
+        }
+    }
+
+    detail::sort_roots(roots, n);
+    return n;
+}
+
+/**
+ * @brief Finds the real roots of a polynomial in the given interval.
+ * The roots are isolated by the roots of the derivative (found recursively, starting from the linear derivative),
+ * so the polynomial is monotonic between consecutive isolation points, and each root is found with safeguarded Newton iterations.
+ * A sign change between consecutive isolation points is always bracketed, even if the value at an isolation point is within
+ * the rounding error bound of zero (two close roots around a root of the derivative). Roots of even multiplicity (where the polynomial
+ * does not change sign) are found if the value at the root of the derivative is within the rounding error bound of zero.
+ * Measured accuracy (bench/eq_solver, degree 6, roots in [-10, 10] at least 0.5 apart): max. error 2e-3 (float), 2e-11 (double).
+ * @tparam maxDegree The maximum degree of the polynomial - determines the size of the work buffers (on the stack).
+ * @param coeffs The coefficients - coeffs[i] is the coefficient of x^i.
+ * @param degree The degree of the polynomial. Limited by maxDegree. The leading coefficient must not be zero.
+ * @param lo The lower endpoint of the interval.
+ * @param hi The upper endpoint of the interval.
+ * @param roots The roots in increasing order - must have space for degree values.
+ * @returns Number of roots in the interval.
+ */
+template <uint32_t maxDegree, typename T>
+uint32_t solve_polynomial(const T *coeffs, uint32_t degree, T lo, T hi, T *roots) {
+    static_assert(std::is_floating_point<T>::value, "Polynomial equation can only be solved for floating point types!");
+    static_assert(maxDegree >= 1, "Maximum degree must be at least 1!");
+
+    degree = bcr::min(degree, maxDegree);
+    if (degree == 0) {
+        return 0;
+    }
+
+    // derivs[k] holds the coefficients of the derivative of order (degree - k), which is a polynomial of degree k
+    T derivs[maxDegree + 1][maxDegree + 1];
+    for (uint32_t i = 0; i <= degree; ++i) {
+        derivs[degree][i] = coeffs[i];
+    }
+    for (uint32_t k = degree; k > 1; --k) {
+        for (uint32_t i = 0; i < k; ++i) {
+            derivs[k - 1][i] = derivs[k][i + 1] * static_cast<T>(i + 1);
+        }
+    }
+
+    // isolation points of level k are the endpoints and the roots of level k - 1 between them
+    // (a polynomial of degree k has at most k roots, so the buffers are capped at k entries)
+    T buffers[2][maxDegree];
+    T *prev = buffers[0], *cur = buffers[1];
+    uint32_t numPrev = 0;
+
+    for (uint32_t k = 1; k <= degree; ++k) {
+        const T *c = derivs[k];
+
+        T x[maxDegree + 1], f[maxDegree + 1], bound[maxDegree + 1];
+        uint32_t numPoints = 0;
+        for (uint32_t i = 0; i <= numPrev + 1; ++i) {
+            const T v = i == 0 ? lo : i <= numPrev ? prev[i - 1] : hi;
+            if ((numPoints == 0 || v > x[numPoints - 1]) && !(v > hi)) {
+                T d;
+                x[numPoints] = v;
+                bound[numPoints] = detail::eval_polynomial(c, k, v, f[numPoints], d);
+                ++numPoints;
+            }
+        }
+
+        // a sign change between consecutive points is bracketed even if the value at a point is within the rounding error bound
+        // (two close roots around a root of the derivative), a point is only a root if there is no sign change on either side
+        uint32_t numCur = 0;
+        bool left = false;
+        for (uint32_t i = 0; i < numPoints && numCur < k; ++i) {
+            const bool right = i + 1 < numPoints && ((f[i] < T(0) && f[i + 1] > T(0)) || (f[i] > T(0) && f[i + 1] < T(0)));
+            if (left) {
+                cur[numCur++] = detail::bracketed_root(c, k, x[i - 1], x[i], f[i - 1]);
+            }
+            if (!left && !right && bcr::abs(f[i]) <= bound[i] && numCur < k) {
+                cur[numCur++] = x[i];
+            }
+            left = right;
+        }
+
+        std::swap(prev, cur);
+        numPrev = numCur;
+    }
+
+    for (uint32_t i = 0; i < numPrev; ++i) {
+        roots[i] = prev[i];
+    }
+    return numPrev;
+}
+
+/**
+ * @brief Solves multiple cubic equations in form: A[i]*x^3 + B[i]*x^2 + C[i]*x + D[i] = 0 (structure of arrays).
+ * @param A The coefficients of x^3.
+ * @param B The coefficients of x^2.
+ * @param C The coefficients of x.
+ * @param D The constants.
+ * @param size Number of equations.
+ * @param roots The roots in increasing order - root j of equation i is at roots[j * size + i]. Must have space for 3 * size values.
+ *              Missing roots are NaN.
+ * @param numRoots The number of roots of the equations.
+ */
+template <typename T>
+void solve_cubic(const T *A, const T *B, const T *C, const T *D, uint32_t size, T *roots, uint32_t *numRoots) {
+    for (uint32_t i = 0; i < size; ++i) {
+        T r[3];
+        const uint32_t n = solve_cubic(A[i], B[i], C[i], D[i], r);
+        for (uint32_t j = 0; j < 3; ++j) {
+            roots[j * size + i] = j < n ? r[j] : std::numeric_limits<T>::quiet_NaN();
+        }
+        numRoots[i] = n;
+    }
+}
+
+/**
+ * @brief Solves multiple quartic equations in form: A[i]*x^4 + B[i]*x^3 + C[i]*x^2 + D[i]*x + E[i] = 0 (structure of arrays).
+ * @param A The coefficients of x^4.
+ * @param B The coefficients of x^3.
+ * @param C The coefficients of x^2.
+ * @param D The coefficients of x.
+ * @param E The constants.
+ * @param size Number of equations.
+ * @param roots The roots in increasing order - root j of equation i is at roots[j * size + i]. Must have space for 4 * size values.
+ *              Missing roots are NaN.
+ * @param numRoots The number of roots of the equations.
+ */
+template <typename T>
+void solve_quartic(const T *A, const T *B, const T *C, const T *D, const T *E, uint32_t size, T *roots, uint32_t *numRoots) {
+    for (uint32_t i = 0; i < size; ++i) {
+        T r[4];
+        const uint32_t n = solve_quartic(A[i], B[i], C[i], D[i], E[i], r);
+        for (uint32_t j = 0; j < 4; ++j) {
+            roots[j * size + i] = j < n ? r[j] : std::numeric_limits<T>::quiet_NaN();
+        }
+        numRoots[i] = n;
+    }
+}
+
+} // namespace bcr
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <babocar-core/types.hpp>
+
+#include <limits>
+#include <type_traits>
+
+namespace bcr {
+
+template <typename T, uint32_t frac_bits_> class fixed_point;
+
+template <typename T> struct is_fixed_point : public std::false_type {};
+template <typename T, uint32_t frac_bits_> struct is_fixed_point<fixed_point<T, frac_bits_>> : public std::true_type {};
+
+namespace detail {
+
+/* @brief Fixed-point multiplication and division of raw values, with rounding to nearest and saturation.
+ * @tparam T The raw type.
+ **/
+template <typename T> struct fixed_point_ops;
+
+template <>
+struct fixed_point_ops<int32_t> {
+    static int32_t saturate(int64_t value) {
+        return value > std::numeric_limits<int32_t>::max() ? std::numeric_limits<int32_t>::max()
+            : value < std::numeric_limits<int32_t>::min() ? std::numeric_limits<int32_t>::min()
+            : static_cast<int32_t>(value);
+    }
+
+    template <uint32_t F>
+    static int32_t mul(int32_t a, int32_t b) {
+        const bool negative = (a < 0) != (b < 0);
+        const uint64_t m = static_cast<uint64_t>(a < 0 ? -static_cast<int64_t>(a) : a) * static_cast<uint64_t>(b < 0 ? -static_cast<int64_t>(b) : b);
+        const int64_t r = static_cast<int64_t>((m + (static_cast<uint64_t>(1) << F >> 1)) >> F);
+        return saturate(negative ? -r : r);
+    }
+
+    template <uint32_t F>
+    static int32_t div(int32_t a, int32_t b) {
+        if (!b) {
+            return saturate(a > 0 ? std::numeric_limits<int64_t>::max() : a < 0 ? std::numeric_limits<int64_t>::min() : 0);
+        }
+        const bool negative = (a < 0) != (b < 0);
+        const uint64_t ua = static_cast<uint64_t>(a < 0 ? -static_cast<int64_t>(a) : a) << F;
+        const uint64_t ub = static_cast<uint64_t>(b < 0 ? -static_cast<int64_t>(b) : b);
+        const int64_t r = static_cast<int64_t>((ua + ub / 2) / ub);
+        return saturate(negative ? -r : r);
+    }
+};
+
+template <>
+struct fixed_point_ops<int64_t> {
+    static int64_t saturate(uint64_t magnitude, bool negative) {
+        return magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+            ? (negative ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max())
+            : (negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude));
+    }
+
+    static uint64_t magnitude(int64_t value) {
+        return value < 0 ? static_cast<uint64_t>(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    }
+
+    template <uint32_t F>
+    static int64_t mul(int64_t a, int64_t b) {
+        static_assert(F > 0 && F < 64, "Invalid number of fractional bits!");
+        const bool negative = (a < 0) != (b < 0);
+        const uint64_t ua = magnitude(a), ub = magnitude(b);
+
+        // 64x64 -> 128 bit multiplication using 32-bit halves
+        const uint64_t alo = ua & 0xffffffffu, ahi = ua >> 32, blo = ub & 0xffffffffu, bhi = ub >> 32;
+        const uint64_t ll = alo * blo, lh = alo * bhi, hl = ahi * blo, hh = ahi * bhi;
+        const uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        uint64_t lo = (mid << 32) | (ll & 0xffffffffu);
+
+        // rounding
+        const uint64_t half = static_cast<uint64_t>(1) << (F - 1);
+        lo += half;
+        hi += lo < half ? 1 : 0;
+
+        if (hi >> F) {
+            return saturate(~static_cast<uint64_t>(0), negative);
+        }
+        return saturate((hi << (64 - F)) | (lo >> F), negative);
+    }
+
+    template <uint32_t F>
+    static int64_t div(int64_t a, int64_t b) {
+        static_assert(F > 0 && F < 64, "Invalid number of fractional bits!");
+        if (!b) {
+            return saturate(a ? ~static_cast<uint64_t>(0) : 0, a < 0);
+        }
+        const bool negative = (a < 0) != (b < 0);
+        const uint64_t ua = magnitude(a), ub = magnitude(b);
+
+        // 128 / 64 bit long division of (ua << F) by ub
+        uint64_t rem = ua >> (64 - F);
+        const uint64_t lo = ua << F;
+        if (rem >= ub) {
+            return saturate(~static_cast<uint64_t>(0), negative);
+        }
+
+        uint64_t q = 0;
+        for (int32_t i = 63; i >= 0; --i) {
+            const bool carry = rem >> 63;
+            rem = (rem << 1) | ((lo >> i) & 1);
+            if (carry || rem >= ub) {
+                rem -= ub;
+                q |= static_cast<uint64_t>(1) << i;
+            }
+        }
+
+        if (rem >= ub - rem) {  // rounding
+            if (!++q) {
+                return saturate(~static_cast<uint64_t>(0), negative);
+            }
+        }
+        return saturate(q, negative);
+    }
+};
+
+} // namespace detail
+
+/* @brief Fixed-point number with saturating arithmetic - for targets without FPU.
+ * Results that do not fit into the range of the type are saturated to the minimum or maximum value,
+ * multiplications and divisions are rounded to nearest.
+ * Conversion from floating point values is implicit (and computed at compile time for constants), conversion back is explicit.
+ * @tparam T The raw signed integer type (int32_t or int64_t).
+ * @tparam frac_bits_ Number of fractional bits.
+ **/
+template <typename T, uint32_t frac_bits_>
+class fixed_point {
+public:
+    static_assert(std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value, "Raw type must be int32_t or int64_t!");
+    static_assert(frac_bits_ > 0 && frac_bits_ < sizeof(T) * 8 - 1, "Invalid number of fractional bits!");
+
+    typedef T raw_type;                                             // The raw type.
+    static constexpr uint32_t FRAC_BITS = frac_bits_;               // Number of fractional bits.
+    static constexpr uint32_t INT_BITS = sizeof(T) * 8 - 1 - frac_bits_;   // Number of integer bits (excluding sign).
+
+    /* @brief Default constructor - sets value to 0.
+     **/
+    constexpr fixed_point() : raw_(0) {}
+
+    /* @brief Constructor - converts floating point value, saturates if out of range.
+     * @param value The value.
+     **/
+    template <typename V, typename std::enable_if<std::is_floating_point<V>::value, int>::type = 0>
+    constexpr fixed_point(V value) : raw_(fromFloat(value * static_cast<V>(ONE))) {}
+
+    /* @brief Constructor - converts integer value, saturates if out of range.
+     * @param value The value.
+     **/
+    template <typename V, typename std::enable_if<std::is_integral<V>::value, int>::type = 0>
+    constexpr fixed_point(V value) : raw_(fromInt(static_cast<int64_t>(value))) {}
+
+    /* @brief Constructor - converts fixed-point value of another format, saturates if out of range.
+     * @param other The value.
+     **/
+    template <typename T2, uint32_t frac_bits2>
+    explicit fixed_point(const fixed_point<T2, frac_bits2>& other) : raw_(convert<frac_bits2>(other.raw())) {}
+
+    /* @brief Creates fixed-point value from raw value.
+     * @param raw The raw value.
+     * @returns The fixed-point value.
+     **/
+    static constexpr fixed_point fromRaw(T raw) { return fixed_point(raw, nullptr); }
+
+    static constexpr fixed_point MIN() { return fromRaw(std::numeric_limits<T>::min()); }
+    static constexpr fixed_point MAX() { return fromRaw(std::numeric_limits<T>::max()); }
+
+    /* @brief Gets raw value.
+     * @returns The raw value.
+     **/
+    constexpr T raw() const { return this->raw_; }
+
+    template <typename V, typename std::enable_if<std::is_floating_point<V>::value, int>::type = 0>
+    constexpr explicit operator V() const { return static_cast<V>(this->raw_) * (static_cast<V>(1) / static_cast<V>(ONE)); }
+
+    template <typename V, typename std::enable_if<std::is_integral<V>::value, int>::type = 0>
+    constexpr explicit operator V() const { return static_cast<V>(this->raw_ / ONE); }
+
+    fixed_point operator+(const fixed_point& other) const {
+        T r;
+        return fromRaw(__builtin_add_overflow(this->raw_, other.raw_, &r) ? (other.raw_ > 0 ? MAX_RAW : MIN_RAW) : r);
+    }
+
+    fixed_point operator-(const fixed_point& other) const {
+        T r;
+        return fromRaw(__builtin_sub_overflow(this->raw_, other.raw_, &r) ? (other.raw_ < 0 ? MAX_RAW : MIN_RAW) : r);
+    }
+
+    fixed_point operator-() const {
+        return fromRaw(this->raw_ == MIN_RAW ? MAX_RAW : -this->raw_);
+    }
+
+    fixed_point operator*(const fixed_point& other) const {
+        return fromRaw(detail::fixed_point_ops<T>::template mul<frac_bits_>(this->raw_, other.raw_));
+    }
+
+    fixed_point operator/(const fixed_point& other) const {
+        return fromRaw(detail::fixed_point_ops<T>::template div<frac_bits_>(this->raw_, other.raw_));
+    }
+
+    /* @brief Multiplies value with an integer - does not need the wide multiplication.
+     **/
+    template <typename V, typename std::enable_if<std::is_integral<V>::value, int>::type = 0>
+    fixed_point operator*(V c) const {
+        T r;
+        return fromRaw(__builtin_mul_overflow(this->raw_, c, &r) ? ((this->raw_ < 0) != (c < 0) ? MIN_RAW : MAX_RAW) : r);
+    }
+
+    /* @brief Divides value by an integer, rounds to nearest. The divisor may be wider than the raw value (e.g. int64_t unit ratios).
+     **/
+    template <typename V, typename std::enable_if<std::is_integral<V>::value, int>::type = 0>
+    fixed_point operator/(V c) const {
+        // the magnitudes are divided in an unsigned type that is wide enough for both the raw value and the divisor
+        typedef typename std::make_unsigned<typename std::conditional<(sizeof(V) > sizeof(T)), V, T>::type>::type U;
+        if (c == 0) {
+            return fromRaw(this->raw_ > 0 ? MAX_RAW : this->raw_ < 0 ? MIN_RAW : 0);
+        }
+
+        const bool negative = (this->raw_ < 0) != (c < V(0));
+        const U x = this->raw_ < 0 ? static_cast<U>(0) - static_cast<U>(this->raw_) : static_cast<U>(this->raw_);
+        const U d = c < V(0) ? static_cast<U>(0) - static_cast<U>(c) : static_cast<U>(c);
+
+        // rounds from the remainder - adding c / 2 to the raw value before the division could overflow
+        const U r = x % d;
+        const U q = x / d + (r >= d - r ? 1 : 0);
+        const U maxRaw = static_cast<U>(MAX_RAW);
+        return fromRaw(negative ? (q > maxRaw ? MIN_RAW : static_cast<T>(-static_cast<T>(q))) : (q > maxRaw ? MAX_RAW : static_cast<T>(q)));
+    }
+
+    template <typename V, typename std::enable_if<std::is_floating_point<V>::value, int>::type = 0>
+    fixed_point operator*(V c) const { return *this * fixed_point(c); }
+
+    template <typename V, typename std::enable_if<std::is_floating_point<V>::value, int>::type = 0>
+    fixed_point operator/(V c) const { return *this / fixed_point(c); }
+
+    template <typename V> fixed_point& operator+=(const V& other) { return *this = *this + other; }
+    template <typename V> fixed_point& operator-=(const V& other) { return *this = *this - other; }
+    template <typename V> fixed_point& operator*=(const V& other) { return *this = *this * other; }
+    template <typename V> fixed_point& operator/=(const V& other) { return *this = *this / other; }
+
+    constexpr bool operator==(const fixed_point& other) const { return this->raw_ == other.raw_; }
+    constexpr bool operator!=(const fixed_point& other) const { return this->raw_ != other.raw_; }
+    constexpr bool operator<(const fixed_point& other) const { return this->raw_ < other.raw_; }
+    constexpr bool operator>(const fixed_point& other) const { return this->raw_ > other.raw_; }
+    constexpr bool operator<=(const fixed_point& other) const { return this->raw_ <= other.raw_; }
+    constexpr bool operator>=(const fixed_point& other) const { return this->raw_ >= other.raw_; }
+
+private:
+    static constexpr T ONE = static_cast<T>(1) << frac_bits_;
+    static constexpr T MAX_RAW = std::numeric_limits<T>::max();
+    static constexpr T MIN_RAW = std::numeric_limits<T>::min();
+
+    constexpr fixed_point(T raw, void*) : raw_(raw) {}
+
+    template <typename V>
+    static constexpr T fromFloat(V scaled) {
+        return scaled != scaled ? 0
+            : scaled >= static_cast<V>(MAX_RAW) ? MAX_RAW
+            : scaled <= static_cast<V>(MIN_RAW) ? MIN_RAW
+            : static_cast<T>(scaled + (scaled >= 0 ? static_cast<V>(0.5) : static_cast<V>(-0.5)));
+    }
+
+    static constexpr T fromInt(int64_t value) {
+        return value > static_cast<int64_t>(MAX_RAW >> frac_bits_) ? MAX_RAW
+            : value < static_cast<int64_t>(MIN_RAW >> frac_bits_) ? MIN_RAW
+            : static_cast<T>(value * ONE);
+    }
+
+    template <uint32_t frac_bits2, typename T2>
+    static T convert(T2 raw) {
+        int64_t r = raw;
+        if (frac_bits2 < frac_bits_) {
+            if (__builtin_mul_overflow(r, static_cast<int64_t>(1) << (frac_bits2 < frac_bits_ ? frac_bits_ - frac_bits2 : 0), &r)) {
+                return raw < 0 ? MIN_RAW : MAX_RAW;
+            }
+        } else if (frac_bits2 > frac_bits_) {
+            const uint32_t shift = frac_bits2 > frac_bits_ ? frac_bits2 - frac_bits_ : 1;
+            r = (r >> shift) + ((r >> (shift - 1)) & 1);   // rounding
+        }
+        return r > MAX_RAW ? MAX_RAW : r < MIN_RAW ? MIN_RAW : static_cast<T>(r);
+    }
+
+    T raw_;     // The raw value.
+};
+
+template <typename T, uint32_t frac_bits_> constexpr uint32_t fixed_point<T, frac_bits_>::FRAC_BITS;
+template <typename T, uint32_t frac_bits_> constexpr uint32_t fixed_point<T, frac_bits_>::INT_BITS;
+template <typename T, uint32_t frac_bits_> constexpr T fixed_point<T, frac_bits_>::ONE;
+template <typename T, uint32_t frac_bits_> constexpr T fixed_point<T, frac_bits_>::MAX_RAW;
+template <typename T, uint32_t frac_bits_> constexpr T fixed_point<T, frac_bits_>::MIN_RAW;
+
+template <typename V, typename T, uint32_t frac_bits_>
+inline typename std::enable_if<std::is_arithmetic<V>::value, fixed_point<T, frac_bits_>>::type operator*(V c, const fixed_point<T, frac_bits_>& value) {
+    return value * c;
+}
+
+typedef fixed_point<int32_t, 16> q16_16_t;  // Q16.16 fixed-point type - range: [-32768, 32768), resolution: 1.5e-5.
+typedef fixed_point<int64_t, 32> q32_32_t;  // Q32.32 fixed-point type - range: [-2^31, 2^31), resolution: 2.3e-10.
+
+} // namespace bcr
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <babocar-core/line_fit.hpp>
+#include <babocar-core/mat.hpp>
+#include <babocar-core/parallel.hpp>
+#include <babocar-core/se2.hpp>
+
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Iterative closest point scan matcher - estimates the rigid transform that aligns a point set to a reference point set.
+ * Correspondences are the nearest reference points, looked up in a uniform grid hash of the reference points (the cell size is 1/8 of the maximum
+ * correspondence distance). The cells are searched in rings around the point until no closer reference point can be found,
+ * and the buckets of the hash are stored contiguously, so a lookup scans a few short ranges of the reference arrays.
+ * Every iteration calculates the transform update in closed form from sums accumulated during the correspondence search:
+ *   - point-to-point: the optimal rotation and translation of the matched pairs (2D Kabsch/Umeyama)
+ *   - point-to-line: one Gauss-Newton step (3x3 normal equations) minimizing the distances from the tangent lines of the reference points
+ * Outliers are rejected by a distance gate, which shrinks to a multiple of the RMS correspondence distance of the previous iteration.
+ * The iteration stops when the update becomes smaller than the given thresholds. Point-to-point usually needs about twice as many iterations
+ * as point-to-line on scans of walls, so point-to-line is the default metric.
+ * The correspondence search of the points can be split among multiple threads, the threads accumulate partial sums.
+ * All storage is fixed-size. Dynamic allocation is only performed by the started threads (see detail::parallel_for) if numThreads > 1.
+ * @tparam maxPoints_ Maximum number of points of the point sets.
+ **/
+template <uint32_t maxPoints_>
+class IcpMatcher {
+public:
+    static constexpr uint32_t MIN_INLIERS = 3;      // Minimum number of correspondences for a transform update.
+
+    enum class Metric : uint8_t {
+        POINT_TO_POINT = 0,     // Minimizes the distances between the matched points.
+        POINT_TO_LINE  = 1      // Minimizes the distances of the points from the tangent lines of the matched reference points.
+    };
+
+    struct Result {
+        uint32_t numInliers;    // Number of correspondences in the last iteration, 0 if the matching failed.
+        uint32_t iterations;    // Number of iterations.
+        meter_t error;          // RMS residual of the correspondences in the last iteration (in the selected metric).
+        bool converged;         // Indicates if the iteration stopped because the update became small enough.
+    };
+
+    /* @brief Constructor - sets matching parameters.
+     * @param maxDist Maximum distance of corresponding points.
+     * @param metric The minimized error metric.
+     * @param maxIterations Maximum number of iterations.
+     * @param outlierFactor Correspondences farther than this multiple of the RMS correspondence distance of the previous iteration are rejected.
+     * @param minStep The iteration stops when the translation of the update is smaller than this value...
+     * @param minRotation ...and the rotation of the update is smaller than this value.
+     **/
+    explicit IcpMatcher(meter_t maxDist, Metric metric = Metric::POINT_TO_LINE, uint32_t maxIterations = 30, float32_t outlierFactor = 3.0f,
+        meter_t minStep = meter_t(1e-4), radian_t minRotation = radian_t(1e-4))
+        : maxDist_(static_cast<float32_t>(maxDist.get()))
+        , invCellSize_(static_cast<float32_t>(CELL_DIVISIONS / maxDist.get()))
+        , metric_(metric)
+        , maxIterations_(maxIterations)
+        , outlierFactor_(outlierFactor)
+        , minStep_(static_cast<float32_t>(minStep.get()))
+        , minRotation_(static_cast<float32_t>(minRotation.get()))
+        , numRef_(0)
+        , numSrc_(0) {}
+
+    /* @brief Sets the reference point set, and builds its grid hash.
+     * For the point-to-line metric, the tangent lines are fitted to the neighbours of the points in the given order -
+     * the points are expected to be ordered along the scan. Points without enough close neighbours are matched point-to-point.
+     * @param points The reference points.
+     * @param numPoints Number of points. Limited by maxPoints_.
+     **/
+    template <typename T>
+    void setReference(const Point2<T> *points, uint32_t numPoints);
+
+    /* @brief Aligns the points to the reference point set.
+     * @param points The points to align.
+     * @param numPoints Number of points. Limited by maxPoints_.
+     * @param transform The transform from the frame of the points to the frame of the reference points - the initial guess is updated in place.
+     * @param numThreads Number of threads (1 means the calling thread only). Limited by detail::MAX_THREADS.
+     * @returns The result of the matching. The transform is not modified if the first iteration does not find enough correspondences.
+     **/
+    template <typename T>
+    Result match(const Point2<T> *points, uint32_t numPoints, SE2f& transform, uint32_t numThreads = 1);
+
+private:
+    static constexpr uint32_t NUM_BUCKETS = next_pow2(2 * maxPoints_);  // Number of hash buckets.
+    static constexpr uint32_t NORMAL_WINDOW = 2;                        // Number of neighbours on each side used for the tangent line fitting.
+    static constexpr uint32_t CELL_DIVISIONS = 8;                       // Ratio of the maximum correspondence distance and the cell size.
+
+    // sums of an iteration, accumulated separately by the threads
+    struct Sums {
+        uint32_t n;                 // Number of correspondences.
+        float64_t dist2;            // Sum of the squared correspondence distances.
+        float64_t res2;             // Sum of the squared residuals in the selected metric.
+        float64_t px, py, qx, qy;   // Point-to-point: sums of the coordinates of the points and the reference points.
+        float64_t sxx, sxy, syx, syy;   // Point-to-point: sums of the products of the point and reference point coordinates.
+        float64_t H[6];             // Point-to-line: lower triangle of the normal matrix (J^T * J).
+        float64_t g[3];             // Point-to-line: J^T * residual.
+    };
+
+    static uint32_t hash(int32_t cx, int32_t cy) {
+        return (static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u) & (NUM_BUCKETS - 1);
+    }
+
+    int32_t cell(float32_t coord) const {
+        return static_cast<int32_t>(std::floor(coord * this->invCellSize_));
+    }
+
+    // finds the correspondences of a range of points, and accumulates their sums
+    void accumulate(const SE2f& transform, float32_t gate2, uint32_t begin, uint32_t end, Sums& sums) const;
+
+    // calculates the transform update from the sums
+    bool solve(const Sums& sums, SE2f& delta) const;
+
+    const float32_t maxDist_;           // Maximum distance of corresponding points [m].
+    const float32_t invCellSize_;       // Inverse of the cell size of the grid hash [1/m].
+    const Metric metric_;               // The minimized error metric.
+    const uint32_t maxIterations_;      // Maximum number of iterations.
+    const float32_t outlierFactor_;     // Distance gate relative to the RMS correspondence distance.
+    const float32_t minStep_;           // Translation threshold of the convergence [m].
+    const float32_t minRotation_;       // Rotation threshold of the convergence [rad].
+
+    uint32_t numRef_;                           // Number of reference points.
+    uint32_t numSrc_;                           // Number of points to align.
+    float32_t refX_[maxPoints_];                // X coordinates of the reference points, ordered by hash bucket [m].
+    float32_t refY_[maxPoints_];                // Y coordinates of the reference points, ordered by hash bucket [m].
+    float32_t refNx_[maxPoints_];               // X coordinates of the tangent line normals, 0 if the point has no tangent line.
+    float32_t refNy_[maxPoints_];               // Y coordinates of the tangent line normals, 0 if the point has no tangent line.
+    uint32_t bucketStart_[NUM_BUCKETS + 1];     // Index of the first reference point of each bucket.
+    uint32_t buckets_[maxPoints_];              // Hash bucket of the reference points in the input order.
+    float32_t srcX_[maxPoints_];                // X coordinates of the points to align [m].
+    float32_t srcY_[maxPoints_];                // Y coordinates of the points to align [m].
+};
+
+template <uint32_t maxPoints_> constexpr uint32_t IcpMatcher<maxPoints_>::MIN_INLIERS;
+template <uint32_t maxPoints_> constexpr uint32_t IcpMatcher<maxPoints_>::NUM_BUCKETS;
+template <uint32_t maxPoints_> constexpr uint32_t IcpMatcher<maxPoints_>::NORMAL_WINDOW;
+template <uint32_t maxPoints_> constexpr uint32_t IcpMatcher<maxPoints_>::CELL_DIVISIONS;
+
+template <uint32_t maxPoints_>
+template <typename T>
+void IcpMatcher<maxPoints_>::setReference(const Point2<T> *points, uint32_t numPoints) {
+    this->numRef_ = bcr::min(numPoints, maxPoints_);
+    const float32_t maxDist2 = this->maxDist_ * this->maxDist_;
+
+    // counting sort by hash bucket - the bucket of each point is stored in the first pass, the positions are the prefix sums of the counts
+    for (uint32_t h = 0; h <= NUM_BUCKETS; ++h) {
+        this->bucketStart_[h] = 0;
+    }
+    for (uint32_t i = 0; i < this->numRef_; ++i) {
+        const float32_t x = static_cast<float32_t>(underlying_value(points[i].X)), y = static_cast<float32_t>(underlying_value(points[i].Y));
+        this->buckets_[i] = hash(this->cell(x), this->cell(y));
+        ++this->bucketStart_[this->buckets_[i] + 1];
+    }
+    for (uint32_t h = 0; h < NUM_BUCKETS; ++h) {
+        this->bucketStart_[h + 1] += this->bucketStart_[h];
+    }
+
+    for (uint32_t i = 0; i < this->numRef_; ++i) {
+        const float32_t x = static_cast<float32_t>(underlying_value(points[i].X)), y = static_cast<float32_t>(underlying_value(points[i].Y));
+        float32_t nx = 0.0f, ny = 0.0f;
+
+        if (this->metric_ == Metric::POINT_TO_LINE) {
+            // tangent line of the neighbours in the scan order, points across gaps (farther than the maximum distance) are not used
+            LineFitAccumulator<float32_t> fit;
+            const uint32_t first = i - bcr::min(i, NORMAL_WINDOW), last = bcr::min(i + NORMAL_WINDOW + 1, this->numRef_);
+            for (uint32_t j = first; j < last; ++j) {
+                const float32_t dx = static_cast<float32_t>(underlying_value(points[j].X)) - x;
+                const float32_t dy = static_cast<float32_t>(underlying_value(points[j].Y)) - y;
+                if (dx * dx + dy * dy <= maxDist2) {
+                    fit.add(Point2f(dx, dy));
+                }
+            }
+            if (fit.size() >= 3) {
+                const Line2<float32_t> line = fit.line();
+                nx = line.a;
+                ny = line.b;
+            }
+        }
+
+        // the start of the bucket is used as its insertion position, and is restored by the shift below
+        const uint32_t idx = this->bucketStart_[this->buckets_[i]]++;
+        this->refX_[idx] = x;
+        this->refY_[idx] = y;
+        this->refNx_[idx] = nx;
+        this->refNy_[idx] = ny;
+    }
+    for (uint32_t h = NUM_BUCKETS; h > 0; --h) {
+        this->bucketStart_[h] = this->bucketStart_[h - 1];
+    }
+    this->bucketStart_[0] = 0;
+}
+
+template <uint32_t maxPoints_>
+template <typename T>
+typename IcpMatcher<maxPoints_>::Result IcpMatcher<maxPoints_>::match(const Point2<T> *points, uint32_t numPoints, SE2f& transform, uint32_t numThreads) {
+    this->numSrc_ = bcr::min(numPoints, maxPoints_);
+    for (uint32_t i = 0; i < this->numSrc_; ++i) {
+        this->srcX_[i] = static_cast<float32_t>(underlying_value(points[i].X));
+        this->srcY_[i] = static_cast<float32_t>(underlying_value(points[i].Y));
+    }
+
+    Result result = { 0, 0, meter_t(0), false };
+    float32_t gate2 = this->maxDist_ * this->maxDist_;
+
+    while (result.iterations < this->maxIterations_ && !result.converged) {
+        Sums sums[detail::MAX_THREADS];
+        const uint32_t usedThreads = detail::parallel_for(this->numSrc_, numThreads, [this, &transform, &sums, gate2](uint32_t begin, uint32_t end, uint32_t t) {
+            this->accumulate(transform, gate2, begin, end, sums[t]);
+        });
+        for (uint32_t t = 1; t < usedThreads; ++t) {
+            sums[0].n += sums[t].n;
+            sums[0].dist2 += sums[t].dist2;
+            sums[0].res2 += sums[t].res2;
+            sums[0].px += sums[t].px;
+            sums[0].py += sums[t].py;
+            sums[0].qx += sums[t].qx;
+            sums[0].qy += sums[t].qy;
+            sums[0].sxx += sums[t].sxx;
+            sums[0].sxy += sums[t].sxy;
+            sums[0].syx += sums[t].syx;
+            sums[0].syy += sums[t].syy;
+            for (uint32_t k = 0; k < 6; ++k) {
+                sums[0].H[k] += sums[t].H[k];
+            }
+            for (uint32_t k = 0; k < 3; ++k) {
+                sums[0].g[k] += sums[t].g[k];
+            }
+        }
+
+        SE2f delta;
+        if (sums[0].n < MIN_INLIERS || !this->solve(sums[0], delta)) {
+            break; // the result of the previous iteration is kept
+        }
+
+        transform = delta.compose(transform);
+        ++result.iterations;
+        result.numInliers = sums[0].n;
+        result.error = meter_t(std::sqrt(sums[0].res2 / sums[0].n));
+        result.converged = std::hypot(delta.translation().X, delta.translation().Y) < this->minStep_ &&
+            std::abs(std::atan2(delta.sin(), delta.cos())) < this->minRotation_;
+
+        const float32_t factor2 = this->outlierFactor_ * this->outlierFactor_;
+        gate2 = bcr::min(gate2, static_cast<float32_t>(factor2 * sums[0].dist2 / sums[0].n));
+    }
+
+    return result;
+}
+
+template <uint32_t maxPoints_>
+void IcpMatcher<maxPoints_>::accumulate(const SE2f& transform, float32_t gate2, uint32_t begin, uint32_t end, Sums& sums) const {
+    sums = Sums();
+    const float32_t cellSize2 = this->maxDist_ * this->maxDist_ / static_cast<float32_t>(CELL_DIVISIONS * CELL_DIVISIONS);
+    const int32_t maxRing = static_cast<int32_t>(std::ceil(std::sqrt(gate2 / cellSize2)));
+    const float32_t c = transform.cos(), s = transform.sin();
+    const float32_t tx = transform.translation().X, ty = transform.translation().Y;
+
+    for (uint32_t i = begin; i < end; ++i) {
+        const float32_t px = c * this->srcX_[i] - s * this->srcY_[i] + tx;
+        const float32_t py = s * this->srcX_[i] + c * this->srcY_[i] + ty;
+        const int32_t cx = this->cell(px), cy = this->cell(py);
+
+        // nearest reference point, searched in square rings of cells around the cell of the point
+        // hash collisions only add candidates, they are filtered by the distance
+        float32_t best = gate2;
+        uint32_t nearest = this->numRef_;
+        auto visit = [this, px, py, &best, &nearest](int32_t nx, int32_t ny) {
+            const uint32_t h = hash(nx, ny);
+            for (uint32_t j = this->bucketStart_[h]; j < this->bucketStart_[h + 1]; ++j) {
+                const float32_t dx = this->refX_[j] - px, dy = this->refY_[j] - py;
+                const float32_t d2 = dx * dx + dy * dy;
+                if (d2 < best) {
+                    best = d2;
+                    nearest = j;
+                }
+            }
+        };
+
+        // the points of ring r + 1 are at least r cells away, the search stops when the best point is closer
+        visit(cx, cy);
+        for (int32_t r = 1; r <= maxRing && best > static_cast<float32_t>((r - 1) * (r - 1)) * cellSize2; ++r) {
+            for (int32_t nx = cx - r; nx <= cx + r; ++nx) {
+                visit(nx, cy - r);
+                visit(nx, cy + r);
+            }
+            for (int32_t ny = cy - r + 1; ny < cy + r; ++ny) {
+                visit(cx - r, ny);
+                visit(cx + r, ny);
+            }
+        }
+        if (nearest == this->numRef_) {
+            continue;
+        }
+
+        const float64_t qx = this->refX_[nearest], qy = this->refY_[nearest];
+        ++sums.n;
+        sums.dist2 += best;
+
+        if (this->metric_ == Metric::POINT_TO_POINT) {
+            sums.res2 += best;
+            sums.px += px;
+            sums.py += py;
+            sums.qx += qx;
+            sums.qy += qy;
+            sums.sxx += px * qx;
+            sums.sxy += px * qy;
+            sums.syx += py * qx;
+            sums.syy += py * qy;
+        } else {
+            // residual rows of the linearized transform: J = [dr/dtx, dr/dty, dr/dangle], the rotation is applied around the origin
+            const float64_t nx = this->refNx_[nearest], ny = this->refNy_[nearest];
+            const float64_t ex = px - qx, ey = py - qy;
+            float64_t J[2][3], r[2];
+            uint32_t rows;
+            if (nx != 0.0 || ny != 0.0) {
+                J[0][0] = nx;
+                J[0][1] = ny;
+                J[0][2] = ny * px - nx * py;
+                r[0] = nx * ex + ny * ey;
+                rows = 1;
+            } else {
+                J[0][0] = 1.0;
+                J[0][1] = 0.0;
+                J[0][2] = -py;
+                r[0] = ex;
+                J[1][0] = 0.0;
+                J[1][1] = 1.0;
+                J[1][2] = px;
+                r[1] = ey;
+                rows = 2;
+            }
+
+            for (uint32_t k = 0; k < rows; ++k) {
+                sums.res2 += r[k] * r[k];
+                sums.H[0] += J[k][0] * J[k][0];
+                sums.H[1] += J[k][1] * J[k][0];
+                sums.H[2] += J[k][1] * J[k][1];
+                sums.H[3] += J[k][2] * J[k][0];
+                sums.H[4] += J[k][2] * J[k][1];
+                sums.H[5] += J[k][2] * J[k][2];
+                sums.g[0] += J[k][0] * r[k];
+                sums.g[1] += J[k][1] * r[k];
+                sums.g[2] += J[k][2] * r[k];
+            }
+        }
+    }
+}
+
+template <uint32_t maxPoints_>
+bool IcpMatcher<maxPoints_>::solve(const Sums& sums, SE2f& delta) const {
+    if (this->metric_ == Metric::POINT_TO_POINT) {
+        // the rotation maximizes the correlation of the centered point sets, the translation moves the rotated centroid to the reference centroid
+        const float64_t n = sums.n;
+        const float64_t mpx = sums.px / n, mpy = sums.py / n, mqx = sums.qx / n, mqy = sums.qy / n;
+        const float64_t sxx = sums.sxx - n * mpx * mqx, sxy = sums.sxy - n * mpx * mqy;
+        const float64_t syx = sums.syx - n * mpy * mqx, syy = sums.syy - n * mpy * mqy;
+        const float64_t angle = std::atan2(sxy - syx, sxx + syy);
+        const float64_t c = std::cos(angle), s = std::sin(angle);
+        delta = SE2f(Point2f(static_cast<float32_t>(mqx - (c * mpx - s * mpy)), static_cast<float32_t>(mqy - (s * mpx + c * mpy))),
+            static_cast<float32_t>(c), static_cast<float32_t>(s));
+        return true;
+    }
+
+    const mat<float64_t, 3, 3> H(
+        sums.H[0], sums.H[1], sums.H[3],
+        sums.H[1], sums.H[2], sums.H[4],
+        sums.H[3], sums.H[4], sums.H[5]);
+    const mat<float64_t, 3, 1> g(-sums.g[0], -sums.g[1], -sums.g[2]);
+    mat<float64_t, 3, 1> x;
+    if (!H.solveCholesky(g, x)) {
+        return false; // degenerate geometry, e.g. a single straight wall
+    }
+    delta = SE2f(Point2f(static_cast<float32_t>(x[0]), static_cast<float32_t>(x[1])), radian_t(x[2]));
+    return true;
+}
+
+} // namespace bcr
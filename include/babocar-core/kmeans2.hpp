@@ -13,6 +13,17 @@ public:
 
     struct Group {
         std::vector<Point2m> members;
+
+        /* @brief Calculates center of the group.
+         * @returns The average of the group members.
+         **/
+        Point2m center() const {
+            Point2m c(meter_t::ZERO(), meter_t::ZERO());
+            for (const Point2m& p : this->members) {
+                c += p;
+            }
+            return c / this->members.size();
+        }
     };
 
     KMeans2(const std::vector<Point2m>& values_)
@@ -47,7 +58,11 @@ public:
                 }
             }
 
+            groups.push_back(std::move(g));
+
         } while(!this->values_.empty());
+
+        return groups;
     }
 
 private:
@@ -55,6 +55,90 @@ std::pair<Point2<T>, Point2<T>> lineCircle_intersection(const Line2<T>& line, co
     return result;
 }
 
+namespace detail {
+
+/* @brief Calculates the parameters of the intersections of a line segment and a circle.
+ * The segment is given as p(t) = p1 + t * d, where t is in the range [0, 1].
+ * The equation |p(t) - center|^2 = r^2 is solved in the form a*t^2 + 2*b*t + c = 0.
+ * @param dx The X coordinate of the segment direction (p2 - p1).
+ * @param dy The Y coordinate of the segment direction (p2 - p1).
+ * @param fx The X coordinate of the segment start relative to the circle center (p1 - center).
+ * @param fy The Y coordinate of the segment start relative to the circle center (p1 - center).
+ * @param r2 The squared radius of the circle.
+ * @param t0 The smaller root (entry into the circle).
+ * @param t1 The larger root (exit from the circle).
+ * @returns Boolean value indicating if the line of the segment intersects the circle (the roots may be outside of the segment).
+ **/
+template <typename T>
+inline bool segmentCircle_params(const T dx, const T dy, const T fx, const T fy, const T r2, T& t0, T& t1) {
+    const uint32_t n = solve_quadratic_stable(dx * dx + dy * dy, 2 * (fx * dx + fy * dy), fx * fx + fy * fy - r2, t1, t0);
+    t0 = n == 2 ? t0 : t1;
+    return n > 0;
+}
+
+} // namespace detail
+
+/* @brief Calculates intersections of a line segment and a circle.
+ * Only the intersections between the endpoints of the segment are returned.
+ * @param p1 The start point of the segment.
+ * @param p2 The end point of the segment.
+ * @param circleCenter The center of the circle.
+ * @param circleRadius The radius of the circle.
+ * @returns The intersections in the order along the segment (from p1 to p2). Missing intersections are NaN.
+ **/
+template <typename T>
+std::pair<Point2<T>, Point2<T>> segmentCircle_intersection(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& circleCenter, const T& circleRadius) {
+    static constexpr T NaN = std::numeric_limits<T>::quiet_NaN();
+    std::pair<Point2<T>, Point2<T>> result = { { NaN, NaN }, { NaN, NaN } };
+
+    const T dx = p2.X - p1.X, dy = p2.Y - p1.Y;
+    T t0, t1;
+    if (detail::segmentCircle_params(dx, dy, p1.X - circleCenter.X, p1.Y - circleCenter.Y, circleRadius * circleRadius, t0, t1)) {
+        Point2<T> *next = &result.first;
+        if (t0 >= T(0) && t0 <= T(1)) {
+            *next++ = { p1.X + t0 * dx, p1.Y + t0 * dy };
+        }
+        if (t1 >= T(0) && t1 <= T(1) && t1 != t0) {
+            *next = { p1.X + t1 * dx, p1.Y + t1 * dy };
+        }
+    }
+    return result;
+}
+
+/* @brief Calculates the exit points of a circle for all segments of a polyline (structure of arrays).
+ * The exit point of a segment is where the segment leaves the circle (the intersection farther along the segment),
+ * which is the lookahead point of pure pursuit if the circle is centered at the vehicle.
+ * The loop is branch-free, so it can be vectorized by the compiler, if -fno-math-errno and -fno-trapping-math are set
+ * (otherwise std::sqrt, and the divisions of the unused root, are moved into branches).
+ * @param x The X coordinates of the polyline points.
+ * @param y The Y coordinates of the polyline points.
+ * @param numPoints Number of polyline points - the number of segments is numPoints - 1.
+ * @param circleCenter The center of the circle.
+ * @param circleRadius The radius of the circle.
+ * @param t The segment parameters of the exit points, in the range [0, 1] - NaN if the segment does not leave the circle.
+ *          Must have space for numPoints - 1 values.
+ * @returns Number of segments that leave the circle.
+ **/
+template <typename T>
+uint32_t segmentCircle_exit(const T *x, const T *y, uint32_t numPoints, const Point2<T>& circleCenter, const T& circleRadius, T *t) {
+    const T cx = circleCenter.X, cy = circleCenter.Y, r2 = circleRadius * circleRadius;
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i + 1 < numPoints; ++i) {
+        const T dx = x[i + 1] - x[i], dy = y[i + 1] - y[i];
+        const T fx = x[i] - cx, fy = y[i] - cy;
+
+        // the first root is the larger one (the exit point) - it is NaN if there are no roots, which makes the comparisons false
+        T te, t0;
+        detail::solve_quadratic_stable(dx * dx + dy * dy, 2 * (fx * dx + fy * dy), fx * fx + fy * fy - r2, te, t0);
+
+        const T result = (te >= T(0)) & (te <= T(1)) ? te : std::numeric_limits<T>::quiet_NaN();
+        t[i] = result;
+        count += result == result ? 1 : 0;     // false for NaN
+    }
+    return count;
+}
+
 template <typename T>
 Point2<T> lineLine_intersection(const Line2<T>& line1, const Line2<T>& line2) {
     Point2<T> intersection = { std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
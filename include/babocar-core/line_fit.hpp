@@ -0,0 +1,132 @@
+#pragma once
+
+#include <babocar-core/line2.hpp>
+
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Incremental total least squares line fitting.
+ * Keeps the running centroid and the second central moments of the points (Welford's method),
+ * so points can be added and removed in O(1), and the best-fit line is available at any time.
+ * Moments are stored in double precision relative to the centroid, which keeps them stable over long runs.
+ * @tparam T Numeric type of the coordinates - arithmetic type or unit class (e.g. meter_t).
+ **/
+template <typename T>
+class LineFitAccumulator {
+public:
+    typedef decltype(underlying_value(std::declval<T>())) value_type;   // Underlying value type of the coordinates.
+
+    /* @brief Default constructor - initializes empty accumulator.
+     **/
+    LineFitAccumulator() {
+        this->clear();
+    }
+
+    /* @brief Removes all points.
+     **/
+    void clear() {
+        this->n_ = 0;
+        this->mx_ = this->my_ = 0.0;
+        this->sxx_ = this->syy_ = this->sxy_ = 0.0;
+    }
+
+    /* @brief Adds point.
+     * @param p The point to add.
+     **/
+    void add(const Point2<T>& p) {
+        const float64_t x = underlying_value(p.X), y = underlying_value(p.Y);
+        const float64_t dx = x - this->mx_, dy = y - this->my_;
+        ++this->n_;
+        this->mx_ += dx / this->n_;
+        this->my_ += dy / this->n_;
+        this->sxx_ += dx * (x - this->mx_);
+        this->syy_ += dy * (y - this->my_);
+        this->sxy_ += dx * (y - this->my_);
+    }
+
+    /* @brief Removes point that has previously been added.
+     * @param p The point to remove.
+     **/
+    void remove(const Point2<T>& p) {
+        if (this->n_ <= 1) {
+            this->clear();
+            return;
+        }
+
+        const float64_t x = underlying_value(p.X), y = underlying_value(p.Y);
+        const float64_t dx = x - this->mx_, dy = y - this->my_;
+        --this->n_;
+        this->mx_ -= dx / this->n_;
+        this->my_ -= dy / this->n_;
+        this->sxx_ = bcr::max(this->sxx_ - dx * (x - this->mx_), 0.0);
+        this->syy_ = bcr::max(this->syy_ - dy * (y - this->my_), 0.0);
+        this->sxy_ -= dx * (y - this->my_);
+    }
+
+    /* @brief Adds all points of another accumulator (parallel formula of Chan et al.).
+     * @param other The other accumulator.
+     **/
+    void add(const LineFitAccumulator& other) {
+        if (!other.n_) {
+            return;
+        }
+
+        const uint32_t n = this->n_ + other.n_;
+        const float64_t dx = other.mx_ - this->mx_, dy = other.my_ - this->my_;
+        const float64_t w = static_cast<float64_t>(this->n_) * other.n_ / n;
+        this->mx_ += dx * other.n_ / n;
+        this->my_ += dy * other.n_ / n;
+        this->sxx_ += other.sxx_ + dx * dx * w;
+        this->syy_ += other.syy_ + dy * dy * w;
+        this->sxy_ += other.sxy_ + dx * dy * w;
+        this->n_ = n;
+    }
+
+    /* @brief Gets number of points.
+     * @returns The number of points.
+     **/
+    uint32_t size() const { return this->n_; }
+
+    /* @brief Gets centroid of the points.
+     * @returns The centroid of the points.
+     **/
+    Point2<T> centroid() const {
+        return Point2<T>(from_underlying<T>(this->mx_), from_underlying<T>(this->my_));
+    }
+
+    /* @brief Gets best-fit line, minimizing the sum of the squared perpendicular distances of the points.
+     * @restrict At least 2 distinct points are needed.
+     * @returns The best-fit line, in the underlying unit of the coordinates.
+     **/
+    Line2<value_type> line() const {
+        // the line normal is the eigenvector of the smaller eigenvalue of the covariance matrix
+        const float64_t lambda = this->minEigenvalue();
+        float64_t a = this->sxy_, b = lambda - this->sxx_;
+        const float64_t a2 = lambda - this->syy_, b2 = this->sxy_;
+        if (a2 * a2 + b2 * b2 > a * a + b * b) {
+            a = a2;
+            b = b2;
+        }
+        return Line2<value_type>(static_cast<value_type>(a), static_cast<value_type>(b), static_cast<value_type>(-(a * this->mx_ + b * this->my_)));
+    }
+
+    /* @brief Gets root mean square perpendicular distance of the points from the best-fit line.
+     * @returns The residual.
+     **/
+    T residual() const {
+        return from_underlying<T>(this->n_ ? std::sqrt(this->minEigenvalue() / this->n_) : 0.0);
+    }
+
+private:
+    float64_t minEigenvalue() const {
+        const float64_t h = (this->sxx_ - this->syy_) / 2;
+        return bcr::max((this->sxx_ + this->syy_) / 2 - std::sqrt(h * h + this->sxy_ * this->sxy_), 0.0);
+    }
+
+    uint32_t n_;                    // Number of points.
+    float64_t mx_, my_;             // Centroid.
+    float64_t sxx_, syy_, sxy_;     // Sums of squared deviations from the centroid.
+};
+
+} // namespace bcr
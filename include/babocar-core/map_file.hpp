@@ -0,0 +1,146 @@
+#pragma once
+
+#include <babocar-core/point2.hpp>
+
+#include <cstddef>
+
+namespace bcr {
+
+/* @brief Header of the binary map files (version 1). All values are little-endian.
+ * The files are used in place (memory-mapped), without conversion, so the library only supports little-endian hosts (checked at compile time).
+ * The file layout is: header, tile index, tile data, path points - every section starts at a page (4096 byte) boundary.
+ * The tiles are stored in the layout of OccupancyGrid: square tiles of 2^tileBits x 2^tileBits 16-bit fixed-point log-odds values
+ * (see OccupancyGrid::LOG_ODDS_SCALE), row-major inside the tile. The tile index is a dense row-major array over the bounding box of the stored tiles,
+ * it contains the number of the tile in the data section, or MapFileHeader::NO_TILE for tiles that are not stored (unknown).
+ * The path points are stored as pairs of 64-bit floating point coordinates in meters - the layout of Point2m.
+ **/
+struct MapFileHeader {
+    static constexpr uint32_t VERSION = 1;              // The current version of the file format.
+    static constexpr uint32_t NO_TILE = 0xffffffffu;    // Tile index value of the tiles that are not stored.
+    static constexpr uint64_t ALIGNMENT = 4096;         // Alignment of the sections.
+
+    char magic[8];              // File identifier: "BCRMAP\0\0".
+    uint32_t version;           // Version of the file format.
+    uint32_t headerSize;        // Size of the header in bytes.
+    float64_t resolution;       // Side length of the cells in meters.
+    uint32_t tileBits;          // Base 2 logarithm of the number of cells along the sides of a tile.
+    int32_t originX;            // X coordinate of the lower-left tile of the bounding box (in tiles).
+    int32_t originY;            // Y coordinate of the lower-left tile of the bounding box (in tiles).
+    uint32_t width;             // Width of the bounding box (in tiles).
+    uint32_t height;            // Height of the bounding box (in tiles).
+    uint32_t numTiles;          // Number of stored tiles.
+    uint64_t indexOffset;       // Offset of the tile index in bytes.
+    uint64_t tilesOffset;       // Offset of the tile data in bytes.
+    uint64_t pathOffset;        // Offset of the path points in bytes.
+    uint32_t pathSize;          // Number of path points.
+    uint32_t reserved;          // Reserved, must be 0.
+    uint64_t fileSize;          // Size of the file in bytes.
+};
+
+/* @brief Read-only memory-mapped binary map file.
+ * Opening the file only maps it to the address space and validates the header - the tiles and the path points are used in place,
+ * and the operating system loads the pages on first touch, so the startup time does not depend on the size of the map.
+ * The tiles are aligned, a tile never spans multiple pages.
+ **/
+class MapFile {
+public:
+    /* @brief Default constructor - creates a closed map file.
+     **/
+    MapFile();
+
+    /* @brief Destructor - unmaps the file.
+     **/
+    ~MapFile();
+
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    /* @brief Opens and maps a map file. The previously opened file is closed.
+     * @param fileName The name of the map file.
+     * @returns Status::ERROR if the file cannot be opened or mapped, Status::INVALID_DATA if the header (including the reserved field)
+     * or the section sizes are invalid.
+     **/
+    Status open(const char *fileName);
+
+    /* @brief Unmaps the file.
+     **/
+    void close();
+
+    /* @brief Checks if a file is open.
+     * @returns Boolean value indicating if a file is open.
+     **/
+    bool isOpen() const { return this->header_ != nullptr; }
+
+    /* @brief Gets the side length of the cells.
+     * @returns The resolution.
+     **/
+    meter_t resolution() const { return meter_t(this->header_->resolution); }
+
+    /* @brief Gets the base 2 logarithm of the number of cells along the sides of a tile.
+     * @returns The tile bits.
+     **/
+    uint32_t tileBits() const { return this->header_->tileBits; }
+
+    /* @brief Gets the number of stored tiles.
+     * @returns The number of stored tiles.
+     **/
+    uint32_t numTiles() const { return this->header_->numTiles; }
+
+    /* @brief Gets the cells of a tile.
+     * @param tx The X coordinate of the tile (in tiles).
+     * @param ty The Y coordinate of the tile (in tiles).
+     * @returns The fixed-point log-odds of the cells of the tile, or nullptr if the tile is not stored.
+     **/
+    const int16_t* tile(int32_t tx, int32_t ty) const {
+        const uint32_t ix = static_cast<uint32_t>(tx - this->header_->originX), iy = static_cast<uint32_t>(ty - this->header_->originY);
+        if (ix >= this->header_->width || iy >= this->header_->height) {
+            return nullptr;
+        }
+        const uint32_t idx = this->index_[iy * this->header_->width + ix];
+        return idx != MapFileHeader::NO_TILE ? this->tiles_ + (static_cast<size_t>(idx) << (2 * this->header_->tileBits)) : nullptr;
+    }
+
+    /* @brief Gets the fixed-point log-odds of a cell.
+     * @param c The global cell coordinates.
+     * @returns The fixed-point log-odds of the cell, 0 for cells in tiles that are not stored.
+     **/
+    int16_t cell(const Point2i& c) const {
+        const uint32_t bits = this->header_->tileBits, mask = (1u << bits) - 1;
+        const int16_t *t = this->tile(c.X >> bits, c.Y >> bits);
+        return t ? t[(static_cast<uint32_t>(c.X) & mask) + ((static_cast<uint32_t>(c.Y) & mask) << bits)] : 0;
+    }
+
+    /* @brief Gets the path points.
+     * @returns The path points.
+     **/
+    const Point2m* path() const { return this->path_; }
+
+    /* @brief Gets the number of path points.
+     * @returns The number of path points.
+     **/
+    uint32_t pathSize() const { return this->header_->pathSize; }
+
+private:
+    void *data_;                    // The mapped file.
+    size_t size_;                   // Size of the mapped file in bytes.
+    const MapFileHeader *header_;   // The file header.
+    const uint32_t *index_;         // The tile index.
+    const int16_t *tiles_;          // The tile data.
+    const Point2m *path_;           // The path points.
+};
+
+/* @brief Writes a binary map file.
+ * @param fileName The name of the map file.
+ * @param resolution Side length of the cells.
+ * @param tileBits Base 2 logarithm of the number of cells along the sides of a tile.
+ * @param keys The coordinates of the tiles (in tiles).
+ * @param tiles The fixed-point log-odds of the cells of the tiles.
+ * @param numTiles Number of tiles.
+ * @param path The path points - optional.
+ * @param pathSize Number of path points.
+ * @returns Status::ERROR if the file cannot be written, Status::INVALID_DATA if the tile bits are invalid or a tile is given multiple times.
+ **/
+Status writeMapFile(const char *fileName, meter_t resolution, uint32_t tileBits, const Point2i *keys, const int16_t *const *tiles, uint32_t numTiles,
+    const Point2m *path = nullptr, uint32_t pathSize = 0);
+
+} // namespace bcr
@@ -0,0 +1,459 @@
+#pragma once
+
+#include <babocar-core/point2.hpp>
+
+#include <cstring>
+
+namespace bcr {
+
+template <typename T, uint32_t R, uint32_t C>
+class mat;
+
+namespace detail {
+
+/* @brief Gets alignment of the matrix storage - 16 bytes if the size of the storage is a multiple of 16 bytes (for the SIMD kernels).
+ **/
+template <typename T, uint32_t R, uint32_t C>
+constexpr size_t mat_alignment() {
+    return (R * C * sizeof(T)) % 16 == 0 ? 16 : alignof(T);
+}
+
+/* @brief 4-element SIMD vector type (GCC vector extension) - compiled to SSE/AVX on x86 and NEON on ARM,
+ * or split into scalar operations where the target has no matching vector registers.
+ **/
+template <typename T>
+struct simd4 {
+    typedef T type __attribute__((vector_size(4 * sizeof(T))));
+};
+
+// vectors are passed by reference, returning 32-byte vectors by value changes the ABI depending on AVX support
+template <typename T>
+inline void simd4_load(const T *p, typename simd4<T>::type& v) {
+    std::memcpy(&v, p, sizeof(v));
+}
+
+template <typename T>
+inline void simd4_store(T *p, const typename simd4<T>::type& v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+/* @brief Matrix multiplication kernel: result (R x C) = a (R x K) * b (K x C), all row-major.
+ * The generic kernel has compile-time loop bounds, so the compiler unrolls it for small matrices.
+ **/
+template <typename T, uint32_t R, uint32_t K, uint32_t C>
+struct mat_multiply {
+    static void apply(const T *a, const T *b, T *result) {
+        for (uint32_t i = 0; i < R; ++i) {
+            T row[C] = {};
+            for (uint32_t k = 0; k < K; ++k) {
+                const T aik = a[i * K + k];
+                for (uint32_t j = 0; j < C; ++j) {
+                    row[j] += aik * b[k * C + j];
+                }
+            }
+            for (uint32_t j = 0; j < C; ++j) {
+                result[i * C + j] = row[j];
+            }
+        }
+    }
+};
+
+/* @brief 2x2 kernel - the whole matrix is one SIMD vector: [a0 a1 a2 a3] * [b0 b1 b2 b3] = [a0 a0 a2 a2] * [b0 b1 b0 b1] + [a1 a1 a3 a3] * [b2 b3 b2 b3]
+ * The shuffles need __builtin_shuffle, which is only available in GCC - other compilers use the same products written out as scalars.
+ **/
+template <typename T>
+struct mat_multiply<T, 2, 2, 2> {
+    static void apply(const T *a, const T *b, T *result) {
+#if defined(__GNUC__) && !defined(__clang__)
+        typedef typename simd4<T>::type v4;
+        typedef decltype(std::declval<v4>() < std::declval<v4>()) mask;    // integer vector with the same element size
+        v4 va, vb;
+        simd4_load(a, va);
+        simd4_load(b, vb);
+        const v4 r = __builtin_shuffle(va, mask{ 0, 0, 2, 2 }) * __builtin_shuffle(vb, mask{ 0, 1, 0, 1 })
+            + __builtin_shuffle(va, mask{ 1, 1, 3, 3 }) * __builtin_shuffle(vb, mask{ 2, 3, 2, 3 });
+        simd4_store(result, r);
+#else
+        const T a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+        const T b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+        result[0] = a0 * b0 + a1 * b2;
+        result[1] = a0 * b1 + a1 * b3;
+        result[2] = a2 * b0 + a3 * b2;
+        result[3] = a2 * b1 + a3 * b3;
+#endif
+    }
+};
+
+/* @brief 3x3 kernel - rows of 3 elements cannot be loaded as SIMD vectors without reading past the end of the storage,
+ * so the products are written out explicitly (scalar, but without loops and temporary row buffers).
+ **/
+template <typename T>
+struct mat_multiply<T, 3, 3, 3> {
+    static void apply(const T *a, const T *b, T *result) {
+        const T b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4], b5 = b[5], b6 = b[6], b7 = b[7], b8 = b[8];
+        for (uint32_t i = 0; i < 3; ++i) {
+            const T a0 = a[3 * i], a1 = a[3 * i + 1], a2 = a[3 * i + 2];
+            result[3 * i]     = a0 * b0 + a1 * b3 + a2 * b6;
+            result[3 * i + 1] = a0 * b1 + a1 * b4 + a2 * b7;
+            result[3 * i + 2] = a0 * b2 + a1 * b5 + a2 * b8;
+        }
+    }
+};
+
+/* @brief 4x4 kernel - every row of the result is a linear combination of the rows of b, which are SIMD vectors.
+ **/
+template <typename T>
+struct mat_multiply<T, 4, 4, 4> {
+    static void apply(const T *a, const T *b, T *result) {
+        typedef typename simd4<T>::type v4;
+        v4 b0, b1, b2, b3;
+        simd4_load(b, b0);
+        simd4_load(b + 4, b1);
+        simd4_load(b + 8, b2);
+        simd4_load(b + 12, b3);
+        for (uint32_t i = 0; i < 4; ++i) {
+            const T *ai = a + 4 * i;
+            simd4_store(result + 4 * i, ai[0] * b0 + ai[1] * b1 + ai[2] * b2 + ai[3] * b3);
+        }
+    }
+};
+
+} // namespace detail
+
+/* @brief Fixed-size matrix with stack storage (row-major), for state estimation and other small linear algebra problems.
+ * All dimensions are compile-time constants, so the loops of the operations are unrolled by the compiler,
+ * and the multiplication of 2x2 and 4x4 matrices uses SIMD kernels (GCC vector extensions - the 2x2 kernel is scalar on other compilers).
+ * Construction and element access are constexpr.
+ * @tparam T Numeric type of the elements (arithmetic type).
+ * @tparam R Number of rows.
+ * @tparam C Number of columns.
+ **/
+template <typename T, uint32_t R, uint32_t C>
+class mat {
+public:
+    static_assert(std::is_arithmetic<T>::value, "Matrix elements must be of arithmetic type!");
+    static_assert(R > 0 && C > 0, "Matrix must not be empty!");
+
+    typedef T value_type;
+
+    static constexpr uint32_t ROWS = R;     // Number of rows.
+    static constexpr uint32_t COLS = C;     // Number of columns.
+
+    /* @brief Default constructor - sets all elements to zero.
+     **/
+    constexpr mat() : data_() {}
+
+    /* @brief Constructor - sets elements in row-major order. Missing elements are set to zero.
+     * @param first The first element.
+     * @param rest The rest of the elements.
+     **/
+    template <typename... Args>
+    constexpr explicit mat(T first, Args... rest) : data_{ first, static_cast<T>(rest)... } {
+        static_assert(sizeof...(Args) < R * C, "Too many elements!");
+    }
+
+    /* @brief Constructor - creates column vector from point.
+     * @restrict Matrix must be 2x1.
+     * @param p The point - arithmetic or unit point (units are converted to their underlying value).
+     **/
+    template <typename P, uint32_t R_ = R, uint32_t C_ = C, typename std::enable_if<R_ == 2 && C_ == 1, int>::type = 0>
+    explicit mat(const Point2<P>& p)
+        : data_{ static_cast<T>(underlying_value(p.X)), static_cast<T>(underlying_value(p.Y)) } {}
+
+    /* @brief Creates identity matrix.
+     * @returns The identity matrix.
+     **/
+    static mat identity() {
+        static_assert(R == C, "Identity matrix must be square!");
+        mat result;
+        for (uint32_t i = 0; i < R; ++i) {
+            result(i, i) = T(1);
+        }
+        return result;
+    }
+
+    /* @brief Creates diagonal matrix.
+     * @param diag The diagonal elements.
+     * @returns The diagonal matrix.
+     **/
+    static mat diagonal(const mat<T, R, 1>& diag) {
+        static_assert(R == C, "Diagonal matrix must be square!");
+        mat result;
+        for (uint32_t i = 0; i < R; ++i) {
+            result(i, i) = diag[i];
+        }
+        return result;
+    }
+
+    T& operator()(uint32_t row, uint32_t col) { return this->data_[row * C + col]; }
+    constexpr const T& operator()(uint32_t row, uint32_t col) const { return this->data_[row * C + col]; }
+
+    /* @brief Gets element by its linear (row-major) index - for vectors.
+     **/
+    T& operator[](uint32_t i) { return this->data_[i]; }
+    constexpr const T& operator[](uint32_t i) const { return this->data_[i]; }
+
+    T* data() { return this->data_; }
+    const T* data() const { return this->data_; }
+
+    /* @brief Converts column vector to point.
+     * @restrict Matrix must be 2x1.
+     * @returns The point - arithmetic or unit point (the elements are the underlying values of the units).
+     **/
+    template <typename P = T>
+    Point2<P> toPoint() const {
+        static_assert(R == 2 && C == 1, "Only 2x1 matrices can be converted to points!");
+        return Point2<P>(from_underlying<P>(this->data_[0]), from_underlying<P>(this->data_[1]));
+    }
+
+    /* @brief Calculates transpose of the matrix.
+     * @returns The transpose.
+     **/
+    mat<T, C, R> transpose() const {
+        mat<T, C, R> result;
+        for (uint32_t i = 0; i < R; ++i) {
+            for (uint32_t j = 0; j < C; ++j) {
+                result(j, i) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    mat operator-() const {
+        mat result;
+        for (uint32_t i = 0; i < R * C; ++i) {
+            result.data_[i] = -this->data_[i];
+        }
+        return result;
+    }
+
+    mat& operator+=(const mat& other) {
+        for (uint32_t i = 0; i < R * C; ++i) {
+            this->data_[i] += other.data_[i];
+        }
+        return *this;
+    }
+
+    mat& operator-=(const mat& other) {
+        for (uint32_t i = 0; i < R * C; ++i) {
+            this->data_[i] -= other.data_[i];
+        }
+        return *this;
+    }
+
+    mat& operator*=(T c) {
+        for (uint32_t i = 0; i < R * C; ++i) {
+            this->data_[i] *= c;
+        }
+        return *this;
+    }
+
+    mat operator+(const mat& other) const { mat result(*this); return result += other; }
+    mat operator-(const mat& other) const { mat result(*this); return result -= other; }
+    mat operator*(T c) const { mat result(*this); return result *= c; }
+    mat operator/(T c) const { mat result(*this); return result *= (T(1) / c); }
+
+    /* @brief Multiplies matrices.
+     * @param other The other matrix.
+     * @returns The product.
+     **/
+    template <uint32_t C2>
+    mat<T, R, C2> operator*(const mat<T, C, C2>& other) const {
+        mat<T, R, C2> result;
+        detail::mat_multiply<T, R, C, C2>::apply(this->data_, other.data(), result.data());
+        return result;
+    }
+
+    /* @brief Multiplies 2x2 matrix with point (as column vector).
+     * @param p The point.
+     * @returns The product as point.
+     **/
+    Point2<T> operator*(const Point2<T>& p) const {
+        static_assert(R == 2 && C == 2, "Only 2x2 matrices can be multiplied with points!");
+        return Point2<T>(this->data_[0] * p.X + this->data_[1] * p.Y, this->data_[2] * p.X + this->data_[3] * p.Y);
+    }
+
+    bool operator==(const mat& other) const {
+        for (uint32_t i = 0; i < R * C; ++i) {
+            if (this->data_[i] != other.data_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const mat& other) const {
+        return !(*this == other);
+    }
+
+    /* @brief Calculates Cholesky decomposition: this = L * L^T
+     * @restrict Matrix must be symmetric - only the lower triangle is used.
+     * @param L The lower triangular factor (the upper triangle is set to zero).
+     * @returns Boolean value indicating if the decomposition succeeded (false if the matrix is not positive definite).
+     **/
+    bool cholesky(mat& L) const;
+
+    /* @brief Calculates LDL^T decomposition: this = L * D * L^T
+     * Does not need square roots, and works for indefinite (but non-singular) matrices as well.
+     * @restrict Matrix must be symmetric - only the lower triangle is used.
+     * @param L The unit lower triangular factor (the upper triangle is set to zero).
+     * @param D The diagonal.
+     * @returns Boolean value indicating if the decomposition succeeded (false if a diagonal element is zero).
+     **/
+    bool ldlt(mat& L, mat<T, R, 1>& D) const;
+
+    /* @brief Solves linear equation system this * x = b using Cholesky decomposition.
+     * @restrict Matrix must be symmetric positive definite.
+     * @param b The right-hand side (one or more columns).
+     * @param x The solution.
+     * @returns Boolean value indicating if the system has been solved (false if the matrix is not positive definite).
+     **/
+    template <uint32_t C2>
+    bool solveCholesky(const mat<T, R, C2>& b, mat<T, R, C2>& x) const;
+
+    /* @brief Solves linear equation system this * x = b using LDL^T decomposition.
+     * @restrict Matrix must be symmetric.
+     * @param b The right-hand side (one or more columns).
+     * @param x The solution.
+     * @returns Boolean value indicating if the system has been solved (false if the decomposition failed).
+     **/
+    template <uint32_t C2>
+    bool solveLdlt(const mat<T, R, C2>& b, mat<T, R, C2>& x) const;
+
+private:
+    alignas(detail::mat_alignment<T, R, C>()) T data_[R * C];     // The elements in row-major order.
+};
+
+template <typename T, uint32_t R, uint32_t C> constexpr uint32_t mat<T, R, C>::ROWS;
+template <typename T, uint32_t R, uint32_t C> constexpr uint32_t mat<T, R, C>::COLS;
+
+template <typename T, uint32_t R, uint32_t C>
+mat<T, R, C> operator*(T c, const mat<T, R, C>& m) {
+    return m * c;
+}
+
+template <typename T, uint32_t R, uint32_t C>
+bool mat<T, R, C>::cholesky(mat& L) const {
+    static_assert(R == C, "Cholesky decomposition needs square matrix!");
+
+    L = mat();
+    for (uint32_t j = 0; j < R; ++j) {
+        T d = (*this)(j, j);
+        for (uint32_t k = 0; k < j; ++k) {
+            d -= L(j, k) * L(j, k);
+        }
+        if (!(d > T(0))) {
+            return false;
+        }
+        const T ljj = std::sqrt(d);
+        const T inv = T(1) / ljj;
+        L(j, j) = ljj;
+
+        for (uint32_t i = j + 1; i < R; ++i) {
+            T s = (*this)(i, j);
+            for (uint32_t k = 0; k < j; ++k) {
+                s -= L(i, k) * L(j, k);
+            }
+            L(i, j) = s * inv;
+        }
+    }
+    return true;
+}
+
+template <typename T, uint32_t R, uint32_t C>
+bool mat<T, R, C>::ldlt(mat& L, mat<T, R, 1>& D) const {
+    static_assert(R == C, "LDL^T decomposition needs square matrix!");
+
+    L = mat::identity();
+    for (uint32_t j = 0; j < R; ++j) {
+        T d = (*this)(j, j);
+        for (uint32_t k = 0; k < j; ++k) {
+            d -= L(j, k) * L(j, k) * D[k];
+        }
+        if (d == T(0)) {
+            return false;
+        }
+        D[j] = d;
+        const T inv = T(1) / d;
+
+        for (uint32_t i = j + 1; i < R; ++i) {
+            T s = (*this)(i, j);
+            for (uint32_t k = 0; k < j; ++k) {
+                s -= L(i, k) * L(j, k) * D[k];
+            }
+            L(i, j) = s * inv;
+        }
+    }
+    return true;
+}
+
+template <typename T, uint32_t R, uint32_t C>
+template <uint32_t C2>
+bool mat<T, R, C>::solveCholesky(const mat<T, R, C2>& b, mat<T, R, C2>& x) const {
+    mat L;
+    if (!this->cholesky(L)) {
+        return false;
+    }
+
+    for (uint32_t c = 0; c < C2; ++c) {
+        // L * y = b
+        for (uint32_t i = 0; i < R; ++i) {
+            T s = b(i, c);
+            for (uint32_t k = 0; k < i; ++k) {
+                s -= L(i, k) * x(k, c);
+            }
+            x(i, c) = s / L(i, i);
+        }
+        // L^T * x = y
+        for (uint32_t i = R; i-- > 0;) {
+            T s = x(i, c);
+            for (uint32_t k = i + 1; k < R; ++k) {
+                s -= L(k, i) * x(k, c);
+            }
+            x(i, c) = s / L(i, i);
+        }
+    }
+    return true;
+}
+
+template <typename T, uint32_t R, uint32_t C>
+template <uint32_t C2>
+bool mat<T, R, C>::solveLdlt(const mat<T, R, C2>& b, mat<T, R, C2>& x) const {
+    mat L;
+    mat<T, R, 1> D;
+    if (!this->ldlt(L, D)) {
+        return false;
+    }
+
+    for (uint32_t c = 0; c < C2; ++c) {
+        // L * z = b, D * y = z
+        for (uint32_t i = 0; i < R; ++i) {
+            T s = b(i, c);
+            for (uint32_t k = 0; k < i; ++k) {
+                s -= L(i, k) * x(k, c);
+            }
+            x(i, c) = s;
+        }
+        for (uint32_t i = 0; i < R; ++i) {
+            x(i, c) /= D[i];
+        }
+        // L^T * x = y
+        for (uint32_t i = R; i-- > 0;) {
+            T s = x(i, c);
+            for (uint32_t k = i + 1; k < R; ++k) {
+                s -= L(k, i) * x(k, c);
+            }
+            x(i, c) = s;
+        }
+    }
+    return true;
+}
+
+typedef mat<float32_t, 2, 2> mat2f;     // 2x2 32-bit floating point matrix.
+typedef mat<float32_t, 3, 3> mat3f;     // 3x3 32-bit floating point matrix.
+typedef mat<float32_t, 4, 4> mat4f;     // 4x4 32-bit floating point matrix.
+typedef mat<float64_t, 2, 2> mat2d;     // 2x2 64-bit floating point matrix.
+typedef mat<float64_t, 3, 3> mat3d;     // 3x3 64-bit floating point matrix.
+typedef mat<float64_t, 4, 4> mat4d;     // 4x4 64-bit floating point matrix.
+
+} // namespace bcr
@@ -263,6 +263,16 @@ inline T powerOf(const T& value, uint32_t pow) {
     return result;
 }
 
+/**
+ * @brief Gets the smallest power of 2 that is greater than or equal to the value.
+ * @param value The value.
+ * @param result The power of 2 to start the search from - 1 by default.
+ * @returns The smallest power of 2 that is greater than or equal to the value.
+ */
+inline constexpr uint32_t next_pow2(uint32_t value, uint32_t result = 1) {
+    return result >= value ? result : next_pow2(value, result << 1);
+}
+
 inline uint32_t add_overflow(uint32_t value, uint32_t incr, uint32_t exclusive_max) {
     value += incr;
     while(value >= exclusive_max) {
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <babocar-core/map_file.hpp>
+#include <babocar-core/point2.hpp>
+#include <babocar-core/unit_utils.hpp>
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace bcr {
+
+/* @brief Rolling-window occupancy grid map, storing the log-odds of the cell occupancy probabilities.
+ * Cells are addressed by their global integer coordinates (the map coordinates divided by the resolution).
+ * The window consists of sizeTiles_ x sizeTiles_ square tiles of 2^tileBits_ x 2^tileBits_ cells, each tile is stored contiguously
+ * (a 16x16 tile of 16-bit log-odds occupies 8 cache lines), so the cells around a ray or a query point share a few cache lines.
+ * The tiles are placed in the window by their global tile coordinates modulo the window size, and every tile stores its global coordinates:
+ * re-centering only moves the window origin, the tiles that get out of the window are cleared lazily when they are reused.
+ * Scans are inserted in two passes - the rays are traced with integer DDA stepping (one cell per step along the major axis) and only mark the touched cells,
+ * then the marked tiles are updated with a branch-free loop, which is vectorized by the compiler.
+ * Every cell is updated at most once per scan, even if multiple rays cross it. No dynamic allocation is performed.
+ * A memory-mapped map file can be set as base map - its tiles are read in place until they are first updated, then copied to the window.
+ * @note The object stores 3 bytes per cell, large grids should be allocated statically or on the heap.
+ * @tparam sizeTiles_ Number of tiles along the sides of the window - must be a power of 2.
+ * @tparam tileBits_ Base 2 logarithm of the number of cells along the sides of a tile.
+ **/
+template <uint32_t sizeTiles_, uint32_t tileBits_ = 4>
+class OccupancyGrid {
+public:
+    static_assert(sizeTiles_ > 0 && (sizeTiles_ & (sizeTiles_ - 1)) == 0, "Number of tiles must be a power of 2!");
+    static_assert(tileBits_ > 0 && tileBits_ < 8, "Invalid tile size!");
+
+    static constexpr uint32_t TILE_SIZE = 1u << tileBits_;              // Number of cells along the sides of a tile.
+    static constexpr uint32_t TILE_CELLS = TILE_SIZE * TILE_SIZE;       // Number of cells in a tile.
+    static constexpr uint32_t NUM_TILES = sizeTiles_ * sizeTiles_;      // Number of tiles in the window.
+    static constexpr uint32_t SIZE = sizeTiles_ * TILE_SIZE;            // Number of cells along the sides of the window.
+    static constexpr float32_t LOG_ODDS_SCALE = 1024.0f;                // Scale of the fixed-point log-odds values.
+
+    /* @brief Constructor - sets resolution and update parameters, and centers the window at the origin.
+     * @param resolution Side length of the cells.
+     * @param hitLogOdds Log-odds increment of the cells at the ends of the rays.
+     * @param missLogOdds Log-odds increment of the cells the rays pass through (negative).
+     * @param minLogOdds Lower limit of the log-odds values - limits the time needed to re-occupy a free cell.
+     * @param maxLogOdds Upper limit of the log-odds values - limits the time needed to clear an occupied cell.
+     **/
+    explicit OccupancyGrid(meter_t resolution, float32_t hitLogOdds = 0.85f, float32_t missLogOdds = -0.4f,
+        float32_t minLogOdds = -2.0f, float32_t maxLogOdds = 3.5f)
+        : resolution_(resolution)
+        , invResolution_(static_cast<float32_t>(1.0 / resolution.get()))
+        , hit_(toFixed(hitLogOdds))
+        , miss_(toFixed(missLogOdds))
+        , min_(toFixed(minLogOdds))
+        , max_(toFixed(maxLogOdds))
+        , map_(nullptr)
+        , numDirty_(0) {
+        this->clear();
+        this->recenter(Point2m(meter_t(0), meter_t(0)));
+    }
+
+    /* @brief Clears all cells (resets them to the base map, or to unknown if there is no base map).
+     **/
+    void clear() {
+        for (uint32_t t = 0; t < NUM_TILES; ++t) {
+            this->tileKeys_[t] = Point2i(INT32_MIN, INT32_MIN);
+            this->dirty_[t] = 0;
+        }
+        std::memset(this->flags_, 0, sizeof(this->flags_));
+        this->numDirty_ = 0;
+    }
+
+    /* @brief Sets the base map - the initial values of the tiles that have not been updated yet.
+     * The base map must stay open while it is used by the grid. Tiles already in the window are not changed.
+     * @param map The base map, or nullptr to use unknown cells as initial values.
+     * @returns Boolean value indicating if the base map has been set (false if its tile size or resolution is different from the grid).
+     **/
+    bool setMap(const MapFile *map) {
+        if (map && (!map->isOpen() || map->tileBits() != tileBits_ || std::abs(map->resolution().get() / this->resolution_.get() - 1.0) > 1e-9)) {
+            return false;
+        }
+        this->map_ = map;
+        return true;
+    }
+
+    /* @brief Lists the tiles in the window that have been updated (or loaded from the base map) - e.g. for writing a map file.
+     * @param keys The coordinates of the tiles (in tiles) - must have space for NUM_TILES tiles.
+     * @param cells The fixed-point log-odds of the cells of the tiles - must have space for NUM_TILES tiles.
+     * @returns Number of tiles.
+     **/
+    uint32_t getTiles(Point2i *keys, const int16_t **cells) const {
+        uint32_t n = 0;
+        for (uint32_t t = 0; t < NUM_TILES; ++t) {
+            const Point2i key = this->tileKeys_[t];
+            if (static_cast<uint32_t>(key.X - this->origin_.X) < sizeTiles_ && static_cast<uint32_t>(key.Y - this->origin_.Y) < sizeTiles_) {
+                keys[n] = key;
+                cells[n++] = this->cells_[t];
+            }
+        }
+        return n;
+    }
+
+    /* @brief Moves the window so that its center is near the given position (the window origin is aligned to the tiles).
+     * Only the window origin is updated - the tiles that get out of the window are treated as unknown, and are cleared when reused.
+     * Pending marks of the tiles outside the new window are dropped by the next update.
+     * @param center The new center of the window.
+     **/
+    void recenter(const Point2m& center) {
+        const Point2i c = this->cell(center);
+        this->origin_ = Point2i((c.X >> tileBits_) - static_cast<int32_t>(sizeTiles_ / 2), (c.Y >> tileBits_) - static_cast<int32_t>(sizeTiles_ / 2));
+    }
+
+    /* @brief Gets the side length of the cells.
+     * @returns The resolution.
+     **/
+    meter_t resolution() const { return this->resolution_; }
+
+    /* @brief Gets the global coordinates of the lower-left cell of the window.
+     * @returns The coordinates of the lower-left cell of the window.
+     **/
+    Point2i originCell() const {
+        return Point2i(this->origin_.X * static_cast<int32_t>(TILE_SIZE), this->origin_.Y * static_cast<int32_t>(TILE_SIZE));
+    }
+
+    /* @brief Gets the lower-left corner of the window.
+     * @returns The lower-left corner of the window.
+     **/
+    Point2m origin() const {
+        return Point2m(this->resolution_ * static_cast<float64_t>(this->origin_.X * static_cast<int32_t>(TILE_SIZE)),
+                       this->resolution_ * static_cast<float64_t>(this->origin_.Y * static_cast<int32_t>(TILE_SIZE)));
+    }
+
+    /* @brief Gets the global coordinates of the cell that contains a position.
+     * @param pos The position.
+     * @returns The cell coordinates.
+     **/
+    Point2i cell(const Point2m& pos) const {
+        return this->cell(static_cast<float32_t>(pos.X.get()), static_cast<float32_t>(pos.Y.get()));
+    }
+
+    /* @brief Gets the center of a cell.
+     * @param c The global cell coordinates.
+     * @returns The center of the cell.
+     **/
+    Point2m center(const Point2i& c) const {
+        return Point2m(this->resolution_ * (c.X + 0.5), this->resolution_ * (c.Y + 0.5));
+    }
+
+    /* @brief Checks if a cell is inside the window.
+     * @param c The global cell coordinates.
+     * @returns Boolean value indicating if the cell is inside the window.
+     **/
+    bool contains(const Point2i& c) const {
+        return static_cast<uint32_t>((c.X >> tileBits_) - this->origin_.X) < sizeTiles_ &&
+               static_cast<uint32_t>((c.Y >> tileBits_) - this->origin_.Y) < sizeTiles_;
+    }
+
+    /* @brief Gets the log-odds of the occupancy probability of a cell.
+     * @param c The global cell coordinates.
+     * @returns The log-odds of the cell (from the base map if the tile has not been updated), 0 for unknown cells and cells outside the window.
+     **/
+    float32_t logOdds(const Point2i& c) const {
+        if (!this->contains(c)) {
+            return 0.0f;
+        }
+        const uint32_t t = tileIndex(c.X >> tileBits_, c.Y >> tileBits_);
+        const int16_t value = this->tileKeys_[t] == Point2i(c.X >> tileBits_, c.Y >> tileBits_) ? this->cells_[t][cellIndex(c.X, c.Y)] :
+            this->map_ ? this->map_->cell(c) : 0;
+        return static_cast<float32_t>(value) * (1.0f / LOG_ODDS_SCALE);
+    }
+
+    /* @brief Gets the log-odds of the occupancy probability at a position.
+     * @param pos The position.
+     * @returns The log-odds of the cell that contains the position, 0 for unknown cells and positions outside the window.
+     **/
+    float32_t logOdds(const Point2m& pos) const {
+        return this->logOdds(this->cell(pos));
+    }
+
+    /* @brief Gets the occupancy probability at a position.
+     * @param pos The position.
+     * @returns The occupancy probability of the cell that contains the position, 0.5 for unknown cells and positions outside the window.
+     **/
+    float32_t probability(const Point2m& pos) const {
+        return 1.0f - 1.0f / (1.0f + std::exp(this->logOdds(pos)));
+    }
+
+    /* @brief Traces a ray, and marks the cells it passes through as free, and the end cell as occupied (if the ray ends at an obstacle).
+     * The marked cells are updated by applyUpdates(). The part of the ray after leaving the window is ignored.
+     * @param from The start of the ray (the sensor position) - must be inside the window.
+     * @param to The end of the ray.
+     * @param hit Indicates if the ray ends at an obstacle - false for no-return beams clipped to the maximum range.
+     * @returns Boolean value indicating if the ray has been marked (false if the start is outside the window).
+     **/
+    bool castRay(const Point2m& from, const Point2m& to, bool hit = true) {
+        return this->castRay(this->cell(from), this->cell(to), hit);
+    }
+
+    /* @brief Traces a ray between cells, and marks the cells it passes through as free, and the end cell as occupied (if the ray ends at an obstacle).
+     * @param from The start cell of the ray - must be inside the window.
+     * @param to The end cell of the ray.
+     * @param hit Indicates if the ray ends at an obstacle.
+     * @returns Boolean value indicating if the ray has been marked (false if the start is outside the window).
+     **/
+    bool castRay(const Point2i& from, const Point2i& to, bool hit = true);
+
+    /* @brief Updates the log-odds of the cells marked since the last update, and clears the marks.
+     * Cells marked as occupied by any ray get the hit increment, other marked cells get the miss increment.
+     **/
+    void applyUpdates();
+
+    /* @brief Inserts a scan - marks the rays from the sensor position to the scan points, then updates the marked cells.
+     * @tparam T Numeric type of the point coordinates (unit type or arithmetic type in meters).
+     * @param sensor The position of the sensor.
+     * @param points The scan points (e.g. the output of ScanGeometry::toPoints in the map frame).
+     * @param numPoints Number of scan points.
+     * @returns Number of inserted points (0 if the sensor is outside the window).
+     **/
+    template <typename T>
+    uint32_t insertScan(const Point2m& sensor, const Point2<T> *points, uint32_t numPoints) {
+        const Point2i from = this->cell(sensor);
+        if (!this->contains(from)) {
+            return 0;
+        }
+
+        // dense scans have many consecutive points in the same cell, their rays mark the same cells, so they are traced only once
+        Point2i prev(INT32_MIN, INT32_MIN);
+        for (uint32_t i = 0; i < numPoints; ++i) {
+            const Point2i to = this->cell(static_cast<float32_t>(underlying_value(points[i].X)), static_cast<float32_t>(underlying_value(points[i].Y)));
+            if (to != prev) {
+                this->castRay(from, to, true);
+                prev = to;
+            }
+        }
+        this->applyUpdates();
+        return numPoints;
+    }
+
+private:
+    enum : uint8_t {
+        FREE = 1,   // The cell has been passed through by a ray.
+        HIT  = 2    // A ray has ended in the cell.
+    };
+
+    static int16_t toFixed(float32_t logOdds) {
+        return static_cast<int16_t>(bcr::clamp(std::round(logOdds * LOG_ODDS_SCALE), static_cast<float32_t>(INT16_MIN), static_cast<float32_t>(INT16_MAX)));
+    }
+
+    // index of a tile in the window, from its global tile coordinates
+    static uint32_t tileIndex(int32_t tx, int32_t ty) {
+        return (static_cast<uint32_t>(tx) & (sizeTiles_ - 1)) + (static_cast<uint32_t>(ty) & (sizeTiles_ - 1)) * sizeTiles_;
+    }
+
+    // index of a cell in its tile, from its global cell coordinates
+    static uint32_t cellIndex(int32_t x, int32_t y) {
+        return (static_cast<uint32_t>(x) & (TILE_SIZE - 1)) + ((static_cast<uint32_t>(y) & (TILE_SIZE - 1)) << tileBits_);
+    }
+
+    Point2i cell(float32_t x, float32_t y) const {
+        return Point2i(static_cast<int32_t>(std::floor(x * this->invResolution_)), static_cast<int32_t>(std::floor(y * this->invResolution_)));
+    }
+
+    // gets the marks of a tile inside the window, resets the tile (from the base map) if the slot has been used at another position, and adds it to the dirty tiles
+    uint8_t* markTile(int32_t tx, int32_t ty);
+
+    const meter_t resolution_;                  // Side length of the cells.
+    const float32_t invResolution_;             // Inverse of the resolution [1/m].
+    const int16_t hit_;                         // Log-odds increment of the ray end cells (fixed-point).
+    const int16_t miss_;                        // Log-odds increment of the ray cells (fixed-point).
+    const int16_t min_;                         // Lower limit of the log-odds values (fixed-point).
+    const int16_t max_;                         // Upper limit of the log-odds values (fixed-point).
+    const MapFile *map_;                        // The base map (optional).
+
+    Point2i origin_;                            // Global coordinates of the lower-left tile of the window.
+    Point2i tileKeys_[NUM_TILES];               // Global coordinates of the tiles stored in the window slots.
+    int16_t cells_[NUM_TILES][TILE_CELLS];      // Log-odds of the cells (fixed-point), every tile is stored contiguously.
+    uint8_t flags_[NUM_TILES][TILE_CELLS];      // Marks of the cells since the last update.
+    uint8_t dirty_[NUM_TILES];                  // Indicates if a tile has marked cells.
+    uint32_t dirtyTiles_[NUM_TILES];            // Indexes of the tiles with marked cells.
+    uint32_t numDirty_;                         // Number of tiles with marked cells.
+};
+
+template <uint32_t sizeTiles_, uint32_t tileBits_> constexpr uint32_t OccupancyGrid<sizeTiles_, tileBits_>::TILE_SIZE;
+template <uint32_t sizeTiles_, uint32_t tileBits_> constexpr uint32_t OccupancyGrid<sizeTiles_, tileBits_>::TILE_CELLS;
+template <uint32_t sizeTiles_, uint32_t tileBits_> constexpr uint32_t OccupancyGrid<sizeTiles_, tileBits_>::NUM_TILES;
+template <uint32_t sizeTiles_, uint32_t tileBits_> constexpr uint32_t OccupancyGrid<sizeTiles_, tileBits_>::SIZE;
+template <uint32_t sizeTiles_, uint32_t tileBits_> constexpr float32_t OccupancyGrid<sizeTiles_, tileBits_>::LOG_ODDS_SCALE;
+
+template <uint32_t sizeTiles_, uint32_t tileBits_>
+uint8_t* OccupancyGrid<sizeTiles_, tileBits_>::markTile(int32_t tx, int32_t ty) {
+    const uint32_t t = tileIndex(tx, ty);
+    if (this->tileKeys_[t] != Point2i(tx, ty)) {
+        // the slot has been used by a tile that is outside the window now, its pending marks are dropped
+        const int16_t *const base = this->map_ ? this->map_->tile(tx, ty) : nullptr;
+        this->tileKeys_[t] = Point2i(tx, ty);
+        if (base) {
+            std::memcpy(this->cells_[t], base, sizeof(this->cells_[t]));
+        } else {
+            std::memset(this->cells_[t], 0, sizeof(this->cells_[t]));
+        }
+        std::memset(this->flags_[t], 0, sizeof(this->flags_[t]));
+    }
+    if (!this->dirty_[t]) {
+        this->dirty_[t] = 1;
+        this->dirtyTiles_[this->numDirty_++] = t;
+    }
+    return this->flags_[t];
+}
+
+template <uint32_t sizeTiles_, uint32_t tileBits_>
+bool OccupancyGrid<sizeTiles_, tileBits_>::castRay(const Point2i& from, const Point2i& to, bool hit) {
+    if (!this->contains(from)) {
+        return false;
+    }
+
+    // DDA stepping - the coordinate along the major axis changes by exactly one cell in every step,
+    // the other coordinate is a 16.16 fixed-point accumulator relative to the start cell (started at the cell center, so it is rounded)
+    const int32_t x0 = from.X, y0 = from.Y, ox = this->origin_.X, oy = this->origin_.Y;
+    const int32_t dx = to.X - x0, dy = to.Y - y0;
+    const int32_t n = bcr::max(std::abs(dx), std::abs(dy));
+    const int32_t incX = n > 0 ? static_cast<int32_t>(static_cast<int64_t>(dx) * 65536 / n) : 0;
+    const int32_t incY = n > 0 ? static_cast<int32_t>(static_cast<int64_t>(dy) * 65536 / n) : 0;
+    int32_t ax = 1 << 15, ay = 1 << 15;
+
+    // the tile is only looked up when the ray crosses a tile border
+    int32_t tx = x0 >> tileBits_, ty = y0 >> tileBits_;
+    uint8_t *flags = this->markTile(tx, ty);
+
+    for (int32_t i = 0; i < n; ++i) {
+        const int32_t x = x0 + (ax >> 16), y = y0 + (ay >> 16);
+        if ((x >> tileBits_) != tx || (y >> tileBits_) != ty) {
+            tx = x >> tileBits_;
+            ty = y >> tileBits_;
+
+            // the window is convex, a ray that leaves it never returns
+            if (static_cast<uint32_t>(tx - ox) >= sizeTiles_ || static_cast<uint32_t>(ty - oy) >= sizeTiles_) {
+                return true;
+            }
+            flags = this->markTile(tx, ty);
+        }
+        flags[cellIndex(x, y)] |= FREE;
+        ax += incX;
+        ay += incY;
+    }
+
+    // the accumulated rounding error may move the last step by a cell, the end cell is addressed directly
+    if (!this->contains(to)) {
+        return true;
+    }
+    flags = this->markTile(to.X >> tileBits_, to.Y >> tileBits_);
+    flags[cellIndex(to.X, to.Y)] |= hit ? HIT : FREE;
+    return true;
+}
+
+template <uint32_t sizeTiles_, uint32_t tileBits_>
+void OccupancyGrid<sizeTiles_, tileBits_>::applyUpdates() {
+    const int32_t hitInc = this->hit_, missInc = this->miss_, minValue = this->min_, maxValue = this->max_;
+
+    for (uint32_t d = 0; d < this->numDirty_; ++d) {
+        const uint32_t t = this->dirtyTiles_[d];
+        this->dirty_[t] = 0;
+
+        // the marks of the tiles that are outside the window (after re-centering) are dropped
+        const Point2i key = this->tileKeys_[t];
+        if (static_cast<uint32_t>(key.X - this->origin_.X) >= sizeTiles_ || static_cast<uint32_t>(key.Y - this->origin_.Y) >= sizeTiles_) {
+            std::memset(this->flags_[t], 0, sizeof(this->flags_[t]));
+            continue;
+        }
+
+        // branch-free update - the hit mark overrides the free mark
+        // (the arrays are indexed through the object, so the compiler can prove that they do not overlap)
+        for (uint32_t i = 0; i < TILE_CELLS; ++i) {
+            const int32_t f = this->flags_[t][i];
+            const int32_t hitMask = -(f >> 1);
+            const int32_t freeMask = -(f & 1) & ~hitMask;
+            const int32_t inc = (hitInc & hitMask) | (missInc & freeMask);
+            this->cells_[t][i] = static_cast<int16_t>(bcr::clamp(this->cells_[t][i] + inc, minValue, maxValue));
+        }
+        std::memset(this->flags_[t], 0, sizeof(this->flags_[t]));
+    }
+    this->numDirty_ = 0;
+}
+
+} // namespace bcr
@@ -5,20 +5,107 @@
 #include <babocar-core/unit_utils.hpp>
 
 namespace bcr {
+
+/* @brief Odometry sample - constant forward speed and angular velocity over a time interval (e.g. one encoder period).
+ **/
+struct OdometrySample {
+    millisecond_t d_time;   // Length of the interval.
+    m_per_sec_t speed;      // Forward speed of the vehicle.
+    rad_per_sec_t ang_vel;  // Angular velocity of the vehicle.
+};
+
+namespace detail {
+
+/* @brief Calculates the coefficients of the constant twist arc: sin(x), cos(x), sin(x)/x and (1 - cos(x))/x.
+ * Small angles (the usual case at high sample rates) use Taylor series, which do not need trigonometric calls,
+ * and do not lose precision when x is close to 0 (where the quotients cancel).
+ * @param x The rotation angle of the arc in radians.
+ **/
+inline void arc_coeffs(float64_t x, float64_t& sin, float64_t& cos, float64_t& sinc, float64_t& cosc) {
+    static constexpr float64_t SERIES_MAX_ANGLE = 0.25; // the truncation errors are below 1e-13 in this range
+
+    if (std::abs(x) < SERIES_MAX_ANGLE) {
+        const float64_t x2 = x * x;
+        sinc = 1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0)));
+        cosc = x / 2.0 * (1.0 - x2 / 12.0 * (1.0 - x2 / 30.0 * (1.0 - x2 / 56.0 * (1.0 - x2 / 90.0))));
+        sin = x * sinc;
+        cos = 1.0 - x * cosc;
+    } else {
+        bcr::sincos(radian_t(x), sin, cos);
+        sinc = sin / x;
+        cosc = (1.0 - cos) / x;
+    }
+}
+
+} // namespace detail
+
 struct Odometry {
     Pose pose;
     Twist twist;
 
     void update(const millisecond_t d_time) {
         const radian_t d_angle = this->twist.ang_vel * d_time;
-        const float64_t s = bcr::sin(d_angle / 2);
-        const float64_t c = bcr::cos(d_angle / 2);
+        float64_t s, c;
+        bcr::sincos(d_angle / 2, s, c);
 
         this->twist.speed = this->twist.speed.rotate(s, c);
         this->pose.pos += this->twist.speed * d_time;
         this->twist.speed = this->twist.speed.rotate(s, c);
         this->pose.angle += d_angle;
     }
+
+    /* @brief Integrates multiple samples with the exact solution of constant speed and angular velocity (circular arc) for every sample.
+     * The heading is kept as a unit vector that is rotated incrementally, so trigonometric functions are only called once per batch
+     * (and for samples that rotate more than 0.25 rad). The twist is set to the last sample, its speed is given in the frame of the pose.
+     * @param samples The samples.
+     * @param numSamples Number of samples.
+     * @param trajectory Optional output array of the poses after every decimation-th sample - must have space for numSamples / decimation poses.
+     * @param decimation The decimation of the trajectory - 1 means a pose after every sample.
+     * @returns Number of poses written to the trajectory.
+     **/
+    uint32_t update(const OdometrySample *samples, uint32_t numSamples, Pose *trajectory = nullptr, uint32_t decimation = 1) {
+        float64_t x = this->pose.pos.X.get(), y = this->pose.pos.Y.get();
+        float64_t s, c;
+        bcr::sincos(this->pose.angle, s, c);
+        float64_t d_angle_sum = 0.0;
+
+        uint32_t numPoses = 0;
+        for (uint32_t i = 0, next = decimation; i < numSamples; ++i) {
+            const float64_t dt = second_t(samples[i].d_time).get();
+            const float64_t dist = samples[i].speed.get() * dt;
+            const float64_t d_angle = samples[i].ang_vel.get() * dt;
+
+            float64_t ds, dc, sinc, cosc;
+            detail::arc_coeffs(d_angle, ds, dc, sinc, cosc);
+
+            // displacement along the arc in the vehicle frame is dist * (sinc, cosc), rotated to the frame of the pose
+            x += dist * (c * sinc - s * cosc);
+            y += dist * (s * sinc + c * cosc);
+
+            // rotates heading, then corrects its length (first order Newton step of 1/sqrt) to prevent drift of the incremental rotation
+            const float64_t c_ = c * dc - s * ds;
+            s = s * dc + c * ds;
+            c = c_;
+            const float64_t k = (3.0 - (c * c + s * s)) / 2.0;
+            c *= k;
+            s *= k;
+
+            d_angle_sum += d_angle;
+
+            if (trajectory && i + 1 == next) {
+                trajectory[numPoses++] = { Point2m(meter_t(x), meter_t(y)), this->pose.angle + radian_t(d_angle_sum) };
+                next += decimation;
+            }
+        }
+
+        this->pose.pos = Point2m(meter_t(x), meter_t(y));
+        this->pose.angle += radian_t(d_angle_sum);
+        if (numSamples > 0) {
+            const OdometrySample& last = samples[numSamples - 1];
+            this->twist.speed = Point2mps(last.speed * c, last.speed * s);
+            this->twist.ang_vel = last.ang_vel;
+        }
+        return numPoses;
+    }
 };
 } // namespace bcr
-
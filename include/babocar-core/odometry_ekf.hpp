@@ -0,0 +1,220 @@
+#pragma once
+
+#include <babocar-core/mat.hpp>
+#include <babocar-core/odometry.hpp>
+
+namespace bcr {
+
+/* @brief Extended Kalman filter of planar motion, for fusing wheel encoder, gyroscope and absolute pose (e.g. visual) measurements.
+ * The state is [x, y, angle, speed, angular velocity], where the speed is the forward speed of the vehicle (no lateral motion).
+ * Prediction uses the same midpoint motion model as Odometry::update, the speed and the angular velocity are random walks.
+ * All matrices are fixed-size and every step has a fixed number of operations, no dynamic allocation is performed.
+ * @tparam T Numeric type of the state and the covariance (float32_t for FPU-only targets, float64_t otherwise).
+ **/
+template <typename T>
+class OdometryEKF {
+public:
+    enum : uint32_t { X = 0, Y, ANGLE, SPEED, ANG_VEL, STATE_SIZE };   // Indexes of the state elements.
+
+    typedef mat<T, STATE_SIZE, 1> state_type;               // State vector type.
+    typedef mat<T, STATE_SIZE, STATE_SIZE> covariance_type; // State covariance type.
+
+    /* @brief Constructor - sets initial state and noise parameters.
+     * @param initial The initial pose and twist. The speed is projected to the heading of the vehicle.
+     * @param covariance The covariance of the initial state.
+     * @param accelNoise Spectral density of the forward acceleration noise [m^2/s^3].
+     * @param angAccelNoise Spectral density of the angular acceleration noise [rad^2/s^3].
+     **/
+    OdometryEKF(const Odometry& initial, const covariance_type& covariance, T accelNoise, T angAccelNoise)
+        : P_(covariance)
+        , accelNoise_(accelNoise)
+        , angAccelNoise_(angAccelNoise) {
+        this->reset(initial);
+    }
+
+    /* @brief Resets the state. The covariance is not changed.
+     * @param odom The pose and twist. The speed is projected to the heading of the vehicle.
+     **/
+    void reset(const Odometry& odom) {
+        float64_t s, c;
+        bcr::sincos(odom.pose.angle, s, c);
+        this->x_[X]       = static_cast<T>(odom.pose.pos.X.get());
+        this->x_[Y]       = static_cast<T>(odom.pose.pos.Y.get());
+        this->x_[ANGLE]   = static_cast<T>(wrap_angle(odom.pose.angle.get()));
+        this->x_[SPEED]   = static_cast<T>(odom.twist.speed.X.get() * c + odom.twist.speed.Y.get() * s);
+        this->x_[ANG_VEL] = static_cast<T>(odom.twist.ang_vel.get());
+    }
+
+    /* @brief Propagates the state and the covariance.
+     * @param d_time Time elapsed since the previous prediction.
+     **/
+    void predict(millisecond_t d_time);
+
+    /* @brief Updates the state with a forward speed measurement (e.g. wheel encoders).
+     * @param speed The measured speed.
+     * @param variance The variance of the measurement [m^2/s^2].
+     **/
+    void updateSpeed(m_per_sec_t speed, T variance) {
+        this->updateElement(SPEED, static_cast<T>(speed.get()) - this->x_[SPEED], variance);
+    }
+
+    /* @brief Updates the state with an angular velocity measurement (e.g. gyroscope).
+     * @param ang_vel The measured angular velocity.
+     * @param variance The variance of the measurement [rad^2/s^2].
+     **/
+    void updateAngVel(rad_per_sec_t ang_vel, T variance) {
+        this->updateElement(ANG_VEL, static_cast<T>(ang_vel.get()) - this->x_[ANG_VEL], variance);
+    }
+
+    /* @brief Updates the state with an absolute pose measurement (e.g. visual localization).
+     * @param pose The measured pose.
+     * @param covariance The covariance of the measurement (x, y, angle).
+     * @returns Boolean value indicating if the update has been applied (false if the innovation covariance is not positive definite).
+     **/
+    bool updatePose(const Pose& pose, const mat<T, 3, 3>& covariance) {
+        static const mat<T, 3, STATE_SIZE> H(
+            1, 0, 0, 0, 0,
+            0, 1, 0, 0, 0,
+            0, 0, 1, 0, 0);
+
+        const mat<T, 3, 1> innovation(
+            static_cast<T>(pose.pos.X.get()) - this->x_[X],
+            static_cast<T>(pose.pos.Y.get()) - this->x_[Y],
+            wrap_angle(static_cast<T>(pose.angle.get()) - this->x_[ANGLE]));
+        return this->update(innovation, H, covariance);
+    }
+
+    /* @brief Updates the state with a linear(ized) measurement - for sensor models not covered by the specific update functions.
+     * @tparam M Size of the measurement.
+     * @param innovation The difference of the measurement and the predicted measurement (angles must be wrapped).
+     * @param H The measurement Jacobian.
+     * @param R The measurement covariance.
+     * @returns Boolean value indicating if the update has been applied (false if the innovation covariance is not positive definite).
+     **/
+    template <uint32_t M>
+    bool update(const mat<T, M, 1>& innovation, const mat<T, M, STATE_SIZE>& H, const mat<T, M, M>& R);
+
+    /* @brief Gets the estimated pose.
+     * @returns The estimated pose, the angle is in the range [-PI, PI].
+     **/
+    Pose pose() const {
+        return { Point2m(meter_t(this->x_[X]), meter_t(this->x_[Y])), radian_t(this->x_[ANGLE]) };
+    }
+
+    /* @brief Gets the estimated twist.
+     * @returns The estimated twist, the speed is given in the same frame as the pose (as in Odometry).
+     **/
+    Twist twist() const {
+        float64_t s, c;
+        bcr::sincos(radian_t(this->x_[ANGLE]), s, c);
+        const float64_t v = this->x_[SPEED];
+        return { Point2mps(m_per_sec_t(v * c), m_per_sec_t(v * s)), rad_per_sec_t(this->x_[ANG_VEL]) };
+    }
+
+    /* @brief Gets the estimated odometry.
+     * @returns The estimated pose and twist.
+     **/
+    Odometry odometry() const {
+        return { this->pose(), this->twist() };
+    }
+
+    const state_type& state() const { return this->x_; }
+    const covariance_type& covariance() const { return this->P_; }
+
+private:
+    // wraps angle to [-PI, PI] without loops, so that the cost does not depend on the value
+    static T wrap_angle(T angle) {
+        const T TWO_PI = static_cast<T>(6.28318530717958647692528676656);
+        return angle - TWO_PI * std::round(angle / TWO_PI);
+    }
+
+    // scalar update of a directly measured state element, no matrix inversion is needed
+    void updateElement(uint32_t idx, T innovation, T variance);
+
+    // keeps the covariance exactly symmetric, rounding errors of the updates would accumulate otherwise
+    void symmetrize() {
+        for (uint32_t i = 0; i < STATE_SIZE; ++i) {
+            for (uint32_t j = i + 1; j < STATE_SIZE; ++j) {
+                const T m = (this->P_(i, j) + this->P_(j, i)) / 2;
+                this->P_(i, j) = this->P_(j, i) = m;
+            }
+        }
+    }
+
+    state_type x_;          // The state.
+    covariance_type P_;     // The state covariance.
+    T accelNoise_;          // Spectral density of the forward acceleration noise.
+    T angAccelNoise_;       // Spectral density of the angular acceleration noise.
+};
+
+template <typename T>
+void OdometryEKF<T>::predict(millisecond_t d_time) {
+    const T dt = static_cast<T>(second_t(d_time).get());
+    const T v = this->x_[SPEED], w = this->x_[ANG_VEL];
+    const T d_angle = w * dt;
+
+    float64_t s_, c_;
+    bcr::sincos(radian_t(this->x_[ANGLE] + d_angle / 2), s_, c_);
+    const T s = static_cast<T>(s_), c = static_cast<T>(c_);
+    const T d = v * dt;
+
+    this->x_[X] += d * c;
+    this->x_[Y] += d * s;
+    this->x_[ANGLE] = wrap_angle(this->x_[ANGLE] + d_angle);
+
+    covariance_type F = covariance_type::identity();
+    F(X, ANGLE)       = -d * s;
+    F(X, SPEED)       = dt * c;
+    F(X, ANG_VEL)     = -d * s * dt / 2;
+    F(Y, ANGLE)       = d * c;
+    F(Y, SPEED)       = dt * s;
+    F(Y, ANG_VEL)     = d * c * dt / 2;
+    F(ANGLE, ANG_VEL) = dt;
+
+    this->P_ = F * this->P_ * F.transpose();
+    this->P_(SPEED, SPEED)     += this->accelNoise_ * dt;
+    this->P_(ANG_VEL, ANG_VEL) += this->angAccelNoise_ * dt;
+    this->symmetrize();
+}
+
+template <typename T>
+void OdometryEKF<T>::updateElement(uint32_t idx, T innovation, T variance) {
+    // H selects one element: S = P(idx, idx) + R, K = P(:, idx) / S
+    const T invS = T(1) / (this->P_(idx, idx) + variance);
+    state_type K;
+    for (uint32_t i = 0; i < STATE_SIZE; ++i) {
+        K[i] = this->P_(i, idx) * invS;
+    }
+
+    // P = P - K * H * P, where H * P is row idx of P
+    const mat<T, 1, STATE_SIZE> HP(this->P_(idx, 0), this->P_(idx, 1), this->P_(idx, 2), this->P_(idx, 3), this->P_(idx, 4));
+    this->x_ += K * innovation;
+    this->P_ -= K * HP;
+    this->x_[ANGLE] = wrap_angle(this->x_[ANGLE]);
+    this->symmetrize();
+}
+
+template <typename T>
+template <uint32_t M>
+bool OdometryEKF<T>::update(const mat<T, M, 1>& innovation, const mat<T, M, STATE_SIZE>& H, const mat<T, M, M>& R) {
+    const mat<T, M, STATE_SIZE> HP = H * this->P_;
+    const mat<T, M, M> S = HP * H.transpose() + R;
+
+    // K = P * H^T * S^-1, therefore K^T = S^-1 * H * P (P and S are symmetric)
+    mat<T, M, STATE_SIZE> Kt;
+    if (!S.solveCholesky(HP, Kt)) {
+        return false;
+    }
+
+    const mat<T, STATE_SIZE, M> K = Kt.transpose();
+    this->x_ += K * innovation;
+    this->P_ -= K * HP;
+    this->x_[ANGLE] = wrap_angle(this->x_[ANGLE]);
+    this->symmetrize();
+    return true;
+}
+
+typedef OdometryEKF<float32_t> OdometryEKFf;    // 32-bit floating point odometry filter.
+typedef OdometryEKF<float64_t> OdometryEKFd;    // 64-bit floating point odometry filter.
+
+} // namespace bcr
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <babocar-core/odometry.hpp>
+
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Odometry with retrodiction - applies delayed absolute pose measurements (e.g. visual fixes) at their timestamps,
+ * and re-integrates the samples received since then, instead of snapping the current pose to an outdated measurement.
+ * Recent samples are stored in a circular buffer, and the pose is saved as a checkpoint at the beginning of every checkpointInterval_-th sample.
+ * A correction integrates from the nearest checkpoint before the measurement timestamp, so its cost is bounded by
+ * the checkpoint interval plus the number of samples in the maximum delay. The checkpoints after the measurement are rewritten with the corrected poses.
+ * All storage is fixed-size, no dynamic allocation is performed.
+ * @tparam capacity_ Number of stored samples - must cover the maximum delay of the measurements.
+ * @tparam checkpointInterval_ Number of samples between checkpoints. Capacity must be a multiple of it.
+ **/
+template <uint32_t capacity_, uint32_t checkpointInterval_ = 16>
+class OdometryReplay {
+public:
+    static_assert(capacity_ > checkpointInterval_ && capacity_ % checkpointInterval_ == 0, "Capacity must be a multiple of the checkpoint interval!");
+
+    /* @brief Constructor - sets maximum delay of the measurements.
+     * @param maxDelay The maximum delay of the measurements - older measurements are rejected, this limits the cost of the corrections.
+     **/
+    explicit OdometryReplay(millisecond_t maxDelay)
+        : maxDelay_(maxDelay) {
+        Odometry odom;
+        odom.pose = { Point2m(meter_t(0), meter_t(0)), radian_t(0) };
+        odom.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+        this->reset(millisecond_t(0), odom);
+    }
+
+    /* @brief Clears history, and sets the current time and odometry.
+     * @param time The current time.
+     * @param odom The current odometry.
+     **/
+    void reset(millisecond_t time, const Odometry& odom) {
+        this->time_ = time;
+        this->odom_ = odom;
+        this->lastCorrection_ = time;
+        this->numSamples_ = 0;
+    }
+
+    /* @brief Integrates samples, and stores them for later corrections.
+     * @param samples The samples.
+     * @param numSamples Number of samples.
+     **/
+    void update(const OdometrySample *samples, uint32_t numSamples);
+
+    /* @brief Integrates a sample, and stores it for later corrections.
+     * @param sample The sample.
+     **/
+    void update(const OdometrySample& sample) {
+        this->update(&sample, 1);
+    }
+
+    /* @brief Corrects the pose at the timestamp of a delayed measurement, and re-integrates the later samples.
+     * @param time The timestamp of the measurement.
+     * @param pose The measured pose.
+     * @param gain The weight of the measurement - 1 means the pose at the timestamp is replaced with the measurement,
+     * smaller values blend it with the estimated pose (e.g. for noisy measurements).
+     * @returns Boolean value indicating if the correction has been applied (false if the timestamp is in the future,
+     * older than the maximum delay, older than the stored history, or older than the previous correction -
+     * the re-integration would overwrite the previous correction).
+     **/
+    bool correct(millisecond_t time, const Pose& pose, float64_t gain = 1.0);
+
+    /* @brief Gets the current odometry.
+     * @returns The current odometry.
+     **/
+    const Odometry& odometry() const { return this->odom_; }
+
+    /* @brief Gets the current time - the end of the last sample.
+     * @returns The current time.
+     **/
+    millisecond_t time() const { return this->time_; }
+
+private:
+    static constexpr uint32_t NUM_CHECKPOINTS = capacity_ / checkpointInterval_;
+
+    struct Checkpoint {
+        millisecond_t time;     // Beginning of the first sample of the checkpoint interval.
+        Pose pose;              // Pose at the beginning of the first sample of the checkpoint interval.
+    };
+
+    Checkpoint& checkpoint(uint32_t idx) { return this->checkpoints_[idx % NUM_CHECKPOINTS]; }
+
+    // samples of a checkpoint interval are stored contiguously, because the capacity is a multiple of the interval
+    OdometrySample* sample(uint32_t idx) { return &this->samples_[idx % capacity_]; }
+
+    // integrates samples from a sample index to the end, and rewrites the checkpoints on the way
+    void replay(Odometry& odom, uint32_t first);
+
+    millisecond_t maxDelay_;                    // Maximum delay of the measurements.
+    millisecond_t time_;                        // Current time - the end of the last sample.
+    Odometry odom_;                             // Current odometry.
+    millisecond_t lastCorrection_;              // Timestamp of the last correction.
+    uint32_t numSamples_;                       // Number of samples since the last reset - the index of the next sample.
+    OdometrySample samples_[capacity_];         // The stored samples.
+    Checkpoint checkpoints_[NUM_CHECKPOINTS];   // The checkpoints.
+};
+
+template <uint32_t capacity_, uint32_t checkpointInterval_>
+constexpr uint32_t OdometryReplay<capacity_, checkpointInterval_>::NUM_CHECKPOINTS;
+
+template <uint32_t capacity_, uint32_t checkpointInterval_>
+void OdometryReplay<capacity_, checkpointInterval_>::update(const OdometrySample *samples, uint32_t numSamples) {
+    while (numSamples > 0) {
+        const uint32_t offset = this->numSamples_ % checkpointInterval_;
+        if (offset == 0) {
+            this->checkpoint(this->numSamples_ / checkpointInterval_) = { this->time_, this->odom_.pose };
+        }
+
+        // integrates the samples until the next checkpoint in one batch
+        const uint32_t num = bcr::min(numSamples, checkpointInterval_ - offset);
+        OdometrySample *const stored = this->sample(this->numSamples_);
+        for (uint32_t i = 0; i < num; ++i) {
+            stored[i] = samples[i];
+            this->time_ += samples[i].d_time;
+        }
+        this->odom_.update(stored, num);
+
+        this->numSamples_ += num;
+        samples += num;
+        numSamples -= num;
+    }
+}
+
+template <uint32_t capacity_, uint32_t checkpointInterval_>
+bool OdometryReplay<capacity_, checkpointInterval_>::correct(millisecond_t time, const Pose& pose, float64_t gain) {
+    if (this->numSamples_ == 0 || time > this->time_ || this->time_ - time > this->maxDelay_ || time < this->lastCorrection_) {
+        return false;
+    }
+
+    // finds the last checkpoint before the measurement - the oldest valid checkpoint is the one after the partially overwritten interval
+    const uint32_t last = (this->numSamples_ - 1) / checkpointInterval_;
+    const uint32_t oldest = last >= NUM_CHECKPOINTS ? last - NUM_CHECKPOINTS + 1 : 0;
+    uint32_t cp = last;
+    while (this->checkpoint(cp).time > time) {
+        if (cp == oldest) {
+            return false;
+        }
+        --cp;
+    }
+
+    // integrates the whole samples before the measurement, then the part of the sample that contains it
+    const uint32_t first = cp * checkpointInterval_;
+    const uint32_t end = bcr::min(first + checkpointInterval_, this->numSamples_);
+    millisecond_t t = this->checkpoint(cp).time;
+    uint32_t idx = first;
+    while (idx < end && t + this->sample(idx)->d_time <= time) {
+        t += this->sample(idx)->d_time;
+        ++idx;
+    }
+
+    Odometry odom = { this->checkpoint(cp).pose, this->odom_.twist };
+    odom.update(this->sample(first), idx - first);
+
+    OdometrySample remaining;
+    if (idx < end) {
+        remaining = *this->sample(idx);
+        OdometrySample part = remaining;
+        part.d_time = time - t;
+        remaining.d_time -= part.d_time;
+        odom.update(&part, 1);
+    }
+
+    // blends the estimated pose with the measurement
+    const float64_t TWO_PI = 2 * PI.get();
+    const float64_t d_angle = (pose.angle - odom.pose.angle).get();
+    odom.pose.pos += (pose.pos - odom.pose.pos) * gain;
+    odom.pose.angle += radian_t((d_angle - TWO_PI * std::round(d_angle / TWO_PI)) * gain);
+
+    if (idx < end) {
+        odom.update(&remaining, 1);
+        ++idx;
+    }
+    this->replay(odom, idx);
+
+    // the speed is given in the frame of the pose, so it rotates with the heading correction
+    odom.twist.speed = this->odom_.twist.speed.rotate(odom.pose.angle - this->odom_.pose.angle);
+    this->odom_ = odom;
+    this->lastCorrection_ = time;
+    return true;
+}
+
+template <uint32_t capacity_, uint32_t checkpointInterval_>
+void OdometryReplay<capacity_, checkpointInterval_>::replay(Odometry& odom, uint32_t first) {
+    while (first < this->numSamples_) {
+        const uint32_t offset = first % checkpointInterval_;
+        if (offset == 0) {
+            this->checkpoint(first / checkpointInterval_).pose = odom.pose;
+        }
+        const uint32_t num = bcr::min(this->numSamples_ - first, checkpointInterval_ - offset);
+        odom.update(this->sample(first), num);
+        first += num;
+    }
+}
+
+} // namespace bcr
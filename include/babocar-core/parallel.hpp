@@ -0,0 +1,39 @@
+#pragma once
+
+#include <babocar-core/numeric.hpp>
+
+#include <thread>
+
+namespace bcr {
+namespace detail {
+
+static constexpr uint32_t MAX_THREADS = 16;     // Maximum number of threads of parallel_for.
+
+/* @brief Splits the range [0, n) into contiguous chunks, and processes them on multiple threads.
+ * The threads are started in every call and joined before returning, the calling thread processes the first chunk.
+ * With numThreads == 1 the work is called directly, without dynamic allocation. Otherwise every started std::thread allocates
+ * its callable state on the heap, and the operating system allocates its stack.
+ * @param n Size of the range.
+ * @param numThreads Number of threads (1 means the calling thread only). Limited by MAX_THREADS.
+ * @param work The work - called concurrently with (begin, end, thread index) for every thread, the chunks may be empty.
+ * @param align Alignment of the chunk boundaries (e.g. 16 to keep SIMD loops and cache lines aligned) - must be a power of 2.
+ * @returns Number of used threads - the thread indices passed to the work are in the range [0, returned value).
+ **/
+template <typename F>
+uint32_t parallel_for(uint32_t n, uint32_t numThreads, F work, uint32_t align = 1) {
+    numThreads = bcr::clamp(numThreads, 1u, MAX_THREADS);
+    const uint32_t chunk = ((n + numThreads - 1) / numThreads + align - 1) & ~(align - 1);
+
+    std::thread threads[MAX_THREADS - 1];
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        threads[t - 1] = std::thread(work, bcr::min(t * chunk, n), bcr::min((t + 1) * chunk, n), t);
+    }
+    work(0u, bcr::min(chunk, n), 0u);
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        threads[t - 1].join();
+    }
+    return numThreads;
+}
+
+} // namespace detail
+} // namespace bcr
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <babocar-core/parallel.hpp>
+#include <babocar-core/pose.hpp>
+#include <babocar-core/random.hpp>
+#include <babocar-core/twist.hpp>
+#include <babocar-core/unit_utils.hpp>
+
+namespace bcr {
+
+namespace detail {
+
+/* @brief Generates approximately normally distributed number from a 32-bit hash - sum of its 4 bytes (Irwin-Hall distribution).
+ * Only integer and floating point arithmetic is used, so it can be vectorized (unlike the Box-Muller transform).
+ * @param hash The hash value.
+ * @returns The random number with zero mean and unit standard deviation.
+ **/
+inline float32_t hash_normal(uint32_t hash) {
+    const uint32_t sum = (hash & 0xffu) + ((hash >> 8) & 0xffu) + ((hash >> 16) & 0xffu) + (hash >> 24);
+    return (static_cast<float32_t>(sum) - 510.0f) * (1.0f / 147.80165f);    // mean: 4 * 255 / 2, variance: 4 * (256^2 - 1) / 12
+}
+
+} // namespace detail
+
+/* @brief Particle filter for planar localization in a known map.
+ * The particle states (position and heading unit vector) and the weights are stored as structure of arrays,
+ * so the motion update and the user-provided measurement model can be vectorized. The motion noise is generated
+ * by a counter-based hash, the measurement weighting can be split among multiple threads,
+ * and the low-variance resampling copies the particles to a preallocated second buffer.
+ * The prediction and the resampling perform no dynamic allocation. The weighting does not either with numThreads == 1 -
+ * otherwise the started threads allocate (see detail::parallel_for).
+ * @note The object stores 11 arrays of capacity_ elements, large filters should be allocated statically or on the heap.
+ * @tparam capacity_ Maximum number of particles.
+ **/
+template <uint32_t capacity_>
+class ParticleFilter {
+public:
+    /* @brief Particles given to the measurement model - all arrays have the same size.
+     **/
+    struct Particles {
+        const float32_t *x;     // X coordinates of the particles [m].
+        const float32_t *y;     // Y coordinates of the particles [m].
+        const float32_t *cos;   // Cosines of the particle headings.
+        const float32_t *sin;   // Sines of the particle headings.
+        float32_t *weight;      // Weights of the particles - to be multiplied by the measurement likelihoods.
+        uint32_t size;          // Number of particles.
+    };
+
+    /* @brief Constructor - sets motion noise.
+     * @param speedNoise Standard deviation of the speed in the motion update.
+     * @param angVelNoise Standard deviation of the angular velocity in the motion update.
+     * @param seed Seed of the motion noise.
+     **/
+    ParticleFilter(m_per_sec_t speedNoise, rad_per_sec_t angVelNoise, uint32_t seed = 1)
+        : speedNoise_(static_cast<float32_t>(speedNoise.get()))
+        , angVelNoise_(static_cast<float32_t>(angVelNoise.get()))
+        , counter_(seed)
+        , front_(0)
+        , size_(0) {}
+
+    /* @brief Initializes particles with normal distribution around a pose, with equal weights.
+     * @param pose The mean pose.
+     * @param posStd Standard deviation of the particle coordinates.
+     * @param angleStd Standard deviation of the particle headings.
+     * @param numParticles Number of particles. Limited by capacity_.
+     **/
+    void reset(const Pose& pose, meter_t posStd, radian_t angleStd, uint32_t numParticles);
+
+    /* @brief Moves particles according to the twist, with random noise added to the speed and angular velocity of every particle.
+     * Every particle moves on the arc of its noisy twist (exact constant twist solution). The rotation of a particle in one step
+     * is calculated with Taylor series, therefore it must be below 0.25 rad (e.g. 25 rad/s at 100 Hz).
+     * @param twist The twist in the vehicle frame (speed.X is the forward speed, speed.Y is the lateral speed).
+     * @param d_time Time elapsed since the previous update.
+     **/
+    void predict(const Twist& twist, millisecond_t d_time);
+
+    /* @brief Multiplies particle weights by the measurement likelihoods, then normalizes the weights.
+     * @tparam F Type of the measurement model - callable with signature void(const Particles&),
+     * that multiplies the weights by the likelihoods of the measurement for the given particles.
+     * @param likelihood The measurement model. When using multiple threads, it is called concurrently for disjoint ranges of particles.
+     * @param numThreads Number of threads (1 means the calling thread only). Limited by detail::MAX_THREADS.
+     * @returns Boolean value indicating if the weights are valid - if all likelihoods are 0, the weights are reset to uniform.
+     **/
+    template <typename F>
+    bool weight(F likelihood, uint32_t numThreads = 1);
+
+    /* @brief Calculates effective number of particles - the inverse of the sum of squared weights.
+     * @returns The effective number of particles.
+     **/
+    float32_t effectiveSize() const;
+
+    /* @brief Resamples particles with low-variance (systematic) resampling - particles are copied in proportion to their weights,
+     * using a single random offset. The weights become uniform.
+     **/
+    void resample();
+
+    /* @brief Calculates weighted mean pose of the particles.
+     * @returns The weighted mean pose.
+     **/
+    Pose estimate() const;
+
+    uint32_t size() const { return this->size_; }
+    const float32_t* x() const { return this->data_[this->front_][X]; }
+    const float32_t* y() const { return this->data_[this->front_][Y]; }
+    const float32_t* cos() const { return this->data_[this->front_][COS]; }
+    const float32_t* sin() const { return this->data_[this->front_][SIN]; }
+    const float32_t* weights() const { return this->data_[this->front_][WEIGHT]; }
+
+private:
+    enum { X = 0, Y, COS, SIN, WEIGHT, NUM_ARRAYS };    // Indexes of the particle arrays.
+
+    // normalizes weights to sum 1, or resets them to uniform if the sum is not positive
+    bool normalize(float32_t sum);
+
+    const float32_t speedNoise_;                        // Standard deviation of the speed in the motion update [m/s].
+    const float32_t angVelNoise_;                       // Standard deviation of the angular velocity in the motion update [rad/s].
+    uint32_t counter_;                                  // Counter of the random numbers (the input of the hash).
+    uint32_t front_;                                    // Index of the buffer that holds the current particles.
+    uint32_t size_;                                     // Number of particles.
+    float32_t data_[2][NUM_ARRAYS][capacity_];          // Particle arrays, double-buffered for the resampling.
+    uint32_t indices_[capacity_];                       // Indexes of the selected particles in the resampling.
+};
+
+
+template <uint32_t capacity_>
+void ParticleFilter<capacity_>::reset(const Pose& pose, meter_t posStd, radian_t angleStd, uint32_t numParticles) {
+    this->size_ = bcr::min(numParticles, capacity_);
+    this->front_ = 0;
+
+    float32_t *const x = this->data_[0][X], *const y = this->data_[0][Y];
+    float32_t *const c = this->data_[0][COS], *const s = this->data_[0][SIN], *const w = this->data_[0][WEIGHT];
+    const float32_t w0 = 1.0f / static_cast<float32_t>(bcr::max(this->size_, 1u));
+
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        const uint32_t h = this->counter_ + 3 * i;
+        x[i] = static_cast<float32_t>((pose.pos.X + posStd * static_cast<float64_t>(detail::hash_normal(hash32(h)))).get());
+        y[i] = static_cast<float32_t>((pose.pos.Y + posStd * static_cast<float64_t>(detail::hash_normal(hash32(h + 1)))).get());
+
+        float64_t s_, c_;
+        bcr::sincos(pose.angle + angleStd * static_cast<float64_t>(detail::hash_normal(hash32(h + 2))), s_, c_);
+        c[i] = static_cast<float32_t>(c_);
+        s[i] = static_cast<float32_t>(s_);
+        w[i] = w0;
+    }
+    this->counter_ += 3 * this->size_;
+}
+
+template <uint32_t capacity_>
+void ParticleFilter<capacity_>::predict(const Twist& twist, millisecond_t d_time) {
+    const float32_t dt = static_cast<float32_t>(second_t(d_time).get());
+    const float32_t vx = static_cast<float32_t>(twist.speed.X.get()), vy = static_cast<float32_t>(twist.speed.Y.get());
+    const float32_t w = static_cast<float32_t>(twist.ang_vel.get());
+    const float32_t speedNoise = this->speedNoise_, angVelNoise = this->angVelNoise_;
+    const uint32_t counter = this->counter_;
+
+    float32_t *const px = this->data_[this->front_][X], *const py = this->data_[this->front_][Y];
+    float32_t *const pc = this->data_[this->front_][COS], *const ps = this->data_[this->front_][SIN];
+
+    // branch-free loop body, vectorized by the compiler (the noise is a hash of the counter, not a sequential generator)
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        const uint32_t h = counter + 2 * i;
+        const float32_t v = (vx + speedNoise * detail::hash_normal(hash32(h))) * dt;
+        const float32_t a = (w + angVelNoise * detail::hash_normal(hash32(h + 1))) * dt;
+
+        // sin(a)/a, (1 - cos(a))/a, sin(a), cos(a) - see detail::arc_coeffs in odometry.hpp
+        const float32_t a2 = a * a;
+        const float32_t sinc = 1.0f - a2 * (1.0f / 6.0f) * (1.0f - a2 * (1.0f / 20.0f) * (1.0f - a2 * (1.0f / 42.0f)));
+        const float32_t cosc = a * 0.5f * (1.0f - a2 * (1.0f / 12.0f) * (1.0f - a2 * (1.0f / 30.0f)));
+        const float32_t sa = a * sinc, ca = 1.0f - a * cosc;
+
+        // displacement along the arc in the particle frame, rotated to the map frame
+        const float32_t dx = v * sinc - vy * dt * cosc, dy = v * cosc + vy * dt * sinc;
+        const float32_t c = pc[i], s = ps[i];
+        px[i] += c * dx - s * dy;
+        py[i] += s * dx + c * dy;
+
+        // rotates heading, and corrects its length to prevent drift
+        const float32_t c2 = c * ca - s * sa, s2 = s * ca + c * sa;
+        const float32_t k = 1.5f - 0.5f * (c2 * c2 + s2 * s2);
+        pc[i] = c2 * k;
+        ps[i] = s2 * k;
+    }
+    this->counter_ += 2 * this->size_;
+}
+
+template <uint32_t capacity_>
+template <typename F>
+bool ParticleFilter<capacity_>::weight(F likelihood, uint32_t numThreads) {
+    float32_t *const w = this->data_[this->front_][WEIGHT];
+    float32_t sums[detail::MAX_THREADS] = {};
+
+    // every thread processes a contiguous range of particles (aligned to 16 particles to keep the SIMD loops and cache lines aligned)
+    numThreads = detail::parallel_for(this->size_, numThreads, [this, &likelihood, &sums, w](uint32_t begin, uint32_t end, uint32_t t) {
+        const Particles particles = {
+            this->x() + begin, this->y() + begin, this->cos() + begin, this->sin() + begin, w + begin, end - begin
+        };
+        if (particles.size > 0) {
+            likelihood(particles);
+        }
+        float32_t sum = 0.0f;
+        for (uint32_t i = begin; i < end; ++i) {
+            sum += w[i];
+        }
+        sums[t] = sum;
+    }, 16);
+
+    float32_t sum = sums[0];
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        sum += sums[t];
+    }
+    return this->normalize(sum);
+}
+
+template <uint32_t capacity_>
+bool ParticleFilter<capacity_>::normalize(float32_t sum) {
+    float32_t *const w = this->data_[this->front_][WEIGHT];
+    const bool valid = sum > 0.0f && std::isfinite(sum);
+    const float32_t scale = valid ? 1.0f / sum : 0.0f;
+    const float32_t uniform = valid ? 0.0f : 1.0f / static_cast<float32_t>(bcr::max(this->size_, 1u));
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        w[i] = w[i] * scale + uniform;
+    }
+    return valid;
+}
+
+template <uint32_t capacity_>
+float32_t ParticleFilter<capacity_>::effectiveSize() const {
+    const float32_t *const w = this->weights();
+    float32_t sum2 = 0.0f;
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        sum2 += w[i] * w[i];
+    }
+    return sum2 > 0.0f ? 1.0f / sum2 : 0.0f;
+}
+
+template <uint32_t capacity_>
+void ParticleFilter<capacity_>::resample() {
+    if (this->size_ == 0) {
+        return;
+    }
+
+    const uint32_t back = 1 - this->front_;
+    const float32_t *const w = this->weights();
+    const float64_t step = 1.0 / static_cast<float64_t>(this->size_);
+
+    // the i-th selection point is (u0 + i) / n, a particle is selected as many times as many selection points fall in its weight range
+    // the cumulative sum is kept in double precision, it would lose the small weights for large particle counts otherwise
+    const float64_t u0 = static_cast<float64_t>(hash32(this->counter_++) >> 8) * (1.0 / 16777216.0) * step;
+    float64_t cumulative = w[0];
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        const float64_t u = u0 + static_cast<float64_t>(i) * step;
+        while (u > cumulative && j + 1 < this->size_) {
+            cumulative += w[++j];
+        }
+        this->indices_[i] = j;
+    }
+
+    // copies the selected particles array by array (sequential writes, the reads are mostly sequential as well)
+    for (uint32_t a = 0; a < WEIGHT; ++a) {
+        const float32_t *const src = this->data_[this->front_][a];
+        float32_t *const dst = this->data_[back][a];
+        for (uint32_t i = 0; i < this->size_; ++i) {
+            dst[i] = src[this->indices_[i]];
+        }
+    }
+    float32_t *const dstWeight = this->data_[back][WEIGHT];
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        dstWeight[i] = static_cast<float32_t>(step);
+    }
+    this->front_ = back;
+}
+
+template <uint32_t capacity_>
+Pose ParticleFilter<capacity_>::estimate() const {
+    const float32_t *const px = this->x(), *const py = this->y(), *const pc = this->cos(), *const ps = this->sin(), *const w = this->weights();
+    float64_t x = 0.0, y = 0.0, c = 0.0, s = 0.0;
+    for (uint32_t i = 0; i < this->size_; ++i) {
+        x += w[i] * px[i];
+        y += w[i] * py[i];
+        c += w[i] * pc[i];
+        s += w[i] * ps[i];
+    }
+    return { Point2m(meter_t(x), meter_t(y)), bcr::atan2(s, c) };
+}
+
+} // namespace bcr
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <babocar-core/linalg.hpp>
+
+namespace bcr {
+
+/* @brief Finds the lookahead point of a path for pure pursuit - the point where the path leaves a circle around the vehicle.
+ * The search starts from the segment of the previous lookahead point, and goes forward along the path,
+ * therefore while the vehicle follows the path, only a few segments are checked in every cycle (amortized O(1)).
+ * @tparam T Numeric type of the coordinates.
+ **/
+template <typename T>
+class PathLookahead {
+public:
+    /* @brief Constructor - starts the search from the first segment.
+     **/
+    PathLookahead() : segment_(0) {}
+
+    /* @brief Finds the lookahead point - the first exit point of the circle along the path, starting from the current segment.
+     * If found, the segment of the lookahead point becomes the current segment.
+     * @param path The path points.
+     * @param numPoints Number of path points.
+     * @param pos The position of the vehicle (the center of the circle).
+     * @param lookahead The lookahead distance (the radius of the circle).
+     * @param result The lookahead point - only written if the path leaves the circle.
+     * @returns Boolean value indicating if the lookahead point has been found
+     * (false if the rest of the path is completely inside or outside of the circle).
+     **/
+    bool find(const Point2<T> *path, uint32_t numPoints, const Point2<T>& pos, const T& lookahead, Point2<T>& result) {
+        const T r2 = lookahead * lookahead;
+        for (uint32_t i = this->segment_; i + 1 < numPoints; ++i) {
+            const Point2<T>& p1 = path[i];
+            const T dx = path[i + 1].X - p1.X, dy = path[i + 1].Y - p1.Y;
+            T t0, t1;
+            if (detail::segmentCircle_params(dx, dy, p1.X - pos.X, p1.Y - pos.Y, r2, t0, t1) && t1 >= T(0) && t1 <= T(1)) {
+                result = { p1.X + t1 * dx, p1.Y + t1 * dy };
+                this->segment_ = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* @brief Gets index of the current segment (the segment of the last found lookahead point).
+     * @returns The index of the current segment.
+     **/
+    uint32_t segment() const {
+        return this->segment_;
+    }
+
+    /* @brief Sets the segment from which the next search starts - e.g. when a new path is received.
+     * @param segment The index of the segment.
+     **/
+    void reset(uint32_t segment = 0) {
+        this->segment_ = segment;
+    }
+
+private:
+    uint32_t segment_;  // Index of the segment of the last found lookahead point.
+};
+
+} // namespace bcr
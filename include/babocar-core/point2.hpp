@@ -34,7 +34,9 @@ template <typename T> struct Point2 {
         , Y(_Y) {}
 
     static Vec2<T> normVec(radian_t angle) {
-        return Vec2<T>(T(1) * cos(angle), T(1) * sin(angle));
+        float64_t s, c;
+        bcr::sincos(angle, s, c);
+        return Vec2<T>(T(1) * c, T(1) * s);
     }
 
     /* @brief Casts point to another type.
@@ -129,7 +131,9 @@ template <typename T> struct Point2 {
     }
 
     Point2<T> rotate(radian_t angle) {
-        return this->rotate(bcr::sin(angle), bcr::cos(angle));
+        float64_t s, c;
+        bcr::sincos(angle, s, c);
+        return this->rotate(s, c);
     }
 };
 
@@ -296,5 +300,9 @@ typedef Point2<meter_t>      Point2m, Vec2m;     // meter types
 typedef Point2<centimeter_t> Point2cm, Vec2cm;   // centimeter types
 typedef Point2<m_per_sec_t>  Point2mps, Vec2mps; // meter/sec types
 
+typedef Point2<meter_f_t>      Point2m_f, Vec2m_f;     // single precision meter types
+typedef Point2<centimeter_f_t> Point2cm_f, Vec2cm_f;   // single precision centimeter types
+typedef Point2<m_per_sec_f_t>  Point2mps_f, Vec2mps_f; // single precision meter/sec types
+
 } // namespace bcr
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <babocar-core/types.hpp>
+
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Hashes 32-bit integer (lowbias32 integer hash by C. Wellons) - counter-based random numbers,
+ * that can be generated independently (e.g. in a vectorized loop) from a seed and an index.
+ * @param x The value to hash.
+ * @returns The hash value.
+ **/
+inline uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/* @brief Xorshift pseudo-random number generator - small, fast and deterministic, usable on the microcontroller as well.
+ **/
+class xorshift32 {
+public:
+    /* @brief Constructor - sets seed.
+     * @param seed The seed. Must not be 0, 0 is replaced by 1.
+     **/
+    explicit xorshift32(uint32_t seed = 2463534242u)
+        : state_(seed ? seed : 1) {}
+
+    /* @brief Generates next random number.
+     * @returns The next random number in the range [1, 2^32).
+     **/
+    uint32_t operator()() {
+        this->state_ ^= this->state_ << 13;
+        this->state_ ^= this->state_ >> 17;
+        this->state_ ^= this->state_ << 5;
+        return this->state_;
+    }
+
+    /* @brief Generates uniformly distributed random index.
+     * @param size The exclusive upper limit.
+     * @returns The random number in the range [0, size).
+     **/
+    uint32_t uniform(uint32_t size) {
+        return static_cast<uint32_t>((static_cast<uint64_t>((*this)()) * size) >> 32);
+    }
+
+    /* @brief Generates uniformly distributed random floating point number.
+     * @returns The random number in the range [0, 1).
+     **/
+    float32_t uniform01() {
+        return static_cast<float32_t>((*this)() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /* @brief Generates normally distributed random floating point number (Box-Muller transform).
+     * Only one of the two generated values is used, so the generator has no additional state.
+     * @returns The random number with zero mean and unit standard deviation.
+     **/
+    float32_t normal() {
+        const float32_t u1 = 1.0f - this->uniform01();     // (0, 1], so that the logarithm is finite
+        const float32_t u2 = this->uniform01();
+        return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318530717958647692f * u2);
+    }
+
+private:
+    uint32_t state_;
+};
+
+} // namespace bcr
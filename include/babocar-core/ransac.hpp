@@ -0,0 +1,211 @@
+#pragma once
+
+#include <babocar-core/linalg.hpp>
+#include <babocar-core/line_fit.hpp>
+#include <babocar-core/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace bcr {
+
+/* @brief RANSAC line fitting with preemptive hypothesis scoring.
+ * Hypotheses are generated in rounds. Every round scores its hypotheses on blocks of points,
+ * and after each block the worse half of the hypotheses is dropped (preemption). The surviving hypothesis is scored on all points.
+ * The number of rounds adapts to the best inlier ratio found so far, limited by the maximum number of hypotheses.
+ * The winning model is refined by total least squares fitting on its inliers.
+ * @tparam T Numeric type of the coordinates.
+ **/
+template <typename T>
+class LineRansac {
+public:
+    static constexpr uint32_t HYPOTHESES_PER_ROUND = 16;    // Number of hypotheses generated and scored together.
+    static constexpr uint32_t BLOCK_SIZE = 64;              // Number of points scored before each preemption step.
+
+    /* @brief Constructor - sets fitting parameters.
+     * @param inlierDist Maximum distance of inlier points from the line.
+     * @param minInliers Minimum number of inliers of an accepted line.
+     * @param maxHypotheses Maximum number of generated hypotheses per line.
+     * @param confidence Required probability of generating at least one outlier-free hypothesis.
+     * @param seed Seed of the random generator.
+     **/
+    LineRansac(T inlierDist, uint32_t minInliers, uint32_t maxHypotheses = 512, float32_t confidence = 0.99f, uint32_t seed = 1)
+        : inlierDist_(inlierDist)
+        , minInliers_(bcr::max(minInliers, 2u))
+        , maxHypotheses_(maxHypotheses)
+        , logFailure_(std::log(1.0f - confidence))
+        , random_(seed) {}
+
+    /* @brief Fits line to the points.
+     * @param points The points.
+     * @param numPoints Number of points.
+     * @param result The fitted line.
+     * @returns Number of inliers of the fitted line, or 0 if no line with enough inliers has been found.
+     **/
+    uint32_t fit(const Point2<T> *points, uint32_t numPoints, Line2<T>& result);
+
+    /* @brief Extracts multiple lines sequentially - after a line has been found, its inliers are removed and the search continues.
+     * @note The points are reordered: the inliers of the n-th line are moved to the end of the remaining range.
+     * @param points The points.
+     * @param numPoints Number of points.
+     * @param lines The extracted lines.
+     * @param numInliers The number of inliers of the extracted lines. Inliers of the first line are the last numInliers[0] points.
+     * @param maxLines Maximum number of lines to extract.
+     * @returns Number of extracted lines.
+     **/
+    uint32_t extract(Point2<T> *points, uint32_t numPoints, Line2<T> *lines, uint32_t *numInliers, uint32_t maxLines);
+
+private:
+    static uint32_t gcd(uint32_t a, uint32_t b) {
+        return b ? gcd(b, a % b) : a;
+    }
+
+    uint32_t countInliers(const Line2<T>& line, const Point2<T> *points, uint32_t numPoints) const;
+
+    Line2<T> refine(const Line2<T>& line, const Point2<T> *points, uint32_t numPoints) const;
+
+    const T inlierDist_;
+    const uint32_t minInliers_;
+    const uint32_t maxHypotheses_;
+    const float32_t logFailure_;
+    xorshift32 random_;
+};
+
+template <typename T> constexpr uint32_t LineRansac<T>::HYPOTHESES_PER_ROUND;
+template <typename T> constexpr uint32_t LineRansac<T>::BLOCK_SIZE;
+
+template <typename T>
+uint32_t LineRansac<T>::fit(const Point2<T> *points, uint32_t numPoints, Line2<T>& result) {
+    if (numPoints < this->minInliers_) {
+        return 0;
+    }
+
+    // points are scored in a strided order, so that the blocks are not spatially coherent for ordered scans
+    uint32_t stride = 7919 % numPoints;
+    while (gcd(stride, numPoints) != 1) {
+        ++stride;
+    }
+
+    Line2<T> hypotheses[HYPOTHESES_PER_ROUND];
+    uint32_t scores[HYPOTHESES_PER_ROUND];
+    uint32_t order[HYPOTHESES_PER_ROUND];
+
+    Line2<T> best = result;
+    uint32_t bestInliers = 0;
+    uint32_t requiredHypotheses = this->maxHypotheses_;
+
+    for (uint32_t numHypotheses = 0; numHypotheses < requiredHypotheses; numHypotheses += HYPOTHESES_PER_ROUND) {
+
+        for (uint32_t h = 0; h < HYPOTHESES_PER_ROUND; ++h) {
+            const Point2<T>& p1 = points[this->random_.uniform(numPoints)];
+            const Point2<T>& p2 = points[this->random_.uniform(numPoints)];
+            hypotheses[h].a = p1.Y - p2.Y;
+            hypotheses[h].b = p2.X - p1.X;
+            hypotheses[h].c = p1.X * p2.Y - p2.X * p1.Y;
+
+            const T norm = hypotheses[h].normFactor();
+            if (norm > T(0)) {
+                hypotheses[h].a /= norm;
+                hypotheses[h].b /= norm;
+                hypotheses[h].c /= norm;
+            } else {
+                hypotheses[h].a = hypotheses[h].b = T(0);   // degenerate sample, will not have any inliers
+                hypotheses[h].c = T(1);
+            }
+            scores[h] = 0;
+            order[h] = h;
+        }
+
+        // preemptive scoring - halves the number of hypotheses after each block
+        uint32_t numAlive = HYPOTHESES_PER_ROUND;
+        uint32_t idx = 0;
+        for (uint32_t scored = 0; numAlive > 1 && scored < numPoints; scored += BLOCK_SIZE) {
+            const uint32_t blockSize = bcr::min(BLOCK_SIZE, numPoints - scored);
+
+            for (uint32_t i = 0; i < blockSize; ++i) {
+                const Point2<T>& p = points[idx];
+                for (uint32_t k = 0; k < numAlive; ++k) {
+                    const Line2<T>& l = hypotheses[order[k]];
+                    scores[order[k]] += bcr::abs(l.a * p.X + l.b * p.Y + l.c) <= this->inlierDist_ ? 1 : 0;
+                }
+                idx = (idx + stride) % numPoints;
+            }
+
+            std::partial_sort(order, order + numAlive / 2, order + numAlive, [&scores](uint32_t h1, uint32_t h2) {
+                return scores[h1] > scores[h2];
+            });
+            numAlive /= 2;
+        }
+
+        const Line2<T>& winner = hypotheses[order[0]];
+        const uint32_t numInliers = this->countInliers(winner, points, numPoints);
+        if (numInliers > bestInliers) {
+            best = winner;
+            bestInliers = numInliers;
+
+            // adaptive number of hypotheses: log(1 - p) / log(1 - w^2)
+            const float32_t w = static_cast<float32_t>(numInliers) / numPoints;
+            const float32_t logOutlierSample = std::log(1.0f - w * w);
+            if (logOutlierSample < 0.0f) {
+                requiredHypotheses = bcr::min(this->maxHypotheses_, static_cast<uint32_t>(std::ceil(this->logFailure_ / logOutlierSample)));
+            }
+        }
+    }
+
+    if (bestInliers >= this->minInliers_) {
+        result = this->refine(best, points, numPoints);
+        bestInliers = this->countInliers(result, points, numPoints);
+    }
+
+    return bestInliers >= this->minInliers_ ? bestInliers : 0;
+}
+
+template <typename T>
+uint32_t LineRansac<T>::extract(Point2<T> *points, uint32_t numPoints, Line2<T> *lines, uint32_t *numInliers, uint32_t maxLines) {
+    uint32_t numLines = 0;
+    uint32_t remaining = numPoints;
+
+    while (numLines < maxLines) {
+        Line2<T>& line = lines[numLines];
+        if (!this->fit(points, remaining, line)) {
+            break;
+        }
+
+        // moves inliers to the end of the remaining range
+        uint32_t end = remaining;
+        for (uint32_t i = 0; i < end;) {
+            if (distanceNorm(line, points[i]) <= this->inlierDist_) {
+                std::swap(points[i], points[--end]);
+            } else {
+                ++i;
+            }
+        }
+
+        numInliers[numLines++] = remaining - end;
+        remaining = end;
+    }
+
+    return numLines;
+}
+
+template <typename T>
+uint32_t LineRansac<T>::countInliers(const Line2<T>& line, const Point2<T> *points, uint32_t numPoints) const {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        count += bcr::abs(line.a * points[i].X + line.b * points[i].Y + line.c) <= this->inlierDist_ ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+Line2<T> LineRansac<T>::refine(const Line2<T>& line, const Point2<T> *points, uint32_t numPoints) const {
+    LineFitAccumulator<T> fit;
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        if (distanceNorm(line, points[i]) <= this->inlierDist_) {
+            fit.add(points[i]);
+        }
+    }
+    return fit.line();
+}
+
+} // namespace bcr
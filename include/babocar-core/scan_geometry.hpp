@@ -0,0 +1,164 @@
+#pragma once
+
+#include <babocar-core/se2.hpp>
+
+namespace bcr {
+
+/* @brief Geometry of a laser scan with fixed angle increments.
+ * The unit vectors of the beams are calculated once, so the conversion of a range array to points
+ * only needs multiplications (and the rotation of the unit vectors when the points are transformed to another frame).
+ * Beams with invalid ranges (NaN, shorter than the minimum range, or not shorter than the maximum range) are filtered in the same pass.
+ * @tparam maxBeams_ Maximum number of beams.
+ **/
+template <uint32_t maxBeams_>
+class ScanGeometry {
+public:
+    /* @brief Constructor - calculates unit vectors of the beams.
+     * @param angleMin Angle of the first beam.
+     * @param angleIncrement Angle between consecutive beams.
+     * @param numBeams Number of beams. Limited by maxBeams_.
+     * @param rangeMin Minimum valid range.
+     * @param rangeMax Maximum range - ranges that are not shorter are treated as no-return.
+     **/
+    ScanGeometry(radian_t angleMin, radian_t angleIncrement, uint32_t numBeams, meter_t rangeMin, meter_t rangeMax)
+        : angleMin_(angleMin)
+        , angleIncrement_(angleIncrement)
+        , numBeams_(bcr::min(numBeams, maxBeams_))
+        , rangeMin_(static_cast<float32_t>(rangeMin.get()))
+        , rangeMax_(static_cast<float32_t>(rangeMax.get())) {
+
+        for (uint32_t i = 0; i < this->numBeams_; ++i) {
+            float64_t s, c;
+            bcr::sincos(this->angle(i), s, c);
+            this->ux_[i] = static_cast<float32_t>(c);
+            this->uy_[i] = static_cast<float32_t>(s);
+        }
+    }
+
+    /* @brief Gets number of beams.
+     * @returns The number of beams.
+     **/
+    uint32_t size() const { return this->numBeams_; }
+
+    /* @brief Gets angle of a beam.
+     * @param beam The beam index.
+     * @returns The angle of the beam.
+     **/
+    radian_t angle(uint32_t beam) const {
+        return this->angleMin_ + this->angleIncrement_ * static_cast<float64_t>(beam);
+    }
+
+    /* @brief Converts ranges to points in the sensor frame.
+     * @param ranges The ranges of all beams in meters.
+     * @param points The points - must have space for all beams.
+     * @param beams The beam indexes of the points - optional, must have space for all beams.
+     * @returns Number of valid points.
+     **/
+    template <typename T>
+    uint32_t toPoints(const float32_t *ranges, Point2<T> *points, uint32_t *beams = nullptr) const {
+        return this->convert<false>(ranges, SE2f(), beams, [points](uint32_t n, float32_t x, float32_t y) {
+            points[n].X = from_underlying<T>(x);
+            points[n].Y = from_underlying<T>(y);
+        });
+    }
+
+    /* @brief Converts ranges to points, and transforms them to another frame.
+     * @param ranges The ranges of all beams in meters.
+     * @param transform The transform from the sensor frame to the result frame (in meters).
+     * @param points The points - must have space for all beams.
+     * @param beams The beam indexes of the points - optional, must have space for all beams.
+     * @returns Number of valid points.
+     **/
+    template <typename T>
+    uint32_t toPoints(const float32_t *ranges, const SE2f& transform, Point2<T> *points, uint32_t *beams = nullptr) const {
+        return this->convert<true>(ranges, transform, beams, [points](uint32_t n, float32_t x, float32_t y) {
+            points[n].X = from_underlying<T>(x);
+            points[n].Y = from_underlying<T>(y);
+        });
+    }
+
+    /* @brief Converts ranges to points, and transforms them to the frame in which the pose of the sensor is given.
+     * @param ranges The ranges of all beams in meters.
+     * @param pose The pose of the sensor.
+     * @param points The points - must have space for all beams.
+     * @param beams The beam indexes of the points - optional, must have space for all beams.
+     * @returns Number of valid points.
+     **/
+    template <typename T>
+    uint32_t toPoints(const float32_t *ranges, const Pose& pose, Point2<T> *points, uint32_t *beams = nullptr) const {
+        return this->toPoints(ranges, SE2f(pose), points, beams);
+    }
+
+    /* @brief Converts ranges to point coordinates (structure of arrays), and transforms them to another frame.
+     * @param ranges The ranges of all beams in meters.
+     * @param transform The transform from the sensor frame to the result frame (in meters).
+     * @param x The X coordinates of the points - must have space for all beams.
+     * @param y The Y coordinates of the points - must have space for all beams.
+     * @param beams The beam indexes of the points - optional, must have space for all beams.
+     * @returns Number of valid points.
+     **/
+    template <typename T>
+    uint32_t toPoints(const float32_t *ranges, const SE2f& transform, T *x, T *y, uint32_t *beams = nullptr) const {
+        return this->convert<true>(ranges, transform, beams, [x, y](uint32_t n, float32_t x_, float32_t y_) {
+            x[n] = from_underlying<T>(x_);
+            y[n] = from_underlying<T>(y_);
+        });
+    }
+
+    /* @brief Converts ranges to point coordinates (structure of arrays) in the sensor frame.
+     * @param ranges The ranges of all beams in meters.
+     * @param x The X coordinates of the points - must have space for all beams.
+     * @param y The Y coordinates of the points - must have space for all beams.
+     * @param beams The beam indexes of the points - optional, must have space for all beams.
+     * @returns Number of valid points.
+     **/
+    template <typename T>
+    uint32_t toPoints(const float32_t *ranges, T *x, T *y, uint32_t *beams = nullptr) const {
+        return this->convert<false>(ranges, SE2f(), beams, [x, y](uint32_t n, float32_t x_, float32_t y_) {
+            x[n] = from_underlying<T>(x_);
+            y[n] = from_underlying<T>(y_);
+        });
+    }
+
+private:
+    template <bool transformed, typename F>
+    uint32_t convert(const float32_t *ranges, const SE2f& transform, uint32_t *beams, F write) const;
+
+    const radian_t angleMin_;           // Angle of the first beam.
+    const radian_t angleIncrement_;     // Angle between consecutive beams.
+    const uint32_t numBeams_;           // Number of beams.
+    const float32_t rangeMin_;          // Minimum valid range in meters.
+    const float32_t rangeMax_;          // Maximum range in meters.
+    float32_t ux_[maxBeams_];           // X coordinates of the unit vectors of the beams.
+    float32_t uy_[maxBeams_];           // Y coordinates of the unit vectors of the beams.
+};
+
+template <uint32_t maxBeams_>
+template <bool transformed, typename F>
+uint32_t ScanGeometry<maxBeams_>::convert(const float32_t *ranges, const SE2f& transform, uint32_t *beams, F write) const {
+    const float32_t c = transform.cos(), s = transform.sin();
+    const float32_t tx = transform.translation().X, ty = transform.translation().Y;
+
+    // every beam is written to the next output slot, which is only kept (by incrementing the counter) if the range is valid
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < this->numBeams_; ++i) {
+        const float32_t r = ranges[i];
+        const bool valid = r >= this->rangeMin_ && r < this->rangeMax_;
+
+        float32_t ux = this->ux_[i], uy = this->uy_[i];
+        if (transformed) {
+            const float32_t rx = c * ux - s * uy;
+            uy = s * ux + c * uy;
+            ux = rx;
+        }
+
+        write(n, r * ux + (transformed ? tx : 0.0f), r * uy + (transformed ? ty : 0.0f));
+        if (beams) {
+            beams[n] = i;
+        }
+        n += valid ? 1 : 0;
+    }
+    return n;
+}
+
+} // namespace bcr
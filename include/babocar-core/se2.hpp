@@ -0,0 +1,184 @@
+#pragma once
+
+#include <babocar-core/line2.hpp>
+#include <babocar-core/pose.hpp>
+
+namespace bcr {
+
+/* @brief 2-dimensional rigid transform (rotation followed by translation), with cached cosine and sine of the rotation angle.
+ * Composition, inversion and application do not need any trigonometric function calls,
+ * sine and cosine are only calculated when the transform is created from an angle.
+ * @tparam T Numeric type of the coordinates - arithmetic type or unit class (e.g. meter_t).
+ **/
+template <typename T>
+class SE2 {
+public:
+    typedef decltype(underlying_value(std::declval<T>())) value_type;   // Underlying value type of the coordinates, used for the rotation.
+
+    /* @brief Default constructor - creates identity transform.
+     **/
+    SE2()
+        : t_(from_underlying<T>(0), from_underlying<T>(0))
+        , cos_(1)
+        , sin_(0) {}
+
+    /* @brief Constructor - sets translation and rotation angle.
+     * @param translation The translation.
+     * @param angle The rotation angle.
+     **/
+    SE2(const Point2<T>& translation, radian_t angle)
+        : t_(translation) {
+        float64_t s, c;
+        bcr::sincos(angle, s, c);
+        this->cos_ = static_cast<value_type>(c);
+        this->sin_ = static_cast<value_type>(s);
+    }
+
+    /* @brief Constructor - sets translation and rotation.
+     * @restrict cos^2 + sin^2 must be 1.
+     * @param translation The translation.
+     * @param cos The cosine of the rotation angle.
+     * @param sin The sine of the rotation angle.
+     **/
+    SE2(const Point2<T>& translation, value_type cos, value_type sin)
+        : t_(translation)
+        , cos_(cos)
+        , sin_(sin) {}
+
+    /* @brief Constructor - creates transform from pose. The transform maps points from the frame of the pose to the parent frame.
+     * @param pose The pose.
+     **/
+    explicit SE2(const Pose& pose)
+        : SE2(static_cast<Point2<T>>(pose.pos), pose.angle) {}
+
+    /* @brief Converts transform to pose.
+     * @returns The pose.
+     **/
+    Pose toPose() const {
+        return { static_cast<Point2m>(this->t_), this->angle() };
+    }
+
+    const Point2<T>& translation() const { return this->t_; }
+    value_type cos() const { return this->cos_; }
+    value_type sin() const { return this->sin_; }
+
+    /* @brief Gets rotation angle.
+     * @returns The rotation angle in the range [-PI, PI].
+     **/
+    radian_t angle() const {
+        return bcr::atan2(this->sin_, this->cos_);
+    }
+
+    /* @brief Rotates vector (without translation).
+     * @param v The vector.
+     * @returns The rotated vector.
+     **/
+    Vec2<T> rotate(const Vec2<T>& v) const {
+        return Vec2<T>(this->cos_ * v.X - this->sin_ * v.Y, this->sin_ * v.X + this->cos_ * v.Y);
+    }
+
+    /* @brief Applies transform to a point.
+     * @param p The point.
+     * @returns The transformed point.
+     **/
+    Point2<T> apply(const Point2<T>& p) const {
+        return Point2<T>(this->cos_ * p.X - this->sin_ * p.Y + this->t_.X, this->sin_ * p.X + this->cos_ * p.Y + this->t_.Y);
+    }
+
+    /* @brief Applies transform to a line.
+     * @param line The line, in the underlying unit of the coordinates.
+     * @returns The transformed line.
+     **/
+    Line2<value_type> apply(const Line2<value_type>& line) const {
+        const value_type a = this->cos_ * line.a - this->sin_ * line.b;
+        const value_type b = this->sin_ * line.a + this->cos_ * line.b;
+        return Line2<value_type>(a, b, line.c - a * underlying_value(this->t_.X) - b * underlying_value(this->t_.Y));
+    }
+
+    /* @brief Applies transform to multiple points (array of structures).
+     * @param points The points.
+     * @param result The transformed points, may be the same as the input.
+     * @param size Number of points.
+     **/
+    void apply(const Point2<T> *points, Point2<T> *result, uint32_t size) const;
+
+    /* @brief Applies transform to multiple points (structure of arrays).
+     * @param x The X coordinates of the points.
+     * @param y The Y coordinates of the points.
+     * @param resultX The X coordinates of the transformed points, may be the same as the input.
+     * @param resultY The Y coordinates of the transformed points, may be the same as the input.
+     * @param size Number of points.
+     **/
+    void apply(const T *x, const T *y, T *resultX, T *resultY, uint32_t size) const;
+
+    /* @brief Composes transforms - the result applies the other transform first, then this one.
+     * The rotation of the result is renormalized (first order Newton step of 1/sqrt), so the rounding errors of the cosine and sine
+     * do not accumulate when transforms are composed repeatedly (e.g. in chain() or in iterative scan matching).
+     * @param other The other transform.
+     * @returns The composed transform.
+     **/
+    SE2 compose(const SE2& other) const {
+        const value_type c = this->cos_ * other.cos_ - this->sin_ * other.sin_;
+        const value_type s = this->sin_ * other.cos_ + this->cos_ * other.sin_;
+        const value_type k = (value_type(3) - (c * c + s * s)) / value_type(2);
+        return SE2(this->apply(other.t_), c * k, s * k);
+    }
+
+    SE2 operator*(const SE2& other) const {
+        return this->compose(other);
+    }
+
+    /* @brief Calculates inverse transform.
+     * @returns The inverse transform.
+     **/
+    SE2 inverse() const {
+        return SE2(Point2<T>(-(this->cos_ * this->t_.X + this->sin_ * this->t_.Y), this->sin_ * this->t_.X - this->cos_ * this->t_.Y),
+            this->cos_, -this->sin_);
+    }
+
+    /* @brief Composes chain of transforms, e.g. world <- base <- sensor.
+     * @param transforms The transforms, from the outermost (e.g. base in world) to the innermost (e.g. sensor in base) frame.
+     * @param size Number of transforms.
+     * @returns The composed transform, identity if the chain is empty.
+     **/
+    static SE2 chain(const SE2 *transforms, uint32_t size) {
+        SE2 result;
+        for (uint32_t i = 0; i < size; ++i) {
+            result = result.compose(transforms[i]);
+        }
+        return result;
+    }
+
+private:
+    Point2<T> t_;       // The translation.
+    value_type cos_;    // Cosine of the rotation angle.
+    value_type sin_;    // Sine of the rotation angle.
+};
+
+template <typename T>
+void SE2<T>::apply(const Point2<T> *points, Point2<T> *result, uint32_t size) const {
+    const value_type c = this->cos_, s = this->sin_;
+    const T tx = this->t_.X, ty = this->t_.Y;
+    for (uint32_t i = 0; i < size; ++i) {
+        const T x = points[i].X, y = points[i].Y;
+        result[i].X = c * x - s * y + tx;
+        result[i].Y = s * x + c * y + ty;
+    }
+}
+
+template <typename T>
+void SE2<T>::apply(const T *x, const T *y, T *resultX, T *resultY, uint32_t size) const {
+    const value_type c = this->cos_, s = this->sin_;
+    const T tx = this->t_.X, ty = this->t_.Y;
+    for (uint32_t i = 0; i < size; ++i) {
+        const T x_ = x[i], y_ = y[i];
+        resultX[i] = c * x_ - s * y_ + tx;
+        resultY[i] = s * x_ + c * y_ + ty;
+    }
+}
+
+typedef SE2<float32_t> SE2f;    // 32-bit floating point transform.
+typedef SE2<float64_t> SE2d;    // 64-bit floating point transform.
+typedef SE2<meter_t>   SE2m;    // Transform of meter coordinates.
+
+} // namespace bcr
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <babocar-core/line_fit.hpp>
+
+#include <cmath>
+
+namespace bcr {
+
+/* @brief Split-and-merge line segment extraction from ordered scan points.
+ * The points are first cut into chunks at the gaps between consecutive points (one pass). Every chunk is split recursively
+ * at the point farthest from the chord of its range, until all points are close enough to the chord. The recursion is iterative,
+ * with a fixed-size stack of pending ranges, and the segments are produced in scan order - so a new segment is merged
+ * with the previous one if they are adjacent and their common total least squares fit is good enough.
+ * Pieces shorter than the minimum number of points (e.g. split off at noisy points) are only kept if they can be merged.
+ * The fit of the previous segment is kept in a LineFitAccumulator, so merging costs O(1). No dynamic allocation is performed.
+ * @tparam T Numeric type of the coordinates - arithmetic type or unit class (e.g. meter_t).
+ **/
+template <typename T>
+class SegmentExtractor {
+public:
+    typedef decltype(underlying_value(std::declval<T>())) value_type;   // Underlying value type of the coordinates.
+
+    static constexpr uint32_t MAX_DEPTH = 32;   // Maximum depth of the split recursion - deeper ranges are not split.
+
+    struct Segment {
+        Point2<T> start;            // Projection of the first point onto the line.
+        Point2<T> end;              // Projection of the last point onto the line.
+        Line2<value_type> line;     // Total least squares line of the points.
+        T residual;                 // Root mean square distance of the points from the line.
+        uint32_t first;             // Index of the first point of the segment.
+        uint32_t last;              // Index of the last point of the segment (inclusive).
+    };
+
+    /* @brief Constructor - sets extraction parameters.
+     * @param splitDist Ranges with points farther than this distance from their chord are split.
+     * @param mergeResidual Adjacent segments are merged if the residual of their common fit is below this value.
+     * @param maxGap Consecutive points farther than this distance from each other never belong to the same segment.
+     * @param minPoints Minimum number of points of a new segment - shorter pieces are dropped, unless they are merged with the previous segment.
+     **/
+    SegmentExtractor(T splitDist, T mergeResidual, T maxGap, uint32_t minPoints = 4)
+        : splitDist2_(underlying_value(splitDist) * underlying_value(splitDist))
+        , mergeResidual_(mergeResidual)
+        , maxGap2_(underlying_value(maxGap) * underlying_value(maxGap))
+        , minPoints_(bcr::max(minPoints, 2u)) {}
+
+    /* @brief Extracts line segments from ordered points.
+     * @param points The points, ordered along the scan.
+     * @param numPoints Number of points.
+     * @param segments The extracted segments, in scan order. The point ranges of the segments do not overlap.
+     * @param maxSegments Maximum number of segments to extract - the rest of the points is ignored if the limit is reached.
+     * @returns Number of extracted segments.
+     **/
+    uint32_t extract(const Point2<T> *points, uint32_t numPoints, Segment *segments, uint32_t maxSegments);
+
+private:
+    // splits the range [first, last] recursively, and adds the segments
+    void split(const Point2<T> *points, uint32_t first, uint32_t last, Segment *segments, uint32_t& numSegments, uint32_t maxSegments);
+
+    // finds the point of the range farthest from its chord, returns the squared distance
+    value_type farthest(const Point2<T> *points, uint32_t first, uint32_t last, uint32_t& idx) const;
+
+    // merges a range with the previous segment if they are adjacent in the same chunk, or adds it as a new segment if it has enough points
+    void add(const Point2<T> *points, uint32_t first, uint32_t last, bool mergeable, Segment *segments, uint32_t& numSegments);
+
+    // sets the line, the endpoints and the residual of a segment from its fit
+    static void finish(const Point2<T> *points, const LineFitAccumulator<T>& fit, Segment& segment);
+
+    const value_type splitDist2_;       // Squared split distance.
+    const T mergeResidual_;             // Maximum residual of merged segments.
+    const value_type maxGap2_;          // Squared maximum distance of consecutive points.
+    const uint32_t minPoints_;          // Minimum number of points of a segment.
+    LineFitAccumulator<T> previous_;    // Line fit of the previous segment.
+};
+
+template <typename T> constexpr uint32_t SegmentExtractor<T>::MAX_DEPTH;
+
+template <typename T>
+uint32_t SegmentExtractor<T>::extract(const Point2<T> *points, uint32_t numPoints, Segment *segments, uint32_t maxSegments) {
+    uint32_t numSegments = 0;
+    uint32_t first = 0;
+    for (uint32_t i = 1; i <= numPoints && numSegments < maxSegments; ++i) {
+        if (i < numPoints) {
+            const value_type dx = underlying_value(points[i].X - points[i - 1].X), dy = underlying_value(points[i].Y - points[i - 1].Y);
+            if (dx * dx + dy * dy <= this->maxGap2_) {
+                continue;
+            }
+        }
+        if (i - first >= this->minPoints_) {
+            this->split(points, first, i - 1, segments, numSegments, maxSegments);
+        }
+        first = i;
+    }
+    return numSegments;
+}
+
+template <typename T>
+void SegmentExtractor<T>::split(const Point2<T> *points, uint32_t first, uint32_t last, Segment *segments, uint32_t& numSegments, uint32_t maxSegments) {
+    // the left part of a split range is processed first, the end of the right part is pushed to the stack
+    uint32_t stack[MAX_DEPTH];
+    uint32_t depth = 0;
+    const uint32_t chunkFirst = first;
+
+    while (numSegments < maxSegments) {
+        uint32_t idx;
+        if (last - first + 1 > 2 && depth < MAX_DEPTH && this->farthest(points, first, last, idx) > this->splitDist2_) {
+            stack[depth++] = last;
+            last = idx;
+            continue;
+        }
+
+        this->add(points, first, last, first != chunkFirst, segments, numSegments);
+        if (depth == 0) {
+            break;
+        }
+        first = last + 1;
+        last = stack[--depth];
+    }
+}
+
+template <typename T>
+typename SegmentExtractor<T>::value_type SegmentExtractor<T>::farthest(const Point2<T> *points,
+    uint32_t first, uint32_t last, uint32_t& idx) const {
+
+    const value_type ax = underlying_value(points[first].X), ay = underlying_value(points[first].Y);
+    const value_type dx = underlying_value(points[last].X) - ax, dy = underlying_value(points[last].Y) - ay;
+    const value_type len2 = dx * dx + dy * dy;
+
+    // the distance from the chord is |cross(d, p - a)| / |d|, the maximum is searched for the cross product
+    // if the endpoints coincide, the distance from the first point is used
+    value_type best = value_type(0);
+    idx = first + 1;
+    for (uint32_t i = first + 1; i < last; ++i) {
+        const value_type px = underlying_value(points[i].X) - ax, py = underlying_value(points[i].Y) - ay;
+        const value_type cross = dx * py - dy * px;
+        const value_type d2 = len2 > value_type(0) ? cross * cross : px * px + py * py;
+        if (d2 > best) {
+            best = d2;
+            idx = i;
+        }
+    }
+    return len2 > value_type(0) ? best / len2 : best;
+}
+
+template <typename T>
+void SegmentExtractor<T>::add(const Point2<T> *points, uint32_t first, uint32_t last, bool mergeable, Segment *segments, uint32_t& numSegments) {
+    LineFitAccumulator<T> fit;
+    for (uint32_t i = first; i <= last; ++i) {
+        fit.add(points[i]);
+    }
+
+    if (mergeable && numSegments > 0 && segments[numSegments - 1].last + 1 == first) {
+        LineFitAccumulator<T> merged = this->previous_;
+        merged.add(fit);
+        if (merged.residual() <= this->mergeResidual_) {
+            this->previous_ = merged;
+            segments[numSegments - 1].last = last;
+            finish(points, merged, segments[numSegments - 1]);
+            return;
+        }
+    }
+
+    if (last - first + 1 < this->minPoints_) {
+        return;
+    }
+
+    this->previous_ = fit;
+    segments[numSegments].first = first;
+    segments[numSegments].last = last;
+    finish(points, fit, segments[numSegments]);
+    ++numSegments;
+}
+
+template <typename T>
+void SegmentExtractor<T>::finish(const Point2<T> *points, const LineFitAccumulator<T>& fit, Segment& segment) {
+    const Line2<value_type> line = fit.line();
+    auto project = [&line](const Point2<T>& p) {
+        const value_type x = underlying_value(p.X), y = underlying_value(p.Y);
+        const value_type d = line.a * x + line.b * y + line.c;
+        return Point2<T>(from_underlying<T>(x - d * line.a), from_underlying<T>(y - d * line.b));
+    };
+
+    segment.line = line;
+    segment.start = project(points[segment.first]);
+    segment.end = project(points[segment.last]);
+    segment.residual = fit.residual();
+}
+
+} // namespace bcr
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <babocar-core/point2.hpp>
+#include <babocar-core/container/vec.hpp>
+
+#include <stddef.h>
+
+namespace bcr {
+
+/* @brief Fixed-capacity K-means clustering - heap-free variant of KMeans.
+ * Groups are stored as centers and per-point labels instead of member lists, so memory usage does not depend on the group sizes.
+ * One run takes at most maxIterations_ * maxPoints_ * maxGroups_ distance calculations.
+ * run() has fixed-size stack frames and no recursion. Its worst-case stack usage in a given build is the sum of the frames on its call path
+ * (run(), getGroup() and memset() with optimization), which the compiler reports in the .su files generated with -fstack-usage.
+ * @tparam maxPoints_ Maximum number of points.
+ * @tparam maxGroups_ Maximum number of groups.
+ * @tparam maxIterations_ Maximum number of iterations.
+ **/
+template <uint32_t maxPoints_, uint32_t maxGroups_, uint32_t maxIterations_ = 20>
+class StaticKMeans {
+public:
+    typedef typename min_uint<maxGroups_>::type label_type;
+    typedef vec<Point2m, maxPoints_> points_type;
+    typedef vec<Point2m, maxGroups_> centers_type;
+
+    static constexpr label_type NO_GROUP = static_cast<label_type>(maxGroups_); // Label of points that do not belong to any group.
+
+    /* @brief Gets worst-case static memory usage of an instance.
+     * @returns The static memory usage in bytes (excluding the input points).
+     **/
+    static constexpr size_t staticMemory() { return sizeof(StaticKMeans); }
+
+    /* @brief Constructor - stores reference to the values.
+     * @param values_ The values to cluster. Must outlive the run.
+     **/
+    explicit StaticKMeans(const points_type& values_)
+        : values_(values_) {}
+
+    /* @brief Runs clustering.
+     * @param numGroups Number of groups to create. Limited by maxGroups_ and the number of points.
+     * @returns Number of iterations executed.
+     **/
+    uint32_t run(uint32_t numGroups);
+
+    /* @brief Gets group centers.
+     * @returns The group centers.
+     **/
+    const centers_type& centers() const { return this->centers_; }
+
+    /* @brief Gets group label of a point.
+     * @param idx Index of the point.
+     * @returns The group label of the point.
+     **/
+    label_type label(uint32_t idx) const { return this->labels_[idx]; }
+
+    /* @brief Gets number of members of a group.
+     * @param group The group label.
+     * @returns The number of members of the group, 0 for NO_GROUP.
+     **/
+    uint32_t groupSize(label_type group) const { return group < maxGroups_ ? this->sizes_[group] : 0; }
+
+    /* @brief Gets members of a group.
+     * @param group The group label.
+     * @param result The result vector.
+     * @returns Number of members copied to the result vector.
+     **/
+    template <uint32_t capacity>
+    uint32_t getMembers(label_type group, vec<Point2m, capacity>& result) const;
+
+private:
+    label_type getGroup(const Point2m& value) const;
+
+    const points_type& values_;
+    centers_type centers_;
+    Point2m sums_[maxGroups_];
+    uint32_t sizes_[maxGroups_];
+    label_type labels_[maxPoints_];
+};
+
+template <uint32_t maxPoints_, uint32_t maxGroups_, uint32_t maxIterations_>
+constexpr typename StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::label_type StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::NO_GROUP;
+
+template <uint32_t maxPoints_, uint32_t maxGroups_, uint32_t maxIterations_>
+uint32_t StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::run(uint32_t numGroups) {
+    const uint32_t numPoints = this->values_.size();
+    numGroups = bcr::min(bcr::min(numGroups, maxGroups_), numPoints);
+
+    // initial centers are spread evenly over the input
+    this->centers_.clear();
+    for (uint32_t g = 0; g < numGroups; ++g) {
+        this->centers_.append(this->values_[g * numPoints / numGroups]);
+    }
+
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        this->labels_[i] = NO_GROUP;
+    }
+    for (uint32_t g = 0; g < maxGroups_; ++g) {
+        this->sizes_[g] = 0;
+    }
+
+    uint32_t iter = 0;
+    bool changed = numGroups > 0;
+    while (changed && iter < maxIterations_) {
+        ++iter;
+        changed = false;
+
+        for (uint32_t g = 0; g < numGroups; ++g) {
+            this->sums_[g] = Point2m(meter_t::ZERO(), meter_t::ZERO());
+            this->sizes_[g] = 0;
+        }
+
+        for (uint32_t i = 0; i < numPoints; ++i) {
+            const label_type g = this->getGroup(this->values_[i]);
+            changed |= g != this->labels_[i];
+            this->labels_[i] = g;
+            this->sums_[g] += this->values_[i];
+            ++this->sizes_[g];
+        }
+
+        for (uint32_t g = 0; g < numGroups; ++g) {
+            if (this->sizes_[g]) {
+                this->centers_[g] = this->sums_[g] / this->sizes_[g];
+            }
+        }
+    }
+
+    return iter;
+}
+
+template <uint32_t maxPoints_, uint32_t maxGroups_, uint32_t maxIterations_>
+template <uint32_t capacity>
+uint32_t StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::getMembers(label_type group, vec<Point2m, capacity>& result) const {
+    uint32_t num = 0;
+    for (uint32_t i = 0; i < this->values_.size(); ++i) {
+        if (this->labels_[i] == group) {
+            num += result.append(this->values_[i]);
+        }
+    }
+    return num;
+}
+
+template <uint32_t maxPoints_, uint32_t maxGroups_, uint32_t maxIterations_>
+typename StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::label_type StaticKMeans<maxPoints_, maxGroups_, maxIterations_>::getGroup(const Point2m& value) const {
+    label_type minIdx = 0;
+    float64_t minDist = pythag_square((this->centers_[0].X - value.X).get(), (this->centers_[0].Y - value.Y).get());
+    for (uint32_t g = 1; g < this->centers_.size(); ++g) {
+        const float64_t dist = pythag_square((this->centers_[g].X - value.X).get(), (this->centers_[g].Y - value.Y).get());
+        if (dist < minDist) {
+            minDist = dist;
+            minIdx = static_cast<label_type>(g);
+        }
+    }
+    return minIdx;
+}
+
+/* @brief Fixed-capacity threshold clustering - heap-free variant of KMeans2.
+ * Points closer than the threshold distance to any member of a group are added to the group (transitively).
+ * One run takes at most maxPoints_ * maxPoints_ / 2 distance calculations.
+ * The stack usage of run() is bounded the same way as in StaticKMeans - with optimization it calls no other functions.
+ * @tparam maxPoints_ Maximum number of points.
+ * @tparam maxGroups_ Maximum number of groups. Points that do not fit into any group are labeled as NO_GROUP.
+ **/
+template <uint32_t maxPoints_, uint32_t maxGroups_>
+class StaticKMeans2 {
+public:
+    typedef typename min_uint<maxGroups_>::type label_type;
+    typedef typename min_uint<maxPoints_>::type index_type;
+    typedef vec<Point2m, maxPoints_> points_type;
+
+    static constexpr label_type NO_GROUP = static_cast<label_type>(maxGroups_); // Label of points that do not belong to any group.
+
+    /* @brief Gets worst-case static memory usage of an instance.
+     * @returns The static memory usage in bytes (excluding the input points).
+     **/
+    static constexpr size_t staticMemory() { return sizeof(StaticKMeans2); }
+
+    /* @brief Constructor - stores reference to the values.
+     * @param values_ The values to cluster. Must outlive the run.
+     * @param maxDist The maximum distance between neighbouring group members.
+     **/
+    explicit StaticKMeans2(const points_type& values_, meter_t maxDist = centimeter_t(10.0f))
+        : values_(values_)
+        , maxDist2_(maxDist.get() * maxDist.get()) {}
+
+    /* @brief Runs clustering.
+     * @returns Number of groups.
+     **/
+    uint32_t run();
+
+    /* @brief Gets group label of a point.
+     * @param idx Index of the point.
+     * @returns The group label of the point.
+     **/
+    label_type label(uint32_t idx) const { return this->labels_[idx]; }
+
+    /* @brief Gets number of members of a group.
+     * @param group The group label.
+     * @returns The number of members of the group, 0 for NO_GROUP.
+     **/
+    uint32_t groupSize(label_type group) const { return group < maxGroups_ ? this->sizes_[group] : 0; }
+
+    /* @brief Gets center of a group.
+     * @param group The group label.
+     * @returns The average of the group members, the origin for NO_GROUP.
+     **/
+    Point2m center(label_type group) const;
+
+private:
+    const points_type& values_;
+    const float64_t maxDist2_;
+    uint32_t sizes_[maxGroups_];
+    label_type labels_[maxPoints_];
+    index_type queue_[maxPoints_];
+};
+
+template <uint32_t maxPoints_, uint32_t maxGroups_>
+constexpr typename StaticKMeans2<maxPoints_, maxGroups_>::label_type StaticKMeans2<maxPoints_, maxGroups_>::NO_GROUP;
+
+template <uint32_t maxPoints_, uint32_t maxGroups_>
+uint32_t StaticKMeans2<maxPoints_, maxGroups_>::run() {
+    const uint32_t numPoints = this->values_.size();
+
+    // unvisited points are stored after the queue, and are swapped into the queue when added to a group
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        this->queue_[i] = static_cast<index_type>(i);
+        this->labels_[i] = NO_GROUP;
+    }
+    for (uint32_t g = 0; g < maxGroups_; ++g) {
+        this->sizes_[g] = 0;
+    }
+
+    uint32_t numGroups = 0;
+    uint32_t head = 0;
+    while (head < numPoints && numGroups < maxGroups_) {
+        const label_type group = static_cast<label_type>(numGroups++);
+        const uint32_t first = head;
+        uint32_t tail = head + 1;
+        this->labels_[this->queue_[head]] = group;
+
+        for (; head < tail; ++head) {
+            const Point2m& p = this->values_[this->queue_[head]];
+            for (uint32_t i = tail; i < numPoints; ++i) {
+                const Point2m& q = this->values_[this->queue_[i]];
+                if (pythag_square((p.X - q.X).get(), (p.Y - q.Y).get()) < this->maxDist2_) {
+                    this->labels_[this->queue_[i]] = group;
+                    std::swap(this->queue_[i], this->queue_[tail++]);
+                }
+            }
+        }
+        this->sizes_[group] = tail - first;
+    }
+
+    return numGroups;
+}
+
+template <uint32_t maxPoints_, uint32_t maxGroups_>
+Point2m StaticKMeans2<maxPoints_, maxGroups_>::center(label_type group) const {
+    Point2m c(meter_t::ZERO(), meter_t::ZERO());
+    if (group >= maxGroups_ || this->sizes_[group] == 0) {
+        return c;
+    }
+    for (uint32_t i = 0; i < this->values_.size(); ++i) {
+        if (this->labels_[i] == group) {
+            c += this->values_[i];
+        }
+    }
+    return c / this->sizes_[group];
+}
+
+} // namespace bcr
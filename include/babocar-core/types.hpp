@@ -92,4 +92,15 @@ struct is_base_of_template_impl
 
 template < template <typename...> class base,typename derived>
 using is_base_of_template = typename is_base_of_template_impl<base,derived>::type;
+
+/**
+ * @brief Selects the smallest unsigned integer type that can hold the given value.
+ * @tparam max_value The maximum value to store.
+ */
+template <uint64_t max_value>
+struct min_uint {
+    typedef typename std::conditional<max_value <= UINT8_MAX, uint8_t,
+        typename std::conditional<max_value <= UINT16_MAX, uint16_t,
+        typename std::conditional<max_value <= UINT32_MAX, uint32_t, uint64_t>::type>::type>::type type;
+};
 } // namespace bcr
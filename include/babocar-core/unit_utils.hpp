@@ -2,12 +2,53 @@
 
 #include <babocar-core/numeric.hpp>
 #include <babocar-core/units.hpp>
+#include <babocar-core/trig.hpp>
 
 namespace bcr {
 constexpr radian_t PI = radian_t(3.14159265358979323846);        	// Pi
 constexpr radian_t PI_2 = PI / 2; // Pi / 2
 constexpr radian_t PI_4 = PI / 4; // Pi / 4
 
+/**
+ * @brief Gets underlying value of an arithmetic value - the value itself.
+ * @param value The value.
+ * @returns The value.
+ */
+template <typename T>
+inline constexpr typename std::enable_if<std::is_arithmetic<T>::value, T>::type underlying_value(const T& value) {
+    return value;
+}
+
+/**
+ * @brief Gets underlying value of a unit class instance - the stored value in the unit of the class.
+ * @param value The value.
+ * @returns The stored value.
+ */
+template <typename T>
+inline constexpr typename std::enable_if<is_unit<T>::value, typename T::storage_type>::type underlying_value(const T& value) {
+    return value.template get<true>();
+}
+
+/**
+ * @brief Creates arithmetic value from underlying value.
+ * @param value The underlying value.
+ * @returns The value.
+ */
+template <typename T, typename V>
+inline constexpr typename std::enable_if<std::is_arithmetic<T>::value, T>::type from_underlying(const V& value) {
+    return static_cast<T>(value);
+}
+
+/**
+ * @brief Creates unit class instance from underlying value.
+ * @param value The underlying value, in the unit of the class.
+ * @returns The unit class instance.
+ */
+template <typename T, typename V>
+inline constexpr typename std::enable_if<is_unit<T>::value, T>::type from_underlying(const V& value) {
+    return T(value, nullptr);
+}
+
 /**
  * @brief Gets absolute of the value.
  * @param value The value.
@@ -95,8 +136,8 @@ inline typename std::enable_if<is_unit<T>::value, bool>::type isZero(const T& va
  */
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, T1>::type pythag(const T1& a, const T2& b) {
-    const unit_storage_type _a = a.template get<true>();
-    const unit_storage_type _b = static_cast<T1>(b).template get<true>();
+    const typename T1::storage_type _a = a.template get<true>();
+    const typename T1::storage_type _b = detail::operand_cast<T1>(b).template get<true>();
     return T1(std::sqrt(_a * _a + _b * _b), nullptr);
 }
 
@@ -111,18 +152,20 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  */
 template <typename T1, typename T2, typename T3>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T3::is_dim_class && T1::dim == T2::dim && T1::dim == T3::dim, T1>::type pythag(const T1& a, const T2& b, const T3& c) {
-    const unit_storage_type _a = a.template get<true>();
-    const unit_storage_type _b = static_cast<T1>(b).template get<true>();
-    const unit_storage_type _c = static_cast<T1>(c).template get<true>();
+    const typename T1::storage_type _a = a.template get<true>();
+    const typename T1::storage_type _b = detail::operand_cast<T1>(b).template get<true>();
+    const typename T1::storage_type _c = detail::operand_cast<T1>(c).template get<true>();
     return T1(std::sqrt(_a * _a + _b * _b + _c * _c), nullptr);
 }
 
 /* @brief Calculates sine of given angle.
+ * @tparam policy The trigonometric policy (see trig.hpp).
  * @param value The angle.
  * @returns The sine of the angle.
  **/
+template <typename policy = default_trig>
 inline unit_storage_type sin(const radian_t& value) {
-    return std::sin(value.template get<true>());
+    return policy::sin(value.template get<true>());
 }
 
 /* @brief Calculates arc-sine of given value.
@@ -134,11 +177,37 @@ inline radian_t asin(unit_storage_type value) {
 }
 
 /* @brief Calculates cosine of given angle.
+ * @tparam policy The trigonometric policy (see trig.hpp).
  * @param value The angle.
  * @returns The cosine of the angle.
  **/
+template <typename policy = default_trig>
 inline unit_storage_type cos(const radian_t& value) {
-    return std::cos(value.template get<true>()) ;
+    return policy::cos(value.template get<true>());
+}
+
+/* @brief Calculates sine and cosine of given angle.
+ * @tparam policy The trigonometric policy (see trig.hpp).
+ * @param value The angle.
+ * @param s The sine of the angle.
+ * @param c The cosine of the angle.
+ **/
+template <typename policy = default_trig>
+inline void sincos(const radian_t& value, unit_storage_type& s, unit_storage_type& c) {
+    policy::sincos(value.template get<true>(), s, c);
+}
+
+/* @brief Calculates sine and cosine of multiple angles.
+ * @tparam policy The trigonometric policy (see trig.hpp).
+ * @param values The angles.
+ * @param s The sines of the angles.
+ * @param c The cosines of the angles.
+ * @param size Number of angles.
+ **/
+template <typename policy = default_trig>
+inline void sincos(const radian_t * const values, unit_storage_type * const s, unit_storage_type * const c, uint32_t size) {
+    static_assert(sizeof(radian_t) == sizeof(unit_storage_type), "radian_t must be stored as a single unit_storage_type value");
+    sincos_batch<policy>(reinterpret_cast<const unit_storage_type*>(values), s, c, size);
 }
 
 /* @brief Calculates arc-cosine of given value.
@@ -150,11 +219,13 @@ inline radian_t acos(unit_storage_type value) {
 }
 
 /* @brief Calculates tangent of given angle.
+ * @tparam policy The trigonometric policy (see trig.hpp).
  * @param value The angle.
  * @returns The tangent of the angle.
  **/
+template <typename policy = default_trig>
 inline unit_storage_type tan(const radian_t& value) {
-    return std::tan(value.template get<true>());
+    return policy::tan(value.template get<true>());
 }
 
 /* @brief Calculates arc-tangent of given value.
@@ -165,14 +236,27 @@ inline radian_t atan(unit_storage_type value) {
     return radian_t(std::atan(value));
 }
 
-template <typename T>
+template <typename policy = default_trig, typename T>
 inline typename std::enable_if<std::is_arithmetic<T>::value, radian_t>::type atan2(const T& y, const T& x) {
-    return radian_t(std::atan2(static_cast<unit_storage_type>(y), static_cast<unit_storage_type>(x)));
+    return radian_t(policy::atan2(static_cast<unit_storage_type>(y), static_cast<unit_storage_type>(x)));
 }
 
-template <typename T1, typename T2>
+template <typename policy = default_trig, typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, radian_t>::type atan2(const T1& y, const T2& x) {
-    return radian_t(std::atan2(y.template get<true>(), static_cast<T1>(x).template get<true>()));
+    return radian_t(policy::atan2(y.template get<true>(), detail::operand_cast<T1>(x).template get<true>()));
+}
+
+/* @brief Calculates arc-tangent of multiple y/x values.
+ * @tparam policy The trigonometric policy (see trig.hpp).
+ * @param y The y values.
+ * @param x The x values.
+ * @param result The angles.
+ * @param size Number of values.
+ **/
+template <typename policy = default_trig>
+inline void atan2(const unit_storage_type * const y, const unit_storage_type * const x, radian_t * const result, uint32_t size) {
+    static_assert(sizeof(radian_t) == sizeof(unit_storage_type), "radian_t must be stored as a single unit_storage_type value");
+    atan2_batch<policy>(y, x, reinterpret_cast<unit_storage_type*>(result), size);
 }
 
 inline radian_t normalize360(radian_t value) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <babocar-core/types.hpp>
+#include <babocar-core/fixed_point.hpp>
 
 #include <type_traits>
 
@@ -154,7 +155,27 @@ struct div_unit_instance : public base_unit_instance<div_dim<T1::dim, T2::dim>::
 template <typename _unit_inst_t>
 using square_unit_instance = mul_unit_instance<_unit_inst_t, _unit_inst_t>;
 
-/* @brief Rescales value to another unit.
+/* @brief Gets ratio of two unit multipliers.
+ * @tparam from The source unit
+ * @tparam to The result unit.
+ * @returns The ratio of the unit multipliers.
+ **/
+template <typename from_unit_inst_t, typename to_unit_inst_t>
+inline constexpr unit_storage_type unit_ratio() {
+    return from_unit_inst_t::mul / to_unit_inst_t::mul;
+}
+
+/* @brief Checks if value is an integer (with relative tolerance for the rounding errors of the unit multipliers).
+ * @param value The value.
+ * @returns Boolean value indicating if the value is an integer.
+ **/
+inline constexpr bool is_integer_ratio(unit_storage_type value) {
+    return value >= 1.0 && value < 9.2e18 &&
+        static_cast<unit_storage_type>(static_cast<int64_t>(value + 0.5)) - value < value * 1e-12 &&
+        value - static_cast<unit_storage_type>(static_cast<int64_t>(value + 0.5)) < value * 1e-12;
+}
+
+/* @brief Rescales value to another unit. The ratio of the units is calculated at compile time.
  * @restrict Type of the value must be arithmetic.
  * @tparam from The source unit
  * @tparam to The result unit.
@@ -164,33 +185,67 @@ using square_unit_instance = mul_unit_instance<_unit_inst_t, _unit_inst_t>;
  **/
 template <typename from_unit_inst_t, typename to_unit_inst_t, typename T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
 inline constexpr typename std::enable_if<from_unit_inst_t::dim == to_unit_inst_t::dim, T>::type rescale_unit(const T& value) {
-    return value * from_unit_inst_t::mul / to_unit_inst_t::mul;
+    return std::is_floating_point<T>::value
+        ? value * static_cast<T>(unit_ratio<from_unit_inst_t, to_unit_inst_t>())
+        : static_cast<T>(value * unit_ratio<from_unit_inst_t, to_unit_inst_t>());
+}
+
+/* @brief Rescales fixed-point value to another unit.
+ * Integer ratios (e.g. meters to centimeters) and their reciprocals are applied as integer multiplication or division,
+ * other ratios as fixed-point multiplication. The result is saturated if it is out of range.
+ * @tparam from The source unit
+ * @tparam to The result unit.
+ * @param value The value to rescale.
+ * @returns The rescaled value.
+ **/
+template <typename from_unit_inst_t, typename to_unit_inst_t, typename T, uint32_t frac_bits>
+inline typename std::enable_if<from_unit_inst_t::dim == to_unit_inst_t::dim, fixed_point<T, frac_bits>>::type rescale_unit(const fixed_point<T, frac_bits>& value) {
+    constexpr unit_storage_type ratio = unit_ratio<from_unit_inst_t, to_unit_inst_t>();
+    return ratio == 1.0 ? value
+        : is_integer_ratio(ratio) ? value * static_cast<int64_t>(ratio + 0.5)
+        : is_integer_ratio(1.0 / ratio) ? value / static_cast<int64_t>(1.0 / ratio + 0.5)
+        : value * fixed_point<T, frac_bits>(ratio);
 }
 
+/* @brief Checks if values of a storage type can be converted to another storage type without loss of precision.
+ * @tparam from The source storage type.
+ * @tparam to The destination storage type.
+ **/
+template <typename from, typename to>
+struct is_lossless_storage_conversion {
+    enum { value = std::is_same<from, to>::value || (std::is_floating_point<from>::value && std::is_floating_point<to>::value && sizeof(from) <= sizeof(to)) };
+};
+
+template <typename T1, uint32_t frac_bits1, typename T2, uint32_t frac_bits2>
+struct is_lossless_storage_conversion<fixed_point<T1, frac_bits1>, fixed_point<T2, frac_bits2>> {
+    enum { value = frac_bits1 <= frac_bits2 && fixed_point<T1, frac_bits1>::INT_BITS <= fixed_point<T2, frac_bits2>::INT_BITS };
+};
+
 /* @brief Dimension class template. Used for basic types like time, distance, etc.
  * @tparam _dim The dimension.
+ * @tparam storage_t The type of the stored value.
  **/
-template <Dimension _dim, typename unit_inst_t_ = unit_instance<_dim, Unit::one>, bool explicit_unit = false>
+template <Dimension _dim, typename unit_inst_t_ = unit_instance<_dim, Unit::one>, bool explicit_unit = false, typename storage_t = unit_storage_type>
 class dim_class {
 public:
     enum { is_dim_class = true };
     static constexpr Dimension dim = _dim;   // The dimension.
     typedef unit_inst_t_ unit_inst_t;
+    typedef storage_t storage_type;
     static_assert(_dim == unit_inst_t::dim, "Dimensions do not match!");  // Checks if the dimensions match.
+    static_assert(std::is_arithmetic<storage_t>::value || is_fixed_point<storage_t>::value, "Storage type must be arithmetic or fixed-point!");
 
 private:
-    template <Dimension dim2, typename unit_inst_t2, bool explicit_unit2> friend class dim_class;
-    template <typename unit_inst_t2, bool explicit_unit2> using same_dim_class = dim_class<dim, unit_inst_t2, explicit_unit2>;
-    template <Dimension dim2, typename unit_inst_t2, bool explicit_unit2> using other_dim_class = dim_class<dim2, unit_inst_t2, explicit_unit2>;
+    template <Dimension dim2, typename unit_inst_t2, bool explicit_unit2, typename storage_t2> friend class dim_class;
 
-    unit_storage_type value;   // The stored value.
+    storage_t value;   // The stored value.
 
 public:
     /* @brief Constructor - sets value.
      * @tparam T Numeric type of the parameter value.
      * param _value The value given in the unit instance.
      **/
-    constexpr explicit dim_class(unit_storage_type _value, void*) : value(_value) {}
+    constexpr explicit dim_class(storage_t _value, void*) : value(_value) {}
 
     /* @brief Default constructor - sets value to 0.
      **/
@@ -201,19 +256,27 @@ public:
      * param _value The value given in the unit instance.
      **/
     template <bool enable = explicit_unit, class = typename std::enable_if<enable>::type>
-    constexpr explicit dim_class(unit_storage_type _value) : value(_value) {}
+    constexpr explicit dim_class(storage_t _value) : value(_value) {}
 
     static constexpr dim_class ZERO() { return dim_class(0.0f, nullptr); }
 
-    /* @brief Constructor - sets value.
-     * @tparam unit_inst_t Unit instance type.
-     * @param [unnamed] The unit instance.
-     * param _value The value given in the unit instance.
+    /* @brief Constructor - converts value from another unit of the same dimension.
+     * @restrict Storage type conversion must be lossless (e.g. float32_t to float64_t).
+     * @param other The value in the other unit.
      **/
-    template <typename unit_inst2, bool explicit_unit2>
-    constexpr dim_class(const dim_class<dim, unit_inst2, explicit_unit2>& other)
-        : value(rescale_unit<unit_inst2, unit_inst_t>(other.value)) {}
-    
+    template <typename unit_inst2, bool explicit_unit2, typename storage_t2,
+        typename std::enable_if<is_lossless_storage_conversion<storage_t2, storage_t>::value, int>::type = 0>
+    constexpr dim_class(const dim_class<dim, unit_inst2, explicit_unit2, storage_t2>& other)
+        : value(static_cast<storage_t>(rescale_unit<unit_inst2, unit_inst_t>(other.value))) {}
+
+    /* @brief Constructor - converts value from another unit of the same dimension, with loss of precision (e.g. float64_t to float32_t).
+     * @param other The value in the other unit.
+     **/
+    template <typename unit_inst2, bool explicit_unit2, typename storage_t2,
+        typename std::enable_if<!is_lossless_storage_conversion<storage_t2, storage_t>::value, int>::type = 0>
+    constexpr explicit dim_class(const dim_class<dim, unit_inst2, explicit_unit2, storage_t2>& other)
+        : value(static_cast<storage_t>(rescale_unit<unit_inst2, unit_inst_t>(other.value))) {}
+
     /* @brief Gets value in given unit.
      * @restrict Type must be unit instance type.
      * @restrict Dimension of the result instance type must be the same as the dimension of this type.
@@ -221,23 +284,42 @@ public:
      * @returns The value in given unit.
      **/
     template <bool enable = explicit_unit, class = typename std::enable_if<enable>::type>
-    constexpr unit_storage_type get() const {
+    constexpr storage_t get() const {
         return this->value;
     }
 
     template <bool enable = explicit_unit, class = typename std::enable_if<enable>::type>
-    void set(unit_storage_type _value) {
+    void set(storage_t _value) {
         this->value = _value;
     }
 };
 
+/* Mixed precision rules:
+ * - Operations of the same dimension (+, -, comparison) convert the second operand to the type of the first one.
+ *   This conversion must be lossless, e.g. meter_t + meter_f_t is valid, meter_f_t + meter_t needs an explicit cast of the second operand.
+ * - Multiplication and division of different dimensions store the result in the wider storage type of the operands.
+ * - Multiplication and division by an arithmetic constant keep the storage type of the dimension class instance.
+ */
+
+/* @brief Converts second operand of a same-dimension operation to the type of the first operand.
+ * @restrict Storage type conversion must be lossless.
+ * @param d The second operand.
+ * @returns The second operand converted to the type of the first operand.
+ **/
+template <typename T1, typename T2>
+inline constexpr T1 operand_cast(const T2& d) {
+    static_assert(is_lossless_storage_conversion<typename T2::storage_type, typename T1::storage_type>::value,
+        "Mixed precision operation would lose precision, cast the second operand explicitly!");
+    return static_cast<T1>(d);
+}
+
 /* @brief Adds two dimension class instances.
  * @param other The other dimension class instance.
  * @returns The result of the addition.
  **/
 template <typename T1, typename T2>
 inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, T1>::type operator+(const T1& d1, const T2& d2) {
-    return T1(d1.template get<true>() + static_cast<T1>(d2).template get<true>(), nullptr);
+    return T1(d1.template get<true>() + operand_cast<T1>(d2).template get<true>(), nullptr);
 }
 
 /* @brief Subtracts two dimension class instances.
@@ -246,7 +328,7 @@ inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class &&
  **/
 template <typename T1, typename T2>
 inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, T1>::type operator-(const T1& d1, const T2& d2) {
-    return T1(d1.template get<true>() - static_cast<T1>(d2).template get<true>(), nullptr);
+    return T1(d1.template get<true>() - operand_cast<T1>(d2).template get<true>(), nullptr);
 }
 
 /* @brief Adds two dimension class instances and stores result in this instance.
@@ -255,7 +337,7 @@ inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class &&
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, void>::type operator+=(T1& d1, const T2& d2) {
-    d1.template set<true>(d1.template get<true>() + static_cast<T1>(d2).template get<true>());
+    d1.template set<true>(d1.template get<true>() + operand_cast<T1>(d2).template get<true>());
 }
 
 /* @brief Subtracts two dimension class instances and stores result in this instance.
@@ -264,7 +346,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, void>::type operator-=(T1& d1, const T2& d2) {
-    d1.template set<true>(d1.template get<true>() - static_cast<T1>(d2).template get<true>());
+    d1.template set<true>(d1.template get<true>() - operand_cast<T1>(d2).template get<true>());
 }
 
  /* @brief Compares two dimension class instances.
@@ -273,7 +355,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator==(const T1& d1, const T2& d2) {
-    return d1.template get<true>() == static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() == operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Compares two dimension class instances.
@@ -282,7 +364,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator!=(const T1& d1, const T2& d2) {
-    return d1.template get<true>() != static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() != operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Compares two dimension class instances.
@@ -291,7 +373,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator>(const T1& d1, const T2& d2) {
-    return d1.template get<true>() > static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() > operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Compares two dimension class instances.
@@ -300,7 +382,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator<(const T1& d1, const T2& d2) {
-    return d1.template get<true>() < static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() < operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Compares two dimension class instances.
@@ -309,7 +391,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator>=(const T1& d1, const T2& d2) {
-    return d1.template get<true>() >= static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() >= operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Compares two dimension class instances.
@@ -318,7 +400,7 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  **/
 template <typename T1, typename T2>
 inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, bool>::type operator<=(const T1& d1, const T2& d2) {
-    return d1.template get<true>() <= static_cast<T1>(d2).template get<true>();
+    return d1.template get<true>() <= operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Gets ratio of two dimension class instances.
@@ -326,15 +408,16 @@ inline typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim =
  * @returns The ratio of the dimension class instances.
  **/
 template <typename T1, typename T2>
-inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, unit_storage_type>::type operator/(const T1& d1, const T2& d2) {
-    return d1.template get<true>() / static_cast<T1>(d2).template get<true>();
+inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim == T2::dim, typename T1::storage_type>::type operator/(const T1& d1, const T2& d2) {
+    return d1.template get<true>() / operand_cast<T1>(d2).template get<true>();
 }
 
 /* @brief Multiplies this value with another dimension class instance.
  * @param other The other dimension class instance.
  * @returns The result dimension class instance.
  **/
-template <typename T1, typename T2, typename R = dim_class<mul_dim<T1::dim, T2::dim>::value, mul_unit_instance<typename T1::unit_inst_t, typename T2::unit_inst_t>>>
+template <typename T1, typename T2, typename R = dim_class<mul_dim<T1::dim, T2::dim>::value, mul_unit_instance<typename T1::unit_inst_t, typename T2::unit_inst_t>, false,
+    typename std::common_type<typename T1::storage_type, typename T2::storage_type>::type>>
 inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class, R>::type operator*(const T1& d1, const T2& d2) {
     return R(d1.template get<true>() * d2.template get<true>(), nullptr);
 }
@@ -343,7 +426,8 @@ inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class, R
  * @param other The other dimension class instance.
  * @returns The result dimension class instance.
  **/
-template <typename T1, typename T2, typename R = dim_class<div_dim<T1::dim, T2::dim>::value, div_unit_instance<typename T1::unit_inst_t, typename T2::unit_inst_t>>>
+template <typename T1, typename T2, typename R = dim_class<div_dim<T1::dim, T2::dim>::value, div_unit_instance<typename T1::unit_inst_t, typename T2::unit_inst_t>, false,
+    typename std::common_type<typename T1::storage_type, typename T2::storage_type>::type>>
 inline constexpr typename std::enable_if<T1::is_dim_class && T2::is_dim_class && T1::dim != T2::dim, R>::type operator/(const T1& d1, const T2& d2) {
     return R(d1.template get<true>() / d2.template get<true>(), nullptr);
 }
@@ -410,8 +494,22 @@ inline typename std::enable_if<T1::is_dim_class && std::is_arithmetic<T2>::value
     return d;
 }
 
+template <typename T, typename storage_t> struct rebind_storage;
+
+template <Dimension dim, typename unit_inst_t, bool explicit_unit, typename storage_t1, typename storage_t2>
+struct rebind_storage<dim_class<dim, unit_inst_t, explicit_unit, storage_t1>, storage_t2> {
+    typedef dim_class<dim, unit_inst_t, explicit_unit, storage_t2> type;
+};
+
 } // namespace detail
 
+/* @brief Unit type with another storage type (e.g. with_storage<meter_t, q16_16_t> for fixed-point meters).
+ * @tparam T The unit type.
+ * @tparam storage_t The storage type.
+ **/
+template <typename T, typename storage_t>
+using with_storage = typename detail::rebind_storage<T, storage_t>::type;
+
 dimension_connections(Dimension::speed, Dimension::time, Dimension::distance)                        // Dimension connections for speed, time and distance (speed * time = distance).
 dimension_connections(Dimension::acceleration, Dimension::time, Dimension::speed)                    // Dimension connections for acceleration, time and speed (acceleration * time = speed).
 dimension_connections(Dimension::angular_velocity, Dimension::time, Dimension::angle)                // Dimension connections for angular velocity, time and angle (angular velocity * time = angle).
@@ -433,13 +531,17 @@ dimension_connections(Dimension::angular_velocity, Dimension::distance, Dimensio
 
 // } // namespace detail
 
-#define create_unit_instance_with_unit_prefix(dim, mul, unit)                                                           \
-typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true> mul ## unit ## _t;    \
-typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true> mul ## unit ## 2_t;
+#define create_unit_instance_with_unit_prefix(dim, mul, unit)                                                                           \
+typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true> mul ## unit ## _t;                    \
+typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true> mul ## unit ## 2_t; \
+typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true, float32_t> mul ## unit ## _f_t;       \
+typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true, float32_t> mul ## unit ## 2_f_t;
 
-#define create_unit_instance_without_unit_prefix(dim, mul, unit)                                                \
-typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true> unit ## _t;   \
-typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true> unit ## 2_t;
+#define create_unit_instance_without_unit_prefix(dim, mul, unit)                                                                \
+typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true> unit ## _t;                   \
+typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true> unit ## 2_t; \
+typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::mul>, true, float32_t> unit ## _f_t;      \
+typedef detail::dim_class<Dimension::dim, detail::square_unit_instance<detail::unit_instance<Dimension::dim, Unit::mul>>, true, float32_t> unit ## 2_f_t;
 
 #define create_unit_instances(dim, unit)                            \
 square_dimension_connections(Dimension::dim, Dimension::dim ## 2)   \
@@ -454,15 +556,20 @@ create_unit_instance_with_unit_prefix(dim, centi, unit);            \
 create_unit_instance_with_unit_prefix(dim, milli, unit);            \
 create_unit_instance_with_unit_prefix(dim, micro, unit);            \
 create_unit_instance_with_unit_prefix(dim, nano, unit);             \
-typedef detail::dim_class<Dimension::dim> dim ## _t;
+typedef detail::dim_class<Dimension::dim> dim ## _t;                \
+typedef detail::dim_class<Dimension::dim, detail::unit_instance<Dimension::dim, Unit::one>, false, float32_t> dim ## _f_t;
 
 #define create_mul_unit_instance(unit1, unit2, unit) \
 typedef detail::dim_class<detail::mul_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>::dim,   \
-        detail::mul_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true> unit ## _t
+        detail::mul_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true> unit ## _t;        \
+typedef detail::dim_class<detail::mul_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>::dim,   \
+        detail::mul_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true, float32_t> unit ## _f_t
 
 #define create_div_unit_instance(unit1, unit2, unit) \
 typedef detail::dim_class<detail::div_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>::dim,   \
-        detail::div_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true> unit ## _t
+        detail::div_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true> unit ## _t;        \
+typedef detail::dim_class<detail::div_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>::dim,   \
+        detail::div_unit_instance<unit1 ## _t::unit_inst_t, unit2 ## _t::unit_inst_t>, true, float32_t> unit ## _f_t
 
 create_unit_instances(time, second);
 create_unit_instance_without_unit_prefix(time, _3600, hour);
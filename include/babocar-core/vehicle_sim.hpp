@@ -0,0 +1,209 @@
+#pragma once
+
+#include <babocar-core/odometry.hpp>
+#include <babocar-core/random.hpp>
+#include <babocar-core/container/vec.hpp>
+
+#include <vector>
+
+namespace bcr {
+
+/* @brief Parameters of the vehicle simulator.
+ **/
+struct VehicleSimParams {
+    millisecond_t step;                 // Simulation time step.
+    meter_t wheelbase;                  // Distance between the front and rear axles.
+    radian_t maxSteeringAngle;          // Maximum steering angle of the front wheels.
+    rad_per_sec_t maxSteeringRate;      // Maximum angular velocity of the steering servo.
+    millisecond_t speedTimeConstant;    // Time constant of the first order lag of the speed control.
+    m_per_sec_t speedNoise;             // Standard deviation of the measured speed (wheel encoders).
+    rad_per_sec_t angVelNoise;          // Standard deviation of the measured angular velocity (gyroscope).
+    millisecond_t sensorLatency;        // Latency of the speed and angular velocity measurements (rounded to whole steps).
+    millisecond_t posePeriod;           // Period of the absolute pose measurements (rounded to whole steps) - 0 disables them.
+    millisecond_t poseLatency;          // Latency of the absolute pose measurements (rounded to whole steps).
+    meter_t posePosNoise;               // Standard deviation of the coordinates of the measured pose.
+    radian_t poseAngleNoise;            // Standard deviation of the angle of the measured pose.
+    uint32_t seed;                      // Seed of the noise generator.
+
+    /* @brief Default constructor - sets parameters of a 1:10 scale car with ideal sensors.
+     **/
+    VehicleSimParams()
+        : step(1)
+        , wheelbase(0.26)
+        , maxSteeringAngle(degree_t(25))
+        , maxSteeringRate(deg_per_sec_t(360))
+        , speedTimeConstant(100)
+        , speedNoise(0)
+        , angVelNoise(0)
+        , sensorLatency(0)
+        , posePeriod(0)
+        , poseLatency(0)
+        , posePosNoise(0)
+        , poseAngleNoise(0)
+        , seed(1) {}
+};
+
+/* @brief Control input of the vehicle.
+ **/
+struct VehicleControl {
+    m_per_sec_t speed;          // Target forward speed.
+    radian_t steeringAngle;     // Target steering angle of the front wheels.
+};
+
+/* @brief Measurements available for the controller at the current time (delayed and noisy).
+ **/
+struct VehicleMeasurement {
+    millisecond_t time;         // The current time.
+    millisecond_t sensorTime;   // Timestamp of the speed and angular velocity measurements.
+    m_per_sec_t speed;          // Measured forward speed.
+    rad_per_sec_t ang_vel;      // Measured angular velocity.
+    bool hasPose;               // Indicates if an absolute pose measurement has arrived in this step.
+    millisecond_t poseTime;     // Timestamp of the pose measurement.
+    Pose pose;                  // Measured pose.
+};
+
+/* @brief Deterministic kinematic bicycle model simulator, for running control loops faster than real time.
+ * The speed follows the target speed with a first order lag, the steering angle follows the target angle with limited rate,
+ * and the pose is integrated with the exact arc solution (see Odometry::update).
+ * Measurements are generated from the true state with gaussian noise, and are delivered to the controller after their latency.
+ * The noise is generated by a seeded xorshift32, so runs with the same parameters and controller are reproducible.
+ * The measurement queues are sized from the latencies in the constructor, so any latency is simulated without dropping measurements.
+ **/
+class VehicleSim {
+public:
+    /* @brief Constructor - sets parameters and initial state.
+     * @param params The simulation parameters.
+     * @param start The initial pose and twist. The speed is projected to the heading of the vehicle.
+     **/
+    VehicleSim(const VehicleSimParams& params, const Odometry& start);
+
+    /* @brief Resets the state and the noise generator, and clears the measurements in flight.
+     * @param start The initial pose and twist. The speed is projected to the heading of the vehicle.
+     **/
+    void reset(const Odometry& start);
+
+    /* @brief Advances the simulation by one time step.
+     * @param control The control input.
+     **/
+    void step(const VehicleControl& control);
+
+    /* @brief Runs a control loop - in every step the controller is called with the current measurements, and its output is applied.
+     * @tparam F Type of the controller - callable with signature VehicleControl(const VehicleMeasurement&).
+     * @param controller The controller.
+     * @param duration The duration of the simulation.
+     * @returns Number of simulated steps.
+     **/
+    template <typename F>
+    uint32_t run(F&& controller, millisecond_t duration) {
+        const uint32_t numSteps = static_cast<uint32_t>(std::round(duration.get() / this->params_.step.get()));
+        for (uint32_t i = 0; i < numSteps; ++i) {
+            this->step(controller(this->measurement_));
+        }
+        return numSteps;
+    }
+
+    /* @brief Gets the measurements available at the current time.
+     * @returns The measurements.
+     **/
+    const VehicleMeasurement& measurement() const { return this->measurement_; }
+
+    /* @brief Gets the true state of the vehicle (ground truth).
+     * @returns The true pose and twist.
+     **/
+    const Odometry& odometry() const { return this->odom_; }
+
+    /* @brief Gets the current steering angle.
+     * @returns The current steering angle.
+     **/
+    radian_t steeringAngle() const { return this->steeringAngle_; }
+
+    /* @brief Gets the current time.
+     * @returns The current time.
+     **/
+    millisecond_t time() const { return this->time_; }
+
+    const VehicleSimParams& params() const { return this->params_; }
+
+private:
+    struct SensorSample {
+        millisecond_t time;         // Timestamp.
+        m_per_sec_t speed;          // The measured forward speed.
+        rad_per_sec_t ang_vel;      // The measured angular velocity.
+    };
+
+    struct PoseSample {
+        millisecond_t time;         // Timestamp (capture time).
+        uint32_t deliveryStep;      // Step of delivery to the controller.
+        Pose pose;                  // The measured pose.
+    };
+
+    // generates measurements of the current state, and updates the measurements available for the controller
+    void measure();
+
+    const VehicleSimParams params_;     // The simulation parameters.
+    const float64_t speedGain_;         // Gain of the speed lag in one step.
+    const uint32_t sensorLatencySteps_; // Latency of the speed and angular velocity measurements in steps.
+    const uint32_t posePeriodSteps_;    // Period of the pose measurements in steps (0 if disabled).
+    const uint32_t poseLatencySteps_;   // Latency of the pose measurements in steps.
+
+    xorshift32 random_;                 // The noise generator.
+    millisecond_t time_;                // The current time.
+    uint32_t numSteps_;                 // Number of steps since the last reset.
+    Odometry odom_;                     // The true pose and twist.
+    m_per_sec_t speed_;                 // The true forward speed.
+    radian_t steeringAngle_;            // The true steering angle.
+
+    std::vector<SensorSample> sensorSamples_;   // Delay line of the speed and angular velocity measurements (latency + 1 samples).
+    std::vector<PoseSample> poseSamples_;       // Queue of the pose measurements waiting for delivery (latency / period + 1 samples).
+    uint32_t poseHead_;                         // Index of the oldest pose measurement in the queue.
+    uint32_t numPoses_;                         // Number of pose measurements in the queue.
+    VehicleMeasurement measurement_;            // Measurements available for the controller.
+};
+
+/* @brief Simulation scenario - vehicle parameters, initial state, duration and a reference path for the controller.
+ **/
+struct VehicleScenario {
+    static constexpr uint32_t MAX_PATH_POINTS = 512;    // Maximum number of reference path points.
+
+    VehicleSimParams params;            // The simulation parameters.
+    Odometry start;                     // The initial pose and twist.
+    millisecond_t duration;             // Duration of the simulation.
+    m_per_sec_t targetSpeed;            // Target speed for the controller.
+    vec<Point2m, MAX_PATH_POINTS> path; // Reference path for the controller.
+
+    /* @brief Default constructor - sets default parameters, starts from the origin, with empty path.
+     **/
+    VehicleScenario()
+        : duration(10000)
+        , targetSpeed(1) {
+        this->start.pose = { Point2m(meter_t(0), meter_t(0)), radian_t(0) };
+        this->start.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+    }
+};
+
+/* @brief Parses scenario from text. Every line contains a key and its values, separated by whitespace, '#' starts a comment.
+ * The unit of the values is part of the key name. Keys not given keep their default values.
+ *
+ *   seed <n>                          step_ms <t>                     duration_s <t>
+ *   wheelbase_m <l>                   max_steering_deg <a>            max_steering_rate_deg_per_s <w>
+ *   speed_time_constant_ms <t>        speed_noise_mps <v>             ang_vel_noise_deg_per_s <w>
+ *   sensor_latency_ms <t>             pose_period_ms <t>              pose_latency_ms <t>
+ *   pose_noise_m <d>                  pose_noise_deg <a>              target_speed_mps <v>
+ *   start <x_m> <y_m> <angle_deg>     point <x_m> <y_m>               (one line per path point)
+ *
+ * @param text The scenario text (null-terminated).
+ * @param result The parsed scenario.
+ * @param errorLine Optional output of the number of the first invalid line (1-based).
+ * @returns Status::OK, Status::INVALID_DATA for unknown keys or invalid values, Status::BUFFER_FULL if the path is too long.
+ **/
+Status parseScenario(const char *text, VehicleScenario& result, uint32_t *errorLine = nullptr);
+
+/* @brief Loads scenario from a file.
+ * @param fileName The name of the scenario file.
+ * @param result The parsed scenario.
+ * @param errorLine Optional output of the number of the first invalid line (1-based).
+ * @returns Status::ERROR if the file cannot be read, otherwise the result of parseScenario.
+ **/
+Status loadScenario(const char *fileName, VehicleScenario& result, uint32_t *errorLine = nullptr);
+
+} // namespace bcr
@@ -0,0 +1,208 @@
+#include <babocar-core/map_file.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bcr {
+
+constexpr uint32_t MapFileHeader::VERSION;
+constexpr uint32_t MapFileHeader::NO_TILE;
+constexpr uint64_t MapFileHeader::ALIGNMENT;
+
+static_assert(sizeof(Point2m) == 2 * sizeof(float64_t), "Point2m must be stored as two 64-bit floating point values!");
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Map files are little-endian and are used in place - big-endian hosts are not supported!");
+
+namespace {
+
+const char MAGIC[8] = { 'B', 'C', 'R', 'M', 'A', 'P', '\0', '\0' };
+constexpr uint32_t MAX_TILE_BITS = 12;   // Maximum tile bits - limits the section sizes.
+
+uint64_t align(uint64_t offset) {
+    return (offset + MapFileHeader::ALIGNMENT - 1) & ~(MapFileHeader::ALIGNMENT - 1);
+}
+
+uint64_t tileBytes(uint32_t tileBits) {
+    return sizeof(int16_t) << (2 * tileBits);
+}
+
+// checks if a section is inside the file - the sizes are limited to 32 bits, so the sums cannot overflow
+bool isInside(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    return offset % MapFileHeader::ALIGNMENT == 0 && offset <= fileSize && count * elementSize <= fileSize - offset;
+}
+
+bool writePadding(FILE *file, uint64_t& offset, uint64_t target) {
+    static const char zeros[MapFileHeader::ALIGNMENT] = {};
+    const uint64_t size = target - offset;
+    offset = target;
+    return size == 0 || std::fwrite(zeros, 1, size, file) == size;
+}
+
+} // namespace
+
+MapFile::MapFile()
+    : data_(nullptr)
+    , size_(0)
+    , header_(nullptr)
+    , index_(nullptr)
+    , tiles_(nullptr)
+    , path_(nullptr) {}
+
+MapFile::~MapFile() {
+    this->close();
+}
+
+Status MapFile::open(const char *fileName) {
+    this->close();
+
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return Status::ERROR;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return Status::ERROR;
+    }
+    if (st.st_size < static_cast<off_t>(sizeof(MapFileHeader))) {
+        ::close(fd);
+        return Status::INVALID_DATA;
+    }
+
+    // the mapping stays valid after closing the file descriptor, the pages are loaded on first touch
+    void *const data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return Status::ERROR;
+    }
+
+    const uint8_t *const bytes = static_cast<const uint8_t*>(data);
+    const MapFileHeader *const header = reinterpret_cast<const MapFileHeader*>(bytes);
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+    const uint64_t numIndices = static_cast<uint64_t>(header->width) * header->height;
+
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+        header->version == MapFileHeader::VERSION &&
+        header->headerSize == sizeof(MapFileHeader) &&
+        header->fileSize == size &&
+        header->resolution > 0.0 && std::isfinite(header->resolution) &&
+        header->tileBits > 0 && header->tileBits <= MAX_TILE_BITS &&
+        numIndices <= 0xffffffffu && header->numTiles <= numIndices &&
+        isInside(header->indexOffset, numIndices, sizeof(uint32_t), size) &&
+        isInside(header->tilesOffset, header->numTiles, tileBytes(header->tileBits), size) &&
+        isInside(header->pathOffset, header->pathSize, sizeof(Point2m), size) &&
+        header->reserved == 0;
+
+    // the index is small compared to the tiles, it is validated so that corrupt files cannot cause out-of-bounds reads
+    const uint32_t *const index = reinterpret_cast<const uint32_t*>(bytes + (valid ? header->indexOffset : 0));
+    for (uint64_t i = 0; valid && i < numIndices; ++i) {
+        valid = index[i] < header->numTiles || index[i] == MapFileHeader::NO_TILE;
+    }
+
+    if (!valid) {
+        ::munmap(data, static_cast<size_t>(size));
+        return Status::INVALID_DATA;
+    }
+
+    this->data_ = data;
+    this->size_ = static_cast<size_t>(size);
+    this->header_ = header;
+    this->index_ = index;
+    this->tiles_ = reinterpret_cast<const int16_t*>(bytes + header->tilesOffset);
+    this->path_ = reinterpret_cast<const Point2m*>(bytes + header->pathOffset);
+    return Status::OK;
+}
+
+void MapFile::close() {
+    if (this->data_) {
+        ::munmap(this->data_, this->size_);
+    }
+    this->data_ = nullptr;
+    this->size_ = 0;
+    this->header_ = nullptr;
+    this->index_ = nullptr;
+    this->tiles_ = nullptr;
+    this->path_ = nullptr;
+}
+
+Status writeMapFile(const char *fileName, meter_t resolution, uint32_t tileBits, const Point2i *keys, const int16_t *const *tiles, uint32_t numTiles,
+    const Point2m *path, uint32_t pathSize) {
+
+    if (tileBits == 0 || tileBits > MAX_TILE_BITS || !(resolution.get() > 0.0) || !std::isfinite(resolution.get())) {
+        return Status::INVALID_DATA;
+    }
+
+    MapFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = MapFileHeader::VERSION;
+    header.headerSize = sizeof(MapFileHeader);
+    header.resolution = resolution.get();
+    header.tileBits = tileBits;
+    header.numTiles = numTiles;
+    header.pathSize = pathSize;
+
+    // bounding box of the tiles
+    if (numTiles > 0) {
+        int32_t minX = keys[0].X, minY = keys[0].Y, maxX = keys[0].X, maxY = keys[0].Y;
+        for (uint32_t i = 1; i < numTiles; ++i) {
+            minX = bcr::min(minX, keys[i].X);
+            minY = bcr::min(minY, keys[i].Y);
+            maxX = bcr::max(maxX, keys[i].X);
+            maxY = bcr::max(maxY, keys[i].Y);
+        }
+        header.originX = minX;
+        header.originY = minY;
+        header.width = static_cast<uint32_t>(maxX - minX) + 1;
+        header.height = static_cast<uint32_t>(maxY - minY) + 1;
+        if (static_cast<uint64_t>(header.width) * header.height > 0xffffffffu) {
+            return Status::INVALID_DATA;
+        }
+    }
+
+    std::vector<uint32_t> index(static_cast<size_t>(header.width) * header.height, MapFileHeader::NO_TILE);
+    for (uint32_t i = 0; i < numTiles; ++i) {
+        uint32_t& idx = index[static_cast<uint32_t>(keys[i].Y - header.originY) * header.width + static_cast<uint32_t>(keys[i].X - header.originX)];
+        if (idx != MapFileHeader::NO_TILE) {
+            return Status::INVALID_DATA;
+        }
+        idx = i;
+    }
+
+    header.indexOffset = align(sizeof(MapFileHeader));
+    header.tilesOffset = align(header.indexOffset + index.size() * sizeof(uint32_t));
+    header.pathOffset = align(header.tilesOffset + numTiles * tileBytes(tileBits));
+    header.fileSize = header.pathOffset + static_cast<uint64_t>(pathSize) * sizeof(Point2m);
+
+    FILE *file = std::fopen(fileName, "wb");
+    if (!file) {
+        return Status::ERROR;
+    }
+
+    uint64_t offset = sizeof(MapFileHeader);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        writePadding(file, offset, header.indexOffset) &&
+        std::fwrite(index.data(), sizeof(uint32_t), index.size(), file) == index.size();
+
+    offset += index.size() * sizeof(uint32_t);
+    ok = ok && writePadding(file, offset, header.tilesOffset);
+    for (uint32_t i = 0; ok && i < numTiles; ++i) {
+        ok = std::fwrite(tiles[i], tileBytes(tileBits), 1, file) == 1;
+    }
+
+    offset += numTiles * tileBytes(tileBits);
+    ok = ok && writePadding(file, offset, header.pathOffset) &&
+        (pathSize == 0 || std::fwrite(path, sizeof(Point2m), pathSize, file) == pathSize);
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok ? Status::OK : Status::ERROR;
+}
+
+} // namespace bcr
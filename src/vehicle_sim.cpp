@@ -0,0 +1,192 @@
+#include <babocar-core/vehicle_sim.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace bcr {
+
+constexpr uint32_t VehicleScenario::MAX_PATH_POINTS;
+
+namespace {
+
+uint32_t toSteps(millisecond_t time, millisecond_t step) {
+    return static_cast<uint32_t>(std::round(time.get() / step.get()));
+}
+
+} // namespace
+
+VehicleSim::VehicleSim(const VehicleSimParams& params, const Odometry& start)
+    : params_(params)
+    , speedGain_(1.0 - std::exp(-params.step.get() / bcr::max(params.speedTimeConstant.get(), 1e-9)))
+    , sensorLatencySteps_(toSteps(params.sensorLatency, params.step))
+    , posePeriodSteps_(toSteps(params.posePeriod, params.step))
+    , poseLatencySteps_(toSteps(params.poseLatency, params.step))
+    , sensorSamples_(this->sensorLatencySteps_ + 1)
+    , poseSamples_(this->posePeriodSteps_ > 0 ? this->poseLatencySteps_ / this->posePeriodSteps_ + 1 : 0) {
+    this->reset(start);
+}
+
+void VehicleSim::reset(const Odometry& start) {
+    float64_t s, c;
+    bcr::sincos(start.pose.angle, s, c);
+
+    this->random_ = xorshift32(this->params_.seed);
+    this->time_ = millisecond_t(0);
+    this->numSteps_ = 0;
+    this->speed_ = start.twist.speed.X * c + start.twist.speed.Y * s;
+    this->steeringAngle_ = radian_t(0);
+    this->odom_.pose = start.pose;
+    this->odom_.twist = { Point2mps(this->speed_ * c, this->speed_ * s), rad_per_sec_t(0) };
+    this->poseHead_ = 0;
+    this->numPoses_ = 0;
+    this->measure();
+}
+
+void VehicleSim::step(const VehicleControl& control) {
+    const float64_t dt = second_t(this->params_.step).get();
+
+    // steering servo with limited rate, speed control with first order lag
+    const radian_t target = bcr::clamp(control.steeringAngle, -this->params_.maxSteeringAngle, this->params_.maxSteeringAngle);
+    const radian_t maxDelta = radian_t(this->params_.maxSteeringRate.get() * dt);
+    this->steeringAngle_ += bcr::clamp(target - this->steeringAngle_, -maxDelta, maxDelta);
+    this->speed_ += (control.speed - this->speed_) * this->speedGain_;
+
+    // kinematic bicycle model: the rear axle moves on a circle of radius wheelbase / tan(steering angle)
+    const OdometrySample sample = {
+        this->params_.step,
+        this->speed_,
+        rad_per_sec_t(this->speed_.get() * std::tan(this->steeringAngle_.get()) / this->params_.wheelbase.get())
+    };
+    this->odom_.update(&sample, 1);
+
+    ++this->numSteps_;
+    this->time_ = this->params_.step * static_cast<float64_t>(this->numSteps_);
+    this->measure();
+}
+
+void VehicleSim::measure() {
+    // speed and angular velocity measurements of the current state, delivered after the latency
+    const uint32_t numSensorSamples = static_cast<uint32_t>(this->sensorSamples_.size());
+    SensorSample& sample = this->sensorSamples_[this->numSteps_ % numSensorSamples];
+    sample.time = this->time_;
+    sample.speed = this->speed_ + this->params_.speedNoise * static_cast<float64_t>(this->random_.normal());
+    sample.ang_vel = this->odom_.twist.ang_vel + this->params_.angVelNoise * static_cast<float64_t>(this->random_.normal());
+
+    const uint32_t delayed = this->numSteps_ >= this->sensorLatencySteps_ ? this->numSteps_ - this->sensorLatencySteps_ : 0;
+    const SensorSample& available = this->sensorSamples_[delayed % numSensorSamples];
+    this->measurement_.time = this->time_;
+    this->measurement_.sensorTime = available.time;
+    this->measurement_.speed = available.speed;
+    this->measurement_.ang_vel = available.ang_vel;
+
+    // pose measurements are queued until their delivery - a pose is delivered latency steps after its capture,
+    // so at most latency / period + 1 poses are waiting, and the queue never overflows
+    const uint32_t maxPoses = static_cast<uint32_t>(this->poseSamples_.size());
+    if (this->posePeriodSteps_ > 0 && this->numSteps_ % this->posePeriodSteps_ == 0) {
+        PoseSample& pose = this->poseSamples_[(this->poseHead_ + this->numPoses_++) % maxPoses];
+        pose.time = this->time_;
+        pose.deliveryStep = this->numSteps_ + this->poseLatencySteps_;
+        pose.pose.pos.X = this->odom_.pose.pos.X + this->params_.posePosNoise * static_cast<float64_t>(this->random_.normal());
+        pose.pose.pos.Y = this->odom_.pose.pos.Y + this->params_.posePosNoise * static_cast<float64_t>(this->random_.normal());
+        pose.pose.angle = this->odom_.pose.angle + this->params_.poseAngleNoise * static_cast<float64_t>(this->random_.normal());
+    }
+
+    this->measurement_.hasPose = this->numPoses_ > 0 && this->poseSamples_[this->poseHead_].deliveryStep <= this->numSteps_;
+    if (this->measurement_.hasPose) {
+        const PoseSample& pose = this->poseSamples_[this->poseHead_];
+        this->measurement_.poseTime = pose.time;
+        this->measurement_.pose = pose.pose;
+        this->poseHead_ = (this->poseHead_ + 1) % maxPoses;
+        --this->numPoses_;
+    }
+}
+
+Status parseScenario(const char *text, VehicleScenario& result, uint32_t *errorLine) {
+    Status status = Status::OK;
+    uint32_t lineNumber = 0;
+
+    while (*text && status == Status::OK) {
+        ++lineNumber;
+        const char *end = std::strchr(text, '\n');
+        const size_t length = end ? static_cast<size_t>(end - text) : std::strlen(text);
+
+        char line[256];
+        if (length >= sizeof(line)) {
+            status = Status::INVALID_DATA;
+            break;
+        }
+        std::memcpy(line, text, length);
+        line[length] = '\0';
+        text += end ? length + 1 : length;
+
+        if (char *comment = std::strchr(line, '#')) {
+            *comment = '\0';
+        }
+
+        char key[64];
+        int32_t offset = 0;
+        if (std::sscanf(line, "%63s%n", key, &offset) != 1) {
+            continue;   // empty line
+        }
+
+        float64_t v[3];
+        const int32_t numValues = std::sscanf(line + offset, "%lf %lf %lf", &v[0], &v[1], &v[2]);
+        VehicleSimParams& p = result.params;
+
+        if      (!std::strcmp(key, "seed") && numValues == 1)                           p.seed = static_cast<uint32_t>(v[0]);
+        else if (!std::strcmp(key, "step_ms") && numValues == 1 && v[0] > 0)            p.step = millisecond_t(v[0]);
+        else if (!std::strcmp(key, "duration_s") && numValues == 1)                     result.duration = second_t(v[0]);
+        else if (!std::strcmp(key, "wheelbase_m") && numValues == 1 && v[0] > 0)        p.wheelbase = meter_t(v[0]);
+        else if (!std::strcmp(key, "max_steering_deg") && numValues == 1)               p.maxSteeringAngle = degree_t(v[0]);
+        else if (!std::strcmp(key, "max_steering_rate_deg_per_s") && numValues == 1)    p.maxSteeringRate = deg_per_sec_t(v[0]);
+        else if (!std::strcmp(key, "speed_time_constant_ms") && numValues == 1)         p.speedTimeConstant = millisecond_t(v[0]);
+        else if (!std::strcmp(key, "speed_noise_mps") && numValues == 1)                p.speedNoise = m_per_sec_t(v[0]);
+        else if (!std::strcmp(key, "ang_vel_noise_deg_per_s") && numValues == 1)        p.angVelNoise = deg_per_sec_t(v[0]);
+        else if (!std::strcmp(key, "sensor_latency_ms") && numValues == 1)              p.sensorLatency = millisecond_t(v[0]);
+        else if (!std::strcmp(key, "pose_period_ms") && numValues == 1)                 p.posePeriod = millisecond_t(v[0]);
+        else if (!std::strcmp(key, "pose_latency_ms") && numValues == 1)                p.poseLatency = millisecond_t(v[0]);
+        else if (!std::strcmp(key, "pose_noise_m") && numValues == 1)                   p.posePosNoise = meter_t(v[0]);
+        else if (!std::strcmp(key, "pose_noise_deg") && numValues == 1)                 p.poseAngleNoise = degree_t(v[0]);
+        else if (!std::strcmp(key, "target_speed_mps") && numValues == 1)               result.targetSpeed = m_per_sec_t(v[0]);
+        else if (!std::strcmp(key, "start") && numValues == 3)                          result.start.pose = { Point2m(meter_t(v[0]), meter_t(v[1])), degree_t(v[2]) };
+        else if (!std::strcmp(key, "point") && numValues == 2) {
+            if (!result.path.append(Point2m(meter_t(v[0]), meter_t(v[1])))) {
+                status = Status::BUFFER_FULL;
+            }
+        } else {
+            status = Status::INVALID_DATA;
+        }
+    }
+
+    if (errorLine) {
+        *errorLine = status == Status::OK ? 0 : lineNumber;
+    }
+    return status;
+}
+
+Status loadScenario(const char *fileName, VehicleScenario& result, uint32_t *errorLine) {
+    FILE *file = std::fopen(fileName, "rb");
+    if (!file) {
+        return Status::ERROR;
+    }
+
+    std::vector<char> text;
+    char buffer[4096];
+    size_t size;
+    while ((size = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.insert(text.end(), buffer, buffer + size);
+    }
+    const bool ok = !std::ferror(file);
+    std::fclose(file);
+    if (!ok) {
+        return Status::ERROR;
+    }
+
+    text.push_back('\0');
+    return parseScenario(text.data(), result, errorLine);
+}
+
+} // namespace bcr
@@ -0,0 +1,74 @@
+#include <babocar-core/binary_angle.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+TEST(binary_angle, conversion) {
+    EXPECT_EQ(0x4000u, bangle16_t(PI_2).get());
+    EXPECT_EQ(0x8000u, bangle16_t(PI).get());
+    EXPECT_EQ(0xc000u, bangle16_t(-PI_2).get());
+    EXPECT_EQ(0x20000000u, bangle32_t(PI_4).get());
+    EXPECT_EQ(bangle16_t(PI_2), bangle16_t(radian_t(PI_2.get() + 4 * PI.get())));
+    EXPECT_EQ(bangle32_t(-PI_4), bangle32_t(radian_t(-PI_4.get() - 20 * PI.get())));
+
+    EXPECT_NEAR(-PI.get(), bangle16_t(PI).toRadian().get(), 1e-9);
+    EXPECT_NEAR(PI.get(), bangle16_t(PI).toRadian360().get(), 1e-9);
+    EXPECT_NEAR(-PI_2.get(), bangle32_t(radian_t(3 * PI_2.get())).toRadian().get(), 1e-8);
+    EXPECT_NEAR(0.1234, bangle32_t(radian_t(0.1234)).toRadian().get(), 1e-8);
+}
+
+TEST(binary_angle, arithmetic) {
+    const bangle16_t a(radian_t(3.0)), b(radian_t(-3.0));
+    EXPECT_NEAR(6.0 - 2 * PI.get(), (a - b).toRadian().get(), 1e-3);
+    EXPECT_NEAR(0.0, (a + b).toRadian().get(), 1e-3);
+    EXPECT_EQ(bangle16_t::DEG_180(), bangle16_t::DEG_90() * 6);
+    EXPECT_EQ(bangle16_t::DEG_90(), -(bangle16_t::DEG_90() * 3));
+
+    // the product wraps around (0xffff * 0xffff would overflow int after the integral promotion)
+    EXPECT_EQ(1, (bangle16_t(0xffff, nullptr) * 0xffff).get());
+    EXPECT_EQ(1, (bangle16_t(0xffff, nullptr) * -1).get());
+    EXPECT_EQ(1u, (bangle32_t(0xffffffffu, nullptr) * -1).get());
+
+    bangle32_t c = bangle32_t::DEG_180();
+    c += bangle32_t::DEG_180();
+    EXPECT_EQ(bangle32_t::ZERO(), c);
+    c -= bangle32_t::DEG_45();
+    EXPECT_EQ(bangle32_t::DEG_45() * 7, c);
+
+    EXPECT_TRUE(eq(bangle16_t(radian_t(0.01)), bangle16_t(radian_t(-0.01)), bangle16_t(radian_t(0.03))));
+    EXPECT_FALSE(eq(bangle16_t(radian_t(0.01)), bangle16_t(radian_t(-0.01)), bangle16_t(radian_t(0.01))));
+    EXPECT_TRUE(eq(bangle16_t(radian_t(PI.get() - 0.01)), bangle16_t(radian_t(-PI.get() + 0.01)), bangle16_t(radian_t(0.03))));
+
+    // opposite directions - the difference is exactly 180 degrees
+    EXPECT_TRUE(eq(bangle32_t::DEG_180(), bangle32_t::ZERO(), bangle32_t::DEG_180()));
+    EXPECT_FALSE(eq(bangle32_t::DEG_180(), bangle32_t::ZERO(), bangle32_t::DEG_90()));
+    EXPECT_FALSE(eq(bangle16_t::ZERO(), bangle16_t::DEG_180(), bangle16_t::DEG_90()));
+}
+
+TEST(binary_angle, round) {
+    EXPECT_EQ(bangle16_t::DEG_45(), bangle16_t(radian_t(0.7)).round45());
+    EXPECT_EQ(bangle16_t::DEG_45() * 7, bangle16_t(radian_t(-0.7)).round45());
+    EXPECT_EQ(bangle16_t::ZERO(), bangle16_t(radian_t(-0.7)).round90());
+    EXPECT_EQ(bangle32_t::ZERO(), bangle32_t(radian_t(2 * PI.get() - 0.1)).round90());
+    EXPECT_EQ(bangle32_t::DEG_180(), bangle32_t(radian_t(-PI.get() + 0.5)).round90());
+}
+
+TEST(binary_angle, sin_cos) {
+    float64_t maxErrSin = 0, maxErrCos = 0;
+    for (uint32_t i = 0; i < (1u << 16); ++i) {
+        const bangle16_t a(static_cast<uint16_t>(i), nullptr);
+        const float64_t angle = a.toRadian().get();
+        maxErrSin = std::max(maxErrSin, std::abs(a.sin() - std::sin(angle)));
+        maxErrCos = std::max(maxErrCos, std::abs(a.cos() - std::cos(angle)));
+    }
+    EXPECT_LT(maxErrSin, 5e-6);
+    EXPECT_LT(maxErrCos, 5e-6);
+
+    for (uint32_t i = 0; i < 100000; ++i) {
+        const bangle32_t a(i * 42949u + 17u, nullptr);
+        const float64_t angle = a.toRadian().get();
+        EXPECT_NEAR(std::sin(angle), a.sin(), 5e-6);
+        EXPECT_NEAR(std::cos(angle), a.cos(), 5e-6);
+    }
+}
@@ -0,0 +1,60 @@
+#include <babocar-core/cluster_tracker.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+TEST(cluster_tracker, persistent_ids) {
+    ClusterTracker<4> tracker(meter_t(0.5));
+    uint32_t ids1[2], ids2[2];
+
+    const Point2m frame1[] = { { meter_t(0), meter_t(0) }, { meter_t(5), meter_t(5) } };
+    EXPECT_EQ(0, tracker.update(frame1, 2, second_t(0.1), ids1));
+    ASSERT_EQ(2, tracker.tracks().size());
+    EXPECT_NE(ids1[0], ids1[1]);
+
+    // clusters arrive in different order, slightly moved
+    const Point2m frame2[] = { { meter_t(5.1), meter_t(5) }, { meter_t(0.1), meter_t(0) } };
+    EXPECT_EQ(2, tracker.update(frame2, 2, second_t(0.1), ids2));
+    ASSERT_EQ(2, tracker.tracks().size());
+    EXPECT_EQ(ids1[0], ids2[1]);
+    EXPECT_EQ(ids1[1], ids2[0]);
+
+    for (const ClusterTracker<4>::Track& t : tracker.tracks()) {
+        EXPECT_NEAR(1.0, t.vel.X.get(), 0.0001);
+        EXPECT_NEAR(0.0, t.vel.Y.get(), 0.0001);
+    }
+}
+
+TEST(cluster_tracker, prediction) {
+    ClusterTracker<4> tracker(meter_t(0.3));
+    uint32_t id1, id2;
+
+    Point2m p(meter_t(0), meter_t(0));
+    tracker.update(&p, 1, second_t(0.1), &id1);
+
+    // moves with 2 m/sec, second step would be outside the gate without the velocity prediction
+    for (uint32_t i = 0; i < 5; ++i) {
+        p.X += meter_t(0.2);
+        tracker.update(&p, 1, second_t(0.1), &id2);
+        EXPECT_EQ(id1, id2);
+    }
+    ASSERT_EQ(1, tracker.tracks().size());
+    EXPECT_NEAR(2.0, tracker.tracks()[0].vel.X.get(), 0.0001);
+}
+
+TEST(cluster_tracker, missed_and_capacity) {
+    ClusterTracker<2> tracker(meter_t(0.5), 1);
+    uint32_t ids[3];
+
+    const Point2m frame1[] = { { meter_t(0), meter_t(0) }, { meter_t(5), meter_t(5) }, { meter_t(10), meter_t(10) } };
+    tracker.update(frame1, 3, second_t(0.1), ids);
+    EXPECT_EQ(2, tracker.tracks().size());
+    EXPECT_EQ(ClusterTracker<2>::INVALID_ID, ids[2]);
+
+    tracker.update(frame1, 0, second_t(0.1));
+    EXPECT_EQ(2, tracker.tracks().size());
+
+    tracker.update(frame1, 0, second_t(0.1));
+    EXPECT_EQ(0, tracker.tracks().size());
+}
@@ -0,0 +1,117 @@
+#include <babocar-core/distance_transform.hpp>
+#include <babocar-core/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+typedef DistanceTransform<128> transform_type;
+
+// compares the distances to the brute-force nearest occupied cells
+void expectExact(const transform_type& dt, const std::vector<Point2i>& occupied) {
+    for (uint32_t y = 0; y < 128; ++y) {
+        for (uint32_t x = 0; x < 128; ++x) {
+            float64_t min2 = std::numeric_limits<float64_t>::infinity();
+            for (const Point2i& o : occupied) {
+                const float64_t dx = o.X - static_cast<float64_t>(x), dy = o.Y - static_cast<float64_t>(y);
+                min2 = std::min(min2, dx * dx + dy * dy);
+            }
+            ASSERT_NEAR(std::sqrt(min2) * 0.1, dt.distance(x, y).get(), 1e-5) << "x: " << x << ", y: " << y;
+        }
+    }
+}
+
+} // namespace
+
+TEST(distance_transform, exact) {
+    xorshift32 random(3);
+    std::vector<Point2i> occupied;
+    for (uint32_t i = 0; i < 40; ++i) {
+        const int32_t x = random() % 128;
+        occupied.push_back(Point2i(x, random() % 128));
+    }
+
+    for (uint32_t numThreads = 1; numThreads <= 3; ++numThreads) {
+        const std::unique_ptr<transform_type> dt(new transform_type(meter_t(0.1)));
+        EXPECT_NEAR(25.6, dt->distance(5, 5).get(), 1e-5);  // no occupied cells
+        for (const Point2i& o : occupied) {
+            dt->set(o.X, o.Y, true);
+        }
+        EXPECT_EQ(128, dt->update(numThreads));
+        expectExact(*dt, occupied);
+        EXPECT_EQ(0, dt->update(numThreads));
+    }
+}
+
+TEST(distance_transform, incremental) {
+    const std::unique_ptr<transform_type> dt(new transform_type(meter_t(0.1)));
+    std::vector<Point2i> occupied;
+    for (int32_t i = 0; i < 128; i += 8) {
+        dt->set(i, 20, true);
+        dt->set(i, 100, true);
+        occupied.push_back(Point2i(i, 20));
+        occupied.push_back(Point2i(i, 100));
+    }
+    dt->update();
+    expectExact(*dt, occupied);
+
+    // a new cell only affects the columns between its occupied neighbours in its row
+    dt->set(50, 60, true);
+    occupied.push_back(Point2i(50, 60));
+    EXPECT_EQ(128, dt->update(2)); // the row has been empty
+    expectExact(*dt, occupied);
+
+    dt->set(52, 60, true);
+    occupied.push_back(Point2i(52, 60));
+    EXPECT_EQ(76, dt->update(2));  // columns 52 - 127, there is no occupied cell on the right
+    expectExact(*dt, occupied);
+
+    // removed cell
+    dt->set(48, 20, false);
+    occupied.erase(std::find(occupied.begin(), occupied.end(), Point2i(48, 20)));
+    EXPECT_EQ(7, dt->update());    // columns 45 - 51
+    expectExact(*dt, occupied);
+
+    // setting the same value does not trigger recalculation
+    dt->set(56, 20, true);
+    EXPECT_EQ(0, dt->update());
+}
+
+TEST(distance_transform, interpolation) {
+    const std::unique_ptr<transform_type> dt(new transform_type(meter_t(0.1), Point2m(meter_t(-6.4), meter_t(-6.4))));
+    dt->set(64, 64, true);  // cell center: (0.05, 0.05)
+    dt->update();
+
+    EXPECT_NEAR(0.0, dt->distance(Point2m(meter_t(0.05), meter_t(0.05))).get(), 1e-6);
+    EXPECT_NEAR(0.1, dt->distance(Point2m(meter_t(0.15), meter_t(0.05))).get(), 1e-6);
+    EXPECT_NEAR(0.05, dt->distance(Point2m(meter_t(0.1), meter_t(0.05))).get(), 1e-6);
+    EXPECT_NEAR(std::sqrt(0.02), dt->distance(Point2m(meter_t(-0.05), meter_t(0.15))).get(), 1e-6);
+    EXPECT_NEAR((0.1 + std::sqrt(0.02)) / 2, dt->distance(Point2m(meter_t(0.1), meter_t(0.15))).get(), 1e-6);
+    EXPECT_NEAR(0.03 * 0.1 + 0.07 * 0.0, dt->distance(Point2m(meter_t(0.053), meter_t(0.05))).get(), 1e-6);
+
+    // positions outside the grid are clamped to the border
+    EXPECT_NEAR(dt->distance(Point2m(meter_t(6.35), meter_t(0.05))).get(), dt->distance(Point2m(meter_t(100), meter_t(0.05))).get(), 1e-6);
+    EXPECT_NEAR(dt->distance(Point2m(meter_t(-6.35), meter_t(-6.35))).get(), dt->distance(Point2m(meter_t(-100), meter_t(-100))).get(), 1e-6);
+}
+
+TEST(distance_transform, occupancy_grid) {
+    typedef OccupancyGrid<8, 4> grid_type;
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.05)));
+    grid->recenter(Point2m(meter_t(10), meter_t(-3)));
+    grid->castRay(Point2m(meter_t(10), meter_t(-3)), Point2m(meter_t(11.02), meter_t(-3)));
+    grid->applyUpdates();
+
+    const std::unique_ptr<transform_type> dt(new transform_type(meter_t(1)));
+    dt->assign(*grid);
+    dt->update();
+    EXPECT_NEAR(0.05, dt->resolution().get(), 1e-12);
+    EXPECT_NEAR(0.0, dt->distance(Point2m(meter_t(11.025), meter_t(-2.975))).get(), 1e-6);
+    EXPECT_NEAR(1.0, dt->distance(Point2m(meter_t(10.025), meter_t(-2.975))).get(), 1e-5);
+    EXPECT_NEAR(0.5, dt->distance(Point2m(meter_t(11.025), meter_t(-2.475))).get(), 1e-5);
+}
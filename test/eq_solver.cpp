@@ -29,4 +29,226 @@ TEST(eq_solver, solve_quadratic_2_solutions) {
 
     EXPECT_EQ(3.0f, result.first);
     EXPECT_EQ(1.0f, result.second);
-}
\ No newline at end of file
+}
+
+TEST(eq_solver, solve_quadratic_cancellation) {
+    // 0 = x^2 + 1e4*x + 1, solutions: -5000 +- sqrt(25e6 - 1)
+    // the textbook formula calculates the smaller root as the difference of two nearly equal numbers
+    const std::pair<float32_t, float32_t> result = bcr::solve_quadratic(1.0f, 1.0e4f, 1.0f);
+
+    EXPECT_NEAR(-1.0e-4f, result.first, 1.0e-10f);
+    EXPECT_NEAR(-1.0e4f, result.second, 1.0e-3f);
+}
+
+TEST(eq_solver, solve_quadratic_linear) {
+    // 0 = 2*x - 4
+    // solution: 2
+    std::pair<float64_t, float64_t> result = bcr::solve_quadratic(0.0, 2.0, -4.0);
+    EXPECT_EQ(2.0, result.first);
+    EXPECT_TRUE(std::isnan(result.second));
+
+    // 0 = 1
+    // no solutions
+    result = bcr::solve_quadratic(0.0, 0.0, 1.0);
+    EXPECT_TRUE(std::isnan(result.first));
+    EXPECT_TRUE(std::isnan(result.second));
+}
+
+TEST(eq_solver, solve_quadratic_batch) {
+    const float64_t A[] = { 1.0, 1.0, 1.0, 0.0, -2.0, 1.0 };
+    const float64_t B[] = { -4.0, -4.0, -4.0, 2.0, 0.0, 1.0e8 };
+    const float64_t C[] = { 5.0, 4.0, 3.0, -4.0, 8.0, 1.0 };
+    float64_t x1[6], x2[6];
+    uint32_t numRoots[6];
+
+    EXPECT_EQ(5, bcr::solve_quadratic(A, B, C, 6, x1, x2, numRoots));
+
+    for (uint32_t i = 0; i < 6; ++i) {
+        const std::pair<float64_t, float64_t> expected = bcr::solve_quadratic(A[i], B[i], C[i]);
+        EXPECT_EQ(std::isnan(expected.first) ? 0 : std::isnan(expected.second) ? 1 : 2, numRoots[i]);
+        if (numRoots[i] > 0) {
+            EXPECT_EQ(expected.first, x1[i]);
+        } else {
+            EXPECT_TRUE(std::isnan(x1[i]));
+        }
+        if (numRoots[i] > 1) {
+            EXPECT_EQ(expected.second, x2[i]);
+        } else {
+            EXPECT_TRUE(std::isnan(x2[i]));
+        }
+    }
+
+    EXPECT_EQ(3.0, x1[2]);
+    EXPECT_EQ(1.0, x2[2]);
+    EXPECT_EQ(-2.0, x1[4]);
+    EXPECT_EQ(2.0, x2[4]);
+    EXPECT_NEAR(-1.0e-8, x1[5], 1.0e-20);
+}
+
+TEST(eq_solver, solve_cubic) {
+    float64_t roots[3];
+
+    // (x - 1) * (x - 2) * (x - 3) = x^3 - 6x^2 + 11x - 6
+    ASSERT_EQ(3, bcr::solve_cubic(1.0, -6.0, 11.0, -6.0, roots));
+    EXPECT_NEAR(1.0, roots[0], 1e-14);
+    EXPECT_NEAR(2.0, roots[1], 1e-14);
+    EXPECT_NEAR(3.0, roots[2], 1e-14);
+
+    // (x - 2) * (x^2 + 1) = x^3 - 2x^2 + x - 2
+    ASSERT_EQ(1, bcr::solve_cubic(1.0, -2.0, 1.0, -2.0, roots));
+    EXPECT_NEAR(2.0, roots[0], 1e-14);
+
+    // -2 * (x + 1)^2 * (x - 2) = -2x^3 + 6x + 4 - double root
+    const uint32_t n = bcr::solve_cubic(-2.0, 0.0, 6.0, 4.0, roots);
+    ASSERT_GE(n, 2);
+    EXPECT_NEAR(-1.0, roots[0], 1e-7);
+    EXPECT_NEAR(2.0, roots[n - 1], 1e-14);
+
+    // degenerates to quadratic
+    ASSERT_EQ(2, bcr::solve_cubic(0.0, 1.0, -4.0, 3.0, roots));
+    EXPECT_NEAR(1.0, roots[0], 1e-14);
+    EXPECT_NEAR(3.0, roots[1], 1e-14);
+
+    // widely separated roots: (x - 1e-3) * (x - 1) * (x - 1e3)
+    float32_t rootsf[3];
+    ASSERT_EQ(3, bcr::solve_cubic(1.0f, -1001.001f, 1001.001f, -1.0f, rootsf));
+    EXPECT_NEAR(1e-3f, rootsf[0], 1e-9f);
+    EXPECT_NEAR(1.0f, rootsf[1], 1e-6f);
+    EXPECT_NEAR(1e3f, rootsf[2], 1e-3f);
+}
+
+TEST(eq_solver, solve_quartic) {
+    float64_t roots[4];
+
+    // (x + 2) * (x + 1) * (x - 1) * (x - 3) = x^4 - x^3 - 7x^2 + x + 6
+    ASSERT_EQ(4, bcr::solve_quartic(1.0, -1.0, -7.0, 1.0, 6.0, roots));
+    EXPECT_NEAR(-2.0, roots[0], 1e-13);
+    EXPECT_NEAR(-1.0, roots[1], 1e-13);
+    EXPECT_NEAR(1.0, roots[2], 1e-13);
+    EXPECT_NEAR(3.0, roots[3], 1e-13);
+
+    // biquadratic: (x^2 - 4) * (x^2 - 9)
+    ASSERT_EQ(4, bcr::solve_quartic(2.0, 0.0, -26.0, 0.0, 72.0, roots));
+    EXPECT_NEAR(-3.0, roots[0], 1e-13);
+    EXPECT_NEAR(-2.0, roots[1], 1e-13);
+    EXPECT_NEAR(2.0, roots[2], 1e-13);
+    EXPECT_NEAR(3.0, roots[3], 1e-13);
+
+    // (x - 1) * (x - 2) * (x^2 + 1) = x^4 - 3x^3 + 3x^2 - 3x + 2
+    ASSERT_EQ(2, bcr::solve_quartic(1.0, -3.0, 3.0, -3.0, 2.0, roots));
+    EXPECT_NEAR(1.0, roots[0], 1e-13);
+    EXPECT_NEAR(2.0, roots[1], 1e-13);
+
+    // no real roots: (x^2 + 1) * (x^2 + 2)
+    EXPECT_EQ(0, bcr::solve_quartic(1.0, 0.0, 3.0, 0.0, 2.0, roots));
+
+    // degenerates to cubic
+    ASSERT_EQ(3, bcr::solve_quartic(0.0, 1.0, -6.0, 11.0, -6.0, roots));
+    EXPECT_NEAR(1.0, roots[0], 1e-14);
+    EXPECT_NEAR(3.0, roots[2], 1e-14);
+}
+
+TEST(eq_solver, solve_cubic_quartic_close_roots) {
+    float64_t roots[4];
+
+    // (x - 0.001) * (x - 0.002) - the discriminant of the quadratic is 1e-6
+    ASSERT_EQ(2, bcr::solve_cubic(0.0, 1.0, -0.003, 2e-6, roots));
+    EXPECT_NEAR(0.001, roots[0], 1e-15);
+    EXPECT_NEAR(0.002, roots[1], 1e-15);
+
+    // (x - 0.001) * (x - 0.002) * (x - 1) * (x - 2)
+    ASSERT_EQ(4, bcr::solve_quartic(1.0, -3.003, 2.009002, -0.006006, 4e-6, roots));
+    EXPECT_NEAR(0.001, roots[0], 1e-15);
+    EXPECT_NEAR(0.002, roots[1], 1e-15);
+    EXPECT_NEAR(1.0, roots[2], 1e-13);
+    EXPECT_NEAR(2.0, roots[3], 1e-13);
+
+    // the quadratic factors of Ferrari's method can not separate the small roots in float, the polynomial can
+    float32_t rootsf[4];
+    ASSERT_EQ(4, bcr::solve_quartic(1.0f, -3.003f, 2.009002f, -0.006006f, 4e-6f, rootsf));
+    EXPECT_NEAR(0.001f, rootsf[0], 1e-7f);
+    EXPECT_NEAR(0.002f, rootsf[1], 1e-7f);
+
+    // biquadratic: (x^2 - 1e-6) * (x^2 - 4e-6)
+    ASSERT_EQ(4, bcr::solve_quartic(1.0, 0.0, -5e-6, 0.0, 4e-12, roots));
+    EXPECT_NEAR(-0.002, roots[0], 1e-15);
+    EXPECT_NEAR(-0.001, roots[1], 1e-15);
+    EXPECT_NEAR(0.001, roots[2], 1e-15);
+    EXPECT_NEAR(0.002, roots[3], 1e-15);
+
+    // (x - 1) * (x - 1.0001) * (x - 5), and a close complex pair: (x - 2) * ((x - 1)^2 + 1e-8)
+    ASSERT_EQ(3, bcr::solve_cubic(1.0, -7.0001, 11.0006, -5.0005, roots));
+    EXPECT_NEAR(1.0, roots[0], 1e-9);
+    EXPECT_NEAR(1.0001, roots[1], 1e-9);
+    ASSERT_EQ(1, bcr::solve_cubic(1.0, -4.0, 5.00000001, -2.00000002, roots));
+    EXPECT_NEAR(2.0, roots[0], 1e-14);
+}
+
+TEST(eq_solver, solve_polynomial) {
+    float64_t roots[6];
+
+    // (x + 2) * (x + 1) * x * (x - 1) * (x - 2) * (x - 3) = x^6 - 3x^5 - 5x^4 + 15x^3 + 4x^2 - 12x
+    const float64_t coeffs[] = { 0.0, -12.0, 4.0, 15.0, -5.0, -3.0, 1.0 };
+    ASSERT_EQ(6, bcr::solve_polynomial<8>(coeffs, 6, -10.0, 10.0, roots));
+    for (uint32_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(static_cast<float64_t>(i) - 2.0, roots[i], 1e-12);
+    }
+
+    // only the roots inside the interval
+    ASSERT_EQ(3, bcr::solve_polynomial<8>(coeffs, 6, -0.5, 2.5, roots));
+    EXPECT_NEAR(0.0, roots[0], 1e-12);
+    EXPECT_NEAR(1.0, roots[1], 1e-12);
+    EXPECT_NEAR(2.0, roots[2], 1e-12);
+
+    // double root: (x - 1)^2 * (x + 1) = x^3 - x^2 - x + 1
+    const float64_t coeffs2[] = { 1.0, -1.0, -1.0, 1.0 };
+    ASSERT_EQ(2, bcr::solve_polynomial<3>(coeffs2, 3, -5.0, 5.0, roots));
+    EXPECT_NEAR(-1.0, roots[0], 1e-12);
+    EXPECT_NEAR(1.0, roots[1], 1e-12);
+
+    // float, roots 4.18, 6.29, 7.72 and 8.58 - the value at the root of the derivative between the two largest roots
+    // is within the rounding error bound, but the sign changes on both sides of it
+    const float32_t coeffs4[] = { 135778.125f, -119628.32f, 43149.0781f, -8180.42383f, 861.76355f, -47.9166374f, 1.10028315f };
+    float32_t roots4[6];
+    ASSERT_EQ(4, bcr::solve_polynomial<6>(coeffs4, 6, -20.0f, 20.0f, roots4));
+    EXPECT_NEAR(4.182667f, roots4[0], 1e-2f);
+    EXPECT_NEAR(6.292382f, roots4[1], 1e-2f);
+    EXPECT_NEAR(7.720714f, roots4[2], 2e-2f);
+    EXPECT_NEAR(8.580436f, roots4[3], 2e-2f);
+
+    // linear
+    const float32_t coeffs3[] = { -3.0f, 2.0f };
+    float32_t rootsf[1];
+    ASSERT_EQ(1, bcr::solve_polynomial<4>(coeffs3, 1, 0.0f, 10.0f, rootsf));
+    EXPECT_NEAR(1.5f, rootsf[0], 1e-6f);
+    EXPECT_EQ(0, bcr::solve_polynomial<4>(coeffs3, 1, 2.0f, 10.0f, rootsf));
+}
+
+TEST(eq_solver, solve_cubic_quartic_batch) {
+    const float64_t A[] = { 1.0, 1.0 };
+    const float64_t B[] = { -6.0, -2.0 };
+    const float64_t C[] = { 11.0, 1.0 };
+    const float64_t D[] = { -6.0, -2.0 };
+    float64_t roots[8];
+    uint32_t numRoots[2];
+
+    bcr::solve_cubic(A, B, C, D, 2, roots, numRoots);
+    EXPECT_EQ(3, numRoots[0]);
+    EXPECT_EQ(1, numRoots[1]);
+    EXPECT_NEAR(1.0, roots[0], 1e-14);
+    EXPECT_NEAR(2.0, roots[1], 1e-14);
+    EXPECT_NEAR(2.0, roots[2], 1e-14);
+    EXPECT_TRUE(std::isnan(roots[3]));
+    EXPECT_NEAR(3.0, roots[4], 1e-14);
+    EXPECT_TRUE(std::isnan(roots[5]));
+
+    const float64_t E[] = { 6.0, 2.0 };
+    const float64_t A4[] = { 1.0, 1.0 }, B4[] = { -1.0, -3.0 }, C4[] = { -7.0, 3.0 }, D4[] = { 1.0, -3.0 };
+    bcr::solve_quartic(A4, B4, C4, D4, E, 2, roots, numRoots);
+    EXPECT_EQ(4, numRoots[0]);
+    EXPECT_EQ(2, numRoots[1]);
+    EXPECT_NEAR(-2.0, roots[0], 1e-13);
+    EXPECT_NEAR(1.0, roots[1], 1e-13);
+    EXPECT_NEAR(3.0, roots[6], 1e-13);
+    EXPECT_TRUE(std::isnan(roots[7]));
+}
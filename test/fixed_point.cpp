@@ -0,0 +1,129 @@
+#include <babocar-core/unit_utils.hpp>
+#include <babocar-core/random.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+template <typename F>
+void checkArithmetic(float64_t range, float64_t eps) {
+    xorshift32 random(7);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        const float64_t a = (random.uniform01() * 2 - 1) * range, b = (random.uniform01() * 2 - 1) * range;
+        const F fa(a), fb(b);
+        EXPECT_NEAR(a + b, static_cast<float64_t>(fa + fb), eps);
+        EXPECT_NEAR(a - b, static_cast<float64_t>(fa - fb), eps);
+        EXPECT_NEAR(a * b, static_cast<float64_t>(fa * fb), eps * range * 2);
+        if (std::abs(b) > 1.0) {
+            EXPECT_NEAR(a / b, static_cast<float64_t>(fa / fb), eps * range);
+        }
+    }
+}
+
+} // namespace
+
+TEST(fixed_point, conversion) {
+    EXPECT_EQ(65536, q16_16_t(1.0).raw());
+    EXPECT_EQ(-98304, q16_16_t(-1.5f).raw());
+    EXPECT_EQ(3 * 65536, q16_16_t(3).raw());
+    EXPECT_EQ(static_cast<int64_t>(1) << 32, q32_32_t(1.0).raw());
+    EXPECT_EQ(-2, static_cast<int32_t>(q16_16_t(-2.75)));
+    EXPECT_NEAR(0.1, static_cast<float64_t>(q32_32_t(0.1)), 1e-9);
+
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t(1e6));
+    EXPECT_EQ(q16_16_t::MIN(), q16_16_t(-40000));
+    EXPECT_EQ(q32_32_t::MAX(), q32_32_t(1e20));
+
+    EXPECT_EQ(q32_32_t(-1.25), q32_32_t(q16_16_t(-1.25)));
+    EXPECT_EQ(q16_16_t(-1.25), q16_16_t(q32_32_t(-1.25)));
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t(q32_32_t(100000)));
+}
+
+TEST(fixed_point, arithmetic) {
+    checkArithmetic<q16_16_t>(100.0, 1e-4);
+    checkArithmetic<q32_32_t>(10000.0, 1e-8);
+
+    EXPECT_EQ(q16_16_t(-0.75), -q16_16_t(0.75));
+    EXPECT_EQ(q16_16_t(7.5), q16_16_t(2.5) * 3);
+    EXPECT_EQ(q16_16_t(-0.5), q16_16_t(1.5) / -3);
+    EXPECT_EQ(q32_32_t(-7.5), 3 * q32_32_t(-2.5));
+
+    q16_16_t x(1.0);
+    x += q16_16_t(0.5);
+    x *= 2;
+    x -= 1;
+    x /= q16_16_t(4.0);
+    EXPECT_EQ(q16_16_t(0.5), x);
+}
+
+TEST(fixed_point, saturation) {
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t(30000) + q16_16_t(30000));
+    EXPECT_EQ(q16_16_t::MIN(), q16_16_t(-30000) - q16_16_t(30000));
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t(-300) * q16_16_t(-300));
+    EXPECT_EQ(q16_16_t::MIN(), q16_16_t(300) * -300);
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t(1) / q16_16_t(0));
+    EXPECT_EQ(q16_16_t::MAX(), -q16_16_t::MIN());
+
+    EXPECT_EQ(q32_32_t::MAX(), q32_32_t(2000000000) + q32_32_t(2000000000));
+    EXPECT_EQ(q32_32_t::MIN(), q32_32_t(100000) * q32_32_t(-100000));
+    EXPECT_EQ(q32_32_t::MAX(), q32_32_t(100000) / q32_32_t(0.00001));
+    EXPECT_EQ(q32_32_t::MIN(), q32_32_t(-1) / q32_32_t(0));
+
+    // integer division of the extreme values must not overflow while rounding
+    EXPECT_EQ(21474836, (q16_16_t::MAX() / 100).raw());
+    EXPECT_EQ(-21474836, (q16_16_t::MIN() / 100).raw());
+    EXPECT_EQ(1073741824, (q16_16_t::MAX() / 2).raw());
+    EXPECT_EQ(-1073741824, (q16_16_t::MIN() / 2).raw());
+    EXPECT_EQ(-1073741824, (q16_16_t::MAX() / -2).raw());
+    EXPECT_EQ(-q16_16_t::MAX(), q16_16_t::MAX() / -1);
+    EXPECT_EQ(q16_16_t::MAX(), q16_16_t::MIN() / -1);
+    EXPECT_EQ(q16_16_t::MIN(), q16_16_t::MIN() / 1);
+    EXPECT_EQ(92233720368547758, (q32_32_t::MAX() / 100).raw());
+    EXPECT_EQ(-92233720368547758, (q32_32_t::MIN() / 100).raw());
+}
+
+TEST(fixed_point, units) {
+    typedef with_storage<meter_t, q16_16_t> meter_q16_t;
+    typedef with_storage<centimeter_t, q16_16_t> centimeter_q16_t;
+    typedef with_storage<m_per_sec_t, q16_16_t> m_per_sec_q16_t;
+    typedef with_storage<second_t, q16_16_t> second_q16_t;
+    typedef with_storage<degree_t, q32_32_t> degree_q32_t;
+    typedef with_storage<radian_t, q32_32_t> radian_q32_t;
+
+    static_assert(sizeof(meter_q16_t) == sizeof(int32_t), "meter_q16_t must be stored as int32_t");
+    static_assert(std::is_convertible<meter_q16_t, with_storage<meter_t, q32_32_t>>::value, "Q16.16 to Q32.32 conversion must be implicit");
+    static_assert(!std::is_convertible<meter_t, meter_q16_t>::value, "Floating-point to fixed-point conversion must be explicit");
+
+    const meter_q16_t m(q16_16_t(1.5));
+    const centimeter_q16_t cm = m;
+    EXPECT_EQ(q16_16_t(150), cm.get());
+    EXPECT_EQ(q16_16_t(1.5), meter_q16_t(cm).get());
+    EXPECT_EQ(21474836, meter_q16_t(centimeter_q16_t(q16_16_t::MAX())).get().raw());
+
+    // the reciprocal ratios (1e12 and 3.6e9) do not fit in the raw type of Q16.16
+    typedef with_storage<nanosecond_t, q16_16_t> nanosecond_q16_t;
+    typedef with_storage<kilosecond_t, q16_16_t> kilosecond_q16_t;
+    typedef with_storage<microsecond_t, q16_16_t> microsecond_q16_t;
+    typedef with_storage<hour_t, q16_16_t> hour_q16_t;
+    EXPECT_EQ(0, kilosecond_q16_t(nanosecond_q16_t(q16_16_t(30000))).get().raw());
+    EXPECT_EQ(-1, hour_q16_t(microsecond_q16_t(q16_16_t(-30000))).get().raw());     // -0.546 raw units
+    EXPECT_EQ(0, hour_q16_t(microsecond_q16_t(q16_16_t(-20000))).get().raw());      // -0.364 raw units
+    EXPECT_EQ(0, (q16_16_t::MAX() / INT64_MIN).raw());
+    EXPECT_EQ(-1, (q16_16_t::MIN() / static_cast<uint64_t>(0xffffffffu)).raw());
+    EXPECT_EQ(q16_16_t(2.25), (m + centimeter_q16_t(q16_16_t(75))).get());
+    EXPECT_TRUE(m < centimeter_q16_t(q16_16_t(151)));
+
+    const meter_q16_t s = m_per_sec_q16_t(q16_16_t(2.5)) * second_q16_t(q16_16_t(0.5));
+    EXPECT_EQ(q16_16_t(1.25), s.get());
+
+    const radian_q32_t angle = degree_q32_t(q32_32_t(90));
+    EXPECT_NEAR(PI_2.get(), static_cast<float64_t>(angle.get()), 1e-7);
+
+    // conversion at the boundary
+    EXPECT_NEAR(1.5f, meter_f_t(m).get(), 1e-6);
+    EXPECT_NEAR(150.0, centimeter_t(m).get(), 1e-6);
+    EXPECT_EQ(q16_16_t(0.25), meter_q16_t(centimeter_f_t(25.0f)).get());
+    EXPECT_EQ(q16_16_t::MAX(), meter_q16_t(kilometer_t(100.0)).get());
+}
@@ -0,0 +1,143 @@
+#include <babocar-core/icp_matcher.hpp>
+#include <babocar-core/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace bcr;
+
+namespace {
+
+typedef IcpMatcher<2048> matcher_type;
+
+// samples the outline of an L-shaped room (with no symmetry) in order, starting at the given fraction of the sample spacing
+uint32_t sampleRoom(float32_t phase, float32_t spacing, Point2f *points, uint32_t maxPoints) {
+    static const Point2f corners[] = {
+        { 0.0f, 0.0f }, { 6.0f, 0.0f }, { 6.0f, 2.5f }, { 3.5f, 2.5f }, { 3.5f, 5.0f }, { 0.0f, 5.0f }
+    };
+    static constexpr uint32_t NUM_CORNERS = sizeof(corners) / sizeof(corners[0]);
+
+    uint32_t n = 0;
+    for (uint32_t c = 0; c < NUM_CORNERS; ++c) {
+        const Point2f& a = corners[c];
+        const Point2f& b = corners[(c + 1) % NUM_CORNERS];
+        const float32_t length = std::hypot(b.X - a.X, b.Y - a.Y);
+        for (float32_t d = phase * spacing; d < length && n < maxPoints; d += spacing) {
+            const float32_t t = d / length;
+            points[n++] = Point2f(a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t);
+        }
+    }
+    return n;
+}
+
+struct MatchTest : public ::testing::TestWithParam<matcher_type::Metric> {
+    // point-to-point matching of differently sampled walls has a bias along the walls, up to half of the sample spacing
+    float64_t tolerance(float64_t pointToLine) const {
+        return GetParam() == matcher_type::Metric::POINT_TO_POINT ? 0.01 : pointToLine;
+    }
+};
+
+} // namespace
+
+TEST_P(MatchTest, converges) {
+    const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5), GetParam()));
+    Point2f ref[2048], points[2048];
+    const uint32_t numRef = sampleRoom(0.0f, 0.02f, ref, 2048);
+    const uint32_t numPoints = sampleRoom(0.5f, 0.02f, points, 2048);
+
+    // the points are seen from a moved sensor: they are given in a frame that is transformed relative to the reference frame
+    const SE2f expected(Point2f(0.15f, -0.1f), radian_t(0.08));
+    expected.inverse().apply(points, points, numPoints);
+    matcher->setReference(ref, numRef);
+
+    SE2f transform;
+    const matcher_type::Result result = matcher->match(points, numPoints, transform);
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.numInliers, numPoints * 9 / 10);
+    EXPECT_LT(result.error.get(), 0.01);
+    EXPECT_NEAR(expected.translation().X, transform.translation().X, tolerance(1e-3));
+    EXPECT_NEAR(expected.translation().Y, transform.translation().Y, tolerance(1e-3));
+    EXPECT_NEAR(expected.angle().get(), transform.angle().get(), tolerance(1e-3));
+}
+
+TEST_P(MatchTest, outliers) {
+    const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5), GetParam()));
+    Point2f ref[2048], points[2048];
+    const uint32_t numRef = sampleRoom(0.0f, 0.02f, ref, 2048);
+    const uint32_t numPoints = sampleRoom(0.5f, 0.02f, points, 2048);
+
+    // every 5th point is moved off the walls by up to 0.4 m (e.g. people or other cars)
+    xorshift32 random(3);
+    for (uint32_t i = 0; i < numPoints; i += 5) {
+        points[i].X += 0.1f + 0.3f * random.uniform01();
+        points[i].Y -= 0.1f + 0.3f * random.uniform01();
+    }
+
+    const SE2f expected(Point2f(-0.1f, 0.05f), radian_t(-0.05));
+    expected.inverse().apply(points, points, numPoints);
+    matcher->setReference(ref, numRef);
+
+    SE2f transform;
+    const matcher_type::Result result = matcher->match(points, numPoints, transform);
+    EXPECT_GT(result.numInliers, 0u);
+    EXPECT_LT(result.numInliers, numPoints * 9 / 10);
+    EXPECT_NEAR(expected.translation().X, transform.translation().X, tolerance(2e-3));
+    EXPECT_NEAR(expected.translation().Y, transform.translation().Y, tolerance(2e-3));
+    EXPECT_NEAR(expected.angle().get(), transform.angle().get(), tolerance(1e-3));
+}
+
+TEST_P(MatchTest, multithreaded) {
+    const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5), GetParam()));
+    Point2f ref[2048], points[2048];
+    const uint32_t numRef = sampleRoom(0.0f, 0.02f, ref, 2048);
+    const uint32_t numPoints = sampleRoom(0.3f, 0.02f, points, 2048);
+    SE2f(Point2f(0.1f, 0.1f), radian_t(0.05)).apply(points, points, numPoints);
+    matcher->setReference(ref, numRef);
+
+    SE2f expected;
+    const matcher_type::Result expectedResult = matcher->match(points, numPoints, expected, 1);
+
+    for (uint32_t numThreads = 2; numThreads <= 4; ++numThreads) {
+        SE2f transform;
+        const matcher_type::Result result = matcher->match(points, numPoints, transform, numThreads);
+        EXPECT_EQ(expectedResult.iterations, result.iterations);
+        EXPECT_EQ(expectedResult.numInliers, result.numInliers);
+        EXPECT_NEAR(expected.translation().X, transform.translation().X, 1e-5);
+        EXPECT_NEAR(expected.translation().Y, transform.translation().Y, 1e-5);
+        EXPECT_NEAR(expected.angle().get(), transform.angle().get(), 1e-5);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(icp_matcher, MatchTest, ::testing::Values(matcher_type::Metric::POINT_TO_POINT, matcher_type::Metric::POINT_TO_LINE));
+
+TEST(icp_matcher, early_exit) {
+    const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5)));
+    Point2f ref[2048];
+    const uint32_t numRef = sampleRoom(0.0f, 0.02f, ref, 2048);
+    matcher->setReference(ref, numRef);
+
+    SE2f transform;
+    const matcher_type::Result result = matcher->match(ref, numRef, transform);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(1, result.iterations);
+    EXPECT_EQ(numRef, result.numInliers);
+    EXPECT_NEAR(0.0, result.error.get(), 1e-6);
+}
+
+TEST(icp_matcher, no_correspondences) {
+    const std::unique_ptr<matcher_type> matcher(new matcher_type(meter_t(0.5)));
+    Point2f ref[2048];
+    const uint32_t numRef = sampleRoom(0.0f, 0.02f, ref, 2048);
+    matcher->setReference(ref, numRef);
+
+    // the initial guess is too far from the reference
+    const SE2f initial(Point2f(20.0f, 0.0f), radian_t(0.1));
+    SE2f transform = initial;
+    const matcher_type::Result result = matcher->match(ref, numRef, transform);
+    EXPECT_EQ(0, result.numInliers);
+    EXPECT_EQ(0, result.iterations);
+    EXPECT_FALSE(result.converged);
+    EXPECT_EQ(initial.translation().X, transform.translation().X);
+    EXPECT_EQ(initial.angle().get(), transform.angle().get());
+}
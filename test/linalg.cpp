@@ -69,6 +69,105 @@ TEST(linalg, lineCircle_intersection_2_solutions_2) {
     EXPECT_NEAR(9.0 - std::sqrt(2), intersections.second.Y, 0.0001);
 }
 
+TEST(linalg, segmentCircle_intersection_clamped) {
+    const Point2d circleCenter(4.0, 5.0);
+    const float64_t circleRadius = 2.0;
+
+    // segment crosses the circle
+    std::pair<Point2d, Point2d> intersections = bcr::segmentCircle_intersection(Point2d(0.0, 5.0), Point2d(10.0, 5.0), circleCenter, circleRadius);
+    EXPECT_NEAR(2.0, intersections.first.X, 1e-9);
+    EXPECT_NEAR(5.0, intersections.first.Y, 1e-9);
+    EXPECT_NEAR(6.0, intersections.second.X, 1e-9);
+    EXPECT_NEAR(5.0, intersections.second.Y, 1e-9);
+
+    // segment ends inside the circle - only the entry point is on the segment
+    intersections = bcr::segmentCircle_intersection(Point2d(0.0, 5.0), Point2d(4.0, 5.0), circleCenter, circleRadius);
+    EXPECT_NEAR(2.0, intersections.first.X, 1e-9);
+    EXPECT_TRUE(std::isnan(intersections.second.X));
+
+    // segment starts inside the circle, in reverse direction - only the exit point is on the segment
+    intersections = bcr::segmentCircle_intersection(Point2d(4.0, 5.0), Point2d(0.0, 5.0), circleCenter, circleRadius);
+    EXPECT_NEAR(2.0, intersections.first.X, 1e-9);
+    EXPECT_TRUE(std::isnan(intersections.second.X));
+
+    // the line intersects the circle, but the segment does not
+    intersections = bcr::segmentCircle_intersection(Point2d(7.0, 5.0), Point2d(10.0, 5.0), circleCenter, circleRadius);
+    EXPECT_TRUE(std::isnan(intersections.first.X));
+    EXPECT_TRUE(std::isnan(intersections.second.X));
+
+    // vertical segment
+    intersections = bcr::segmentCircle_intersection(Point2d(4.0, 0.0), Point2d(4.0, 10.0), circleCenter, circleRadius);
+    EXPECT_NEAR(4.0, intersections.first.X, 1e-9);
+    EXPECT_NEAR(3.0, intersections.first.Y, 1e-9);
+    EXPECT_NEAR(4.0, intersections.second.X, 1e-9);
+    EXPECT_NEAR(7.0, intersections.second.Y, 1e-9);
+
+    // degenerate segment
+    intersections = bcr::segmentCircle_intersection(Point2d(2.0, 5.0), Point2d(2.0, 5.0), circleCenter, circleRadius);
+    EXPECT_TRUE(std::isnan(intersections.first.X));
+}
+
+TEST(linalg, segmentCircle_intersection_precision) {
+    // long segment far from the circle center - the textbook formula loses the intersection near the segment start
+    const Point2f p1(1000.0f, 0.1f), p2(-1000.0f, 0.1f);
+    const std::pair<Point2f, Point2f> intersections = bcr::segmentCircle_intersection(p1, p2, Point2f(999.0f, 0.0f), 1.0f);
+    EXPECT_NEAR(999.0f + std::sqrt(0.99f), intersections.first.X, 1e-3f);
+    EXPECT_NEAR(999.0f - std::sqrt(0.99f), intersections.second.X, 1e-3f);
+}
+
+TEST(linalg, segmentCircle_exit) {
+    // polyline: (0, 0) -> (10, 0) -> (10, 10) -> (0, 10)
+    const float32_t x[] = { 0.0f, 10.0f, 10.0f, 0.0f };
+    const float32_t y[] = { 0.0f, 0.0f, 10.0f, 10.0f };
+    float32_t t[3];
+
+    EXPECT_EQ(1, bcr::segmentCircle_exit(x, y, 4, Point2f(8.0f, 1.0f), 5.0f, t));
+    EXPECT_TRUE(std::isnan(t[0]));     // first segment ends inside the circle
+    EXPECT_NEAR(0.1f * (1.0f + std::sqrt(21.0f)), t[1], 1e-6f);    // exits at (10, 1 + sqrt(21))
+    EXPECT_TRUE(std::isnan(t[2]));     // third segment does not intersect
+
+    EXPECT_EQ(3, bcr::segmentCircle_exit(x, y, 4, Point2f(5.0f, 5.0f), 5.0f, t));
+    EXPECT_NEAR(0.5f, t[0], 1e-6f);    // tangent points
+    EXPECT_NEAR(0.5f, t[1], 1e-6f);
+    EXPECT_NEAR(0.5f, t[2], 1e-6f);
+
+    // scalar and batch versions give the same exit points
+    const float32_t px[] = { 0.0f, 3.0f, 7.0f, 12.0f, 12.0f };
+    const float32_t py[] = { 0.0f, 1.0f, -2.0f, 0.0f, 6.0f };
+    float32_t te[4];
+    for (float32_t cx = -2.0f; cx < 14.0f; cx += 0.5f) {
+        const Point2f center(cx, 0.5f);
+        bcr::segmentCircle_exit(px, py, 5, center, 3.0f, te);
+        for (uint32_t i = 0; i < 4; ++i) {
+            const Point2f p1(px[i], py[i]), p2(px[i + 1], py[i + 1]);
+            const std::pair<Point2f, Point2f> intersections = bcr::segmentCircle_intersection(p1, p2, center, 3.0f);
+            const Point2f& exit = std::isnan(intersections.second.X) ? intersections.first : intersections.second;
+            if (std::isnan(te[i])) {
+                // no intersection, or the only intersection is the entry point
+                EXPECT_TRUE(std::isnan(exit.X) || p2.distance(center) <= 3.0f);
+            } else {
+                EXPECT_NEAR(exit.X, px[i] + te[i] * (px[i + 1] - px[i]), 1e-4f);
+                EXPECT_NEAR(exit.Y, py[i] + te[i] * (py[i + 1] - py[i]), 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(linalg, segmentCircle_exit_short_segments) {
+    // 2 mm segments, 0.5 mm radius - the discriminant is far below the default epsilon, but the roots are well-defined
+    const float32_t x[] = { 0.0f, 0.002f, 0.004f };
+    const float32_t y[] = { 0.0f, 0.0f, 0.0f };
+    float32_t t[2];
+
+    EXPECT_EQ(1, bcr::segmentCircle_exit(x, y, 3, Point2f(0.001f, 0.0f), 0.0005f, t));
+    EXPECT_NEAR(0.75f, t[0], 1e-5f);
+    EXPECT_TRUE(std::isnan(t[1]));     // second segment is behind the circle
+
+    const std::pair<Point2f, Point2f> intersections = bcr::segmentCircle_intersection(Point2f(0.0f, 0.0f), Point2f(0.002f, 0.0f), Point2f(0.001f, 0.0f), 0.0005f);
+    EXPECT_NEAR(0.0005f, intersections.first.X, 1e-8f);
+    EXPECT_NEAR(0.0015f, intersections.second.X, 1e-8f);
+}
+
 TEST(linalg, lineLine_intersection) {
     const Line2d line1(1.0, -1.0, 5.0); // y = x + 5
     const Line2d line2(0.0, -1.0, 10.0); // y = 10
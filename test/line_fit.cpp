@@ -0,0 +1,77 @@
+#include <babocar-core/line_fit.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+TEST(line_fit, add_remove) {
+    LineFitAccumulator<float64_t> fit;
+    for (uint32_t i = 0; i < 10; ++i) {
+        fit.add(Point2d(i, 2.0 * i + 1.0));
+    }
+    fit.add(Point2d(3.0, 20.0)); // outlier
+
+    EXPECT_GT(fit.residual(), 1.0);
+
+    fit.remove(Point2d(3.0, 20.0));
+    ASSERT_EQ(10, fit.size());
+    EXPECT_NEAR(0.0, fit.residual(), 1e-9);
+
+    const Line2d line = fit.line();
+    EXPECT_NEAR(1.0, line.getY(0.0), 1e-9);
+    EXPECT_NEAR(21.0, line.getY(10.0), 1e-9);
+}
+
+TEST(line_fit, vertical) {
+    LineFitAccumulator<float64_t> fit;
+    for (uint32_t i = 0; i < 10; ++i) {
+        fit.add(Point2d(4.9, i));
+        fit.add(Point2d(5.1, i));
+    }
+
+    const Line2d line = fit.line();
+    EXPECT_NEAR(5.0, line.getX(100.0), 1e-9);
+    EXPECT_NEAR(0.1, fit.residual(), 1e-9);
+}
+
+TEST(line_fit, units) {
+    LineFitAccumulator<meter_t> fit;
+    fit.add(Point2m(meter_t(1), meter_t(1)));
+    fit.add(Point2m(centimeter_t(200), centimeter_t(200)));
+    fit.add(Point2m(meter_t(3), meter_t(3)));
+
+    EXPECT_NEAR(2.0, fit.centroid().X.get(), 1e-9);
+    EXPECT_TRUE(bcr::eq(fit.residual(), meter_t(0)));
+
+    const Line2d line = fit.line();
+    EXPECT_NEAR(5.0, line.getY(5.0), 1e-9);
+}
+
+TEST(line_fit, long_run_sliding_window) {
+    // slides a window of 10 points along a line far from the origin
+    LineFitAccumulator<float64_t> fit;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        fit.add(Point2d(1000.0 + i * 0.01, 500.0 + i * 0.02));
+        if (i >= 10) {
+            const uint32_t j = i - 10;
+            fit.remove(Point2d(1000.0 + j * 0.01, 500.0 + j * 0.02));
+        }
+    }
+
+    ASSERT_EQ(10, fit.size());
+    EXPECT_NEAR(0.0, fit.residual(), 1e-6);
+    const Line2d line = fit.line();
+    EXPECT_NEAR(500.0 + 2000.0, line.getY(2000.0), 1e-3);
+}
+
+TEST(line_fit, merge) {
+    LineFitAccumulator<float64_t> fit1, fit2, fit;
+    for (uint32_t i = 0; i < 10; ++i) {
+        const Point2d p(i, (i % 3) * 0.1 + 0.5 * i);
+        (i < 4 ? fit1 : fit2).add(p);
+        fit.add(p);
+    }
+    fit1.add(fit2);
+    EXPECT_EQ(fit.size(), fit1.size());
+    EXPECT_NEAR(fit.residual(), fit1.residual(), 1e-12);
+}
@@ -0,0 +1,139 @@
+#include <babocar-core/map_file.hpp>
+#include <babocar-core/occupancy_grid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+using namespace bcr;
+
+namespace {
+
+typedef OccupancyGrid<8, 4> grid_type;
+
+const std::string& mapFileName() {
+    static const std::string name = testing::TempDir() + "babocar_core_test_map.bin";
+    return name;
+}
+
+// inserts a few rays, and writes the grid to the map file
+void writeMap(const grid_type& grid, const Point2m *path, uint32_t pathSize) {
+    Point2i keys[grid_type::NUM_TILES];
+    const int16_t *cells[grid_type::NUM_TILES];
+    const uint32_t numTiles = grid.getTiles(keys, cells);
+    ASSERT_EQ(Status::OK, writeMapFile(mapFileName().c_str(), grid.resolution(), 4, keys, cells, numTiles, path, pathSize));
+}
+
+} // namespace
+
+TEST(map_file, write_open) {
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.1)));
+    grid->castRay(Point2i(-20, -3), Point2i(30, 5));
+    grid->applyUpdates();
+    const Point2m path[] = { Point2m(meter_t(1), meter_t(2)), Point2m(meter_t(-3), meter_t(4.5)) };
+    writeMap(*grid, path, 2);
+
+    MapFile map;
+    EXPECT_FALSE(map.isOpen());
+    ASSERT_EQ(Status::OK, map.open(mapFileName().c_str()));
+    ASSERT_TRUE(map.isOpen());
+    EXPECT_NEAR(0.1, map.resolution().get(), 1e-12);
+    EXPECT_EQ(4, map.tileBits());
+    EXPECT_EQ(5, map.numTiles());  // tiles (-2, -1), (-1, -1), (-1, 0), (0, 0), (1, 0)
+
+    for (int32_t y = -20; y < 20; ++y) {
+        for (int32_t x = -40; x < 40; ++x) {
+            ASSERT_NEAR(grid->logOdds(Point2i(x, y)), map.cell(Point2i(x, y)) / grid_type::LOG_ODDS_SCALE, 1e-6f);
+        }
+    }
+    EXPECT_NE(nullptr, map.tile(1, 0));
+    EXPECT_EQ(nullptr, map.tile(0, -1));
+    EXPECT_EQ(nullptr, map.tile(100, 0));
+
+    ASSERT_EQ(2, map.pathSize());
+    EXPECT_EQ(path[1], map.path()[1]);
+
+    map.close();
+    EXPECT_FALSE(map.isOpen());
+    std::remove(mapFileName().c_str());
+}
+
+TEST(map_file, base_map) {
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.1)));
+    grid->castRay(Point2i(0, 0), Point2i(10, 0));
+    grid->applyUpdates();
+    writeMap(*grid, nullptr, 0);
+
+    MapFile map;
+    ASSERT_EQ(Status::OK, map.open(mapFileName().c_str()));
+
+    // the tiles are read in place until they are updated
+    const std::unique_ptr<grid_type> loaded(new grid_type(meter_t(0.1)));
+    ASSERT_TRUE(loaded->setMap(&map));
+    EXPECT_NEAR(-0.4f, loaded->logOdds(Point2i(5, 0)), 1e-3f);
+    EXPECT_NEAR(0.85f, loaded->logOdds(Point2i(10, 0)), 1e-3f);
+    EXPECT_EQ(0.0f, loaded->logOdds(Point2i(-5, 0)));
+
+    // the updates start from the values of the base map
+    loaded->castRay(Point2i(5, 1), Point2i(10, 0));
+    loaded->applyUpdates();
+    EXPECT_NEAR(-0.4f, loaded->logOdds(Point2i(5, 0)), 1e-3f);
+    EXPECT_NEAR(1.7f, loaded->logOdds(Point2i(10, 0)), 1e-3f);
+    EXPECT_NEAR(-0.4f, loaded->logOdds(Point2i(5, 1)), 1e-3f);
+
+    // the tiles moved out of the window are reloaded from the base map
+    loaded->recenter(Point2m(meter_t(100), meter_t(0)));
+    loaded->castRay(Point2i(1030, 0), Point2i(1031, 0));   // tile (64, 0) reuses the slot of tile (0, 0)
+    loaded->recenter(Point2m(meter_t(0), meter_t(0)));
+    EXPECT_NEAR(0.85f, loaded->logOdds(Point2i(10, 0)), 1e-3f);
+
+    loaded->clear();
+    EXPECT_NEAR(0.85f, loaded->logOdds(Point2i(10, 0)), 1e-3f);
+
+    const std::unique_ptr<OccupancyGrid<8, 3>> otherTiles(new OccupancyGrid<8, 3>(meter_t(0.1)));
+    EXPECT_FALSE(otherTiles->setMap(&map));
+    const std::unique_ptr<grid_type> otherResolution(new grid_type(meter_t(0.05)));
+    EXPECT_FALSE(otherResolution->setMap(&map));
+    std::remove(mapFileName().c_str());
+}
+
+TEST(map_file, invalid) {
+    MapFile map;
+    EXPECT_EQ(Status::ERROR, map.open("/nonexistent/map.bin"));
+
+    const Point2i keys[] = { Point2i(0, 0), Point2i(0, 0) };
+    const int16_t tile[256] = {};
+    const int16_t *tiles[] = { tile, tile };
+    EXPECT_EQ(Status::INVALID_DATA, writeMapFile(mapFileName().c_str(), meter_t(0.1), 4, keys, tiles, 2));
+    EXPECT_EQ(Status::INVALID_DATA, writeMapFile(mapFileName().c_str(), meter_t(0.1), 0, keys, tiles, 1));
+    EXPECT_EQ(Status::ERROR, writeMapFile("/nonexistent/map.bin", meter_t(0.1), 4, keys, tiles, 1));
+
+    // corrupted identifier
+    ASSERT_EQ(Status::OK, writeMapFile(mapFileName().c_str(), meter_t(0.1), 4, keys, tiles, 1));
+    FILE *file = std::fopen(mapFileName().c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    std::fputc('X', file);
+    std::fclose(file);
+    EXPECT_EQ(Status::INVALID_DATA, map.open(mapFileName().c_str()));
+
+    // non-zero reserved field
+    ASSERT_EQ(Status::OK, writeMapFile(mapFileName().c_str(), meter_t(0.1), 4, keys, tiles, 1));
+    file = std::fopen(mapFileName().c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ(0, std::fseek(file, offsetof(MapFileHeader, reserved), SEEK_SET));
+    std::fputc(1, file);
+    std::fclose(file);
+    EXPECT_EQ(Status::INVALID_DATA, map.open(mapFileName().c_str()));
+
+    // truncated file
+    ASSERT_EQ(Status::OK, writeMapFile(mapFileName().c_str(), meter_t(0.1), 4, keys, tiles, 1));
+    ASSERT_EQ(Status::OK, map.open(mapFileName().c_str()));
+    ASSERT_EQ(0, truncate(mapFileName().c_str(), 8192));
+    EXPECT_EQ(Status::INVALID_DATA, map.open(mapFileName().c_str()));
+    EXPECT_FALSE(map.isOpen());
+    std::remove(mapFileName().c_str());
+}
@@ -0,0 +1,143 @@
+#include <babocar-core/mat.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+// reference multiplication
+template <typename T, uint32_t R, uint32_t K, uint32_t C>
+mat<T, R, C> multiplyNaive(const mat<T, R, K>& a, const mat<T, K, C>& b) {
+    mat<T, R, C> result;
+    for (uint32_t i = 0; i < R; ++i) {
+        for (uint32_t j = 0; j < C; ++j) {
+            for (uint32_t k = 0; k < K; ++k) {
+                result(i, j) += a(i, k) * b(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T, uint32_t R, uint32_t K, uint32_t C>
+void testMultiply() {
+    mat<T, R, K> a;
+    mat<T, K, C> b;
+    for (uint32_t i = 0; i < R * K; ++i) {
+        a[i] = static_cast<T>(i % 7) - T(2.5);
+    }
+    for (uint32_t i = 0; i < K * C; ++i) {
+        b[i] = static_cast<T>(i % 5) * T(0.5) + T(1);
+    }
+    EXPECT_EQ(multiplyNaive(a, b), a * b);
+}
+
+} // namespace
+
+TEST(mat, construct) {
+    constexpr mat2d m(1.0, 2.0, 3.0, 4.0);
+    static_assert(m(1, 0) == 3.0, "constexpr element access");
+    static_assert(!std::is_convertible<float64_t, mat3d>::value, "Element constructor must be explicit");
+    static_assert(mat2d::ROWS == 2 && mat2d::COLS == 2, "constexpr dimensions");
+
+    const mat<float32_t, 2, 3> partial(1.0f, 2.0f);
+    EXPECT_EQ(1.0f, partial(0, 0));
+    EXPECT_EQ(2.0f, partial(0, 1));
+    EXPECT_EQ(0.0f, partial(1, 2));
+
+    const mat3f id = mat3f::identity();
+    EXPECT_EQ(1.0f, id(2, 2));
+    EXPECT_EQ(0.0f, id(1, 2));
+    EXPECT_EQ(mat3f(2.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 4.0f), mat3f::diagonal(mat<float32_t, 3, 1>(2.0f, 3.0f, 4.0f)));
+}
+
+TEST(mat, arithmetic) {
+    const mat<float64_t, 2, 3> a(1.0, 2.0, 3.0, 4.0, 5.0, 6.0);
+    const mat<float64_t, 2, 3> b(6.0, 5.0, 4.0, 3.0, 2.0, 1.0);
+
+    EXPECT_EQ((mat<float64_t, 2, 3>(7.0, 7.0, 7.0, 7.0, 7.0, 7.0)), a + b);
+    EXPECT_EQ((mat<float64_t, 2, 3>(-5.0, -3.0, -1.0, 1.0, 3.0, 5.0)), a - b);
+    EXPECT_EQ((mat<float64_t, 2, 3>(2.0, 4.0, 6.0, 8.0, 10.0, 12.0)), a * 2.0);
+    EXPECT_EQ(a * 2.0, 2.0 * a);
+    EXPECT_EQ((mat<float64_t, 2, 3>(0.5, 1.0, 1.5, 2.0, 2.5, 3.0)), a / 2.0);
+    EXPECT_EQ((mat<float64_t, 3, 2>(1.0, 4.0, 2.0, 5.0, 3.0, 6.0)), a.transpose());
+    EXPECT_EQ((mat<float64_t, 2, 2>(14.0, 32.0, 32.0, 77.0)), a * a.transpose());
+}
+
+TEST(mat, multiply_kernels) {
+    testMultiply<float32_t, 2, 2, 2>();
+    testMultiply<float64_t, 2, 2, 2>();
+    testMultiply<float32_t, 3, 3, 3>();
+    testMultiply<float64_t, 3, 3, 3>();
+    testMultiply<float32_t, 4, 4, 4>();
+    testMultiply<float64_t, 4, 4, 4>();
+    testMultiply<float64_t, 3, 2, 4>();
+    testMultiply<float64_t, 5, 5, 1>();
+}
+
+TEST(mat, point) {
+    const mat2d rot(0.0, -1.0, 1.0, 0.0);
+    const Point2d p = rot * Point2d(2.0, 1.0);
+    EXPECT_EQ(-1.0, p.X);
+    EXPECT_EQ(2.0, p.Y);
+
+    const mat<float64_t, 2, 1> v(Point2m(meter_t(3.0), meter_t(4.0)));
+    EXPECT_EQ(3.0, v[0]);
+    EXPECT_EQ(4.0, v[1]);
+
+    const Point2m pm = (rot * v).toPoint<meter_t>();
+    EXPECT_EQ(-4.0, pm.X.get());
+    EXPECT_EQ(3.0, pm.Y.get());
+}
+
+TEST(mat, cholesky) {
+    // A = L * L^T, L = [2 0 0; 1 3 0; -1 2 1]
+    const mat3d L0(2.0, 0.0, 0.0, 1.0, 3.0, 0.0, -1.0, 2.0, 1.0);
+    const mat3d A = L0 * L0.transpose();
+
+    mat3d L;
+    ASSERT_TRUE(A.cholesky(L));
+    for (uint32_t i = 0; i < 9; ++i) {
+        EXPECT_NEAR(L0[i], L[i], 1e-12);
+    }
+
+    const mat<float64_t, 3, 2> x0(1.0, -2.0, 0.5, 3.0, -1.5, 0.25);
+    mat<float64_t, 3, 2> x;
+    ASSERT_TRUE(A.solveCholesky(A * x0, x));
+    for (uint32_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(x0[i], x[i], 1e-12);
+    }
+
+    // not positive definite
+    mat2d L2;
+    EXPECT_FALSE(mat2d(1.0, 2.0, 2.0, 1.0).cholesky(L2));
+}
+
+TEST(mat, ldlt) {
+    // indefinite symmetric matrix
+    const mat3d A(4.0, 2.0, -2.0, 2.0, -3.0, 1.0, -2.0, 1.0, 5.0);
+
+    mat3d L;
+    mat<float64_t, 3, 1> D;
+    ASSERT_TRUE(A.ldlt(L, D));
+    const mat3d LDLt = L * mat3d::diagonal(D) * L.transpose();
+    for (uint32_t i = 0; i < 9; ++i) {
+        EXPECT_NEAR(A[i], LDLt[i], 1e-12);
+    }
+    EXPECT_LT(D[1], 0.0);
+
+    const mat<float64_t, 3, 1> x0(1.0, 2.0, 3.0);
+    mat<float64_t, 3, 1> x;
+    ASSERT_TRUE(A.solveLdlt(A * x0, x));
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(x0[i], x[i], 1e-12);
+    }
+
+    mat3d C;
+    EXPECT_FALSE(A.cholesky(C));
+
+    // LDL^T without pivoting fails if a leading minor is singular
+    mat<float64_t, 2, 1> x2;
+    EXPECT_FALSE(mat2d(0.0, 1.0, 1.0, 0.0).solveLdlt(mat<float64_t, 2, 1>(1.0, 1.0), x2));
+}
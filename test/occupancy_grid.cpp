@@ -0,0 +1,128 @@
+#include <babocar-core/occupancy_grid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace bcr;
+
+namespace {
+
+typedef OccupancyGrid<8, 4> grid_type;  // 128x128 cells
+
+} // namespace
+
+TEST(occupancy_grid, castRay) {
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.1), 0.85f, -0.4f));
+    EXPECT_EQ(Point2i(-1, 12), grid->cell(Point2m(meter_t(-0.05), meter_t(1.25))));
+    EXPECT_NEAR(-0.05, grid->center(Point2i(-1, 12)).X.get(), 1e-9);
+
+    // horizontal ray along the X axis, crossing a tile border at 0 and 16
+    ASSERT_TRUE(grid->castRay(Point2i(-5, 0), Point2i(20, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(0, 0)));   // not updated until applyUpdates()
+    grid->applyUpdates();
+
+    for (int32_t x = -5; x < 20; ++x) {
+        EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(x, 0)), 1e-3f);
+    }
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2i(20, 0)), 1e-3f);
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(-6, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(21, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(5, 1)));
+    EXPECT_NEAR(1.0f / (1.0f + std::exp(-0.85f)), grid->probability(Point2m(meter_t(2.05), meter_t(0.05))), 1e-3f);
+
+    // diagonal ray in the negative direction - one cell per step
+    ASSERT_TRUE(grid->castRay(Point2i(0, 0), Point2i(-10, -10), false));
+    grid->applyUpdates();
+    for (int32_t i = 1; i <= 10; ++i) {
+        EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(-i, -i)), 1e-3f);
+    }
+    EXPECT_NEAR(-0.8f, grid->logOdds(Point2i(0, 0)), 1e-3f);
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(-2, -1)));
+
+    // steep ray - every row is visited once
+    const std::unique_ptr<grid_type> steep(new grid_type(meter_t(0.1)));
+    ASSERT_TRUE(steep->castRay(Point2i(0, 0), Point2i(3, 30)));
+    steep->applyUpdates();
+    uint32_t numFree = 0;
+    for (int32_t y = -64; y < 64; ++y) {
+        for (int32_t x = -64; x < 64; ++x) {
+            numFree += steep->logOdds(Point2i(x, y)) < 0.0f ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(30, numFree);
+}
+
+TEST(occupancy_grid, insertScan) {
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.1), 0.85f, -0.4f, -2.0f, 3.5f));
+
+    // many rays cross the cells near the sensor, but they are updated only once per scan
+    Point2m points[360];
+    for (uint32_t i = 0; i < 360; ++i) {
+        const float64_t a = i * PI.get() / 180;
+        points[i] = Point2m(meter_t(0.05 + 2 * std::cos(a)), meter_t(0.05 + 2 * std::sin(a)));
+    }
+    EXPECT_EQ(360, grid->insertScan(Point2m(meter_t(0.05), meter_t(0.05)), points, 360));
+    EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(0, 0)), 1e-3f);
+    EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(10, 0)), 1e-3f);
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2i(20, 0)), 1e-3f);
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2m(meter_t(0.05), meter_t(-1.95))), 1e-3f);
+
+    // the values are limited
+    for (uint32_t i = 0; i < 10; ++i) {
+        grid->insertScan(Point2m(meter_t(0.05), meter_t(0.05)), points, 360);
+    }
+    EXPECT_NEAR(-2.0f, grid->logOdds(Point2i(0, 0)), 1e-3f);
+    EXPECT_NEAR(3.5f, grid->logOdds(Point2i(20, 0)), 1e-3f);
+
+    // points given as float coordinates
+    const Point2f far[] = { Point2f(-6.35f, 0.05f) };
+    EXPECT_EQ(1, grid->insertScan(Point2m(meter_t(0.05), meter_t(0.05)), far, 1));
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2i(-64, 0)), 1e-3f);
+
+    grid->clear();
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(20, 0)));
+}
+
+TEST(occupancy_grid, recenter) {
+    const std::unique_ptr<grid_type> grid(new grid_type(meter_t(0.1)));
+    EXPECT_TRUE(grid->contains(Point2i(-64, -64)));
+    EXPECT_TRUE(grid->contains(Point2i(63, 63)));
+    EXPECT_FALSE(grid->contains(Point2i(64, 0)));
+    EXPECT_NEAR(-6.4, grid->origin().X.get(), 1e-9);
+
+    // the part of the ray outside the window is ignored
+    ASSERT_TRUE(grid->castRay(Point2i(60, 0), Point2i(70, 0)));
+    EXPECT_FALSE(grid->castRay(Point2i(70, 0), Point2i(60, 0)));
+    grid->applyUpdates();
+    EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(63, 0)), 1e-3f);
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(64, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(70, 0)));
+
+    ASSERT_TRUE(grid->castRay(Point2i(-60, 0), Point2i(-61, 0)));
+    grid->applyUpdates();
+
+    // the window moves by whole tiles (1.6 m), the cells in the overlapping part are kept
+    grid->recenter(Point2m(meter_t(3.3), meter_t(0)));
+    EXPECT_NEAR(-3.2, grid->origin().X.get(), 1e-9);
+    EXPECT_NEAR(-0.4f, grid->logOdds(Point2i(63, 0)), 1e-3f);
+    EXPECT_FALSE(grid->contains(Point2i(-33, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(-60, 0)));
+    ASSERT_TRUE(grid->castRay(Point2i(60, 0), Point2i(70, 0)));
+    grid->applyUpdates();
+    EXPECT_NEAR(-0.8f, grid->logOdds(Point2i(63, 0)), 1e-3f);
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2i(70, 0)), 1e-3f);
+
+    // the slot of the tile of (-60, 0) has been reused by the tile of (70, 0) - the old cells are unknown after moving back
+    ASSERT_TRUE(grid->castRay(Point2i(80, 0), Point2i(81, 0)));
+    grid->recenter(Point2m(meter_t(0), meter_t(0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(-60, 0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(70, 0)));
+    EXPECT_NEAR(-0.8f, grid->logOdds(Point2i(60, 0)), 1e-3f);
+
+    // the marks of the tiles outside the window are dropped
+    grid->applyUpdates();
+    grid->recenter(Point2m(meter_t(3.3), meter_t(0)));
+    EXPECT_EQ(0.0f, grid->logOdds(Point2i(80, 0)));
+    EXPECT_NEAR(0.85f, grid->logOdds(Point2i(70, 0)), 1e-3f);
+}
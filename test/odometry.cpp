@@ -0,0 +1,77 @@
+#include <babocar-core/odometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace bcr;
+
+TEST(odometry, update_batch_circle) {
+    // 1 m/s on a circle of 2 m radius, 2 kHz samples for one full circle
+    const float64_t radius = 2.0, speed = 1.0, period = 2 * PI.get() * radius / speed;
+    const uint32_t numSamples = static_cast<uint32_t>(period * 2000.0);
+    const OdometrySample sample = { second_t(period / numSamples), m_per_sec_t(speed), rad_per_sec_t(speed / radius) };
+    const std::vector<OdometrySample> samples(numSamples, sample);
+
+    Odometry odom;
+    odom.pose = { Point2m(meter_t(0), meter_t(-radius)), radian_t(0) };
+    odom.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+
+    std::vector<Pose> trajectory(numSamples / 100);
+    EXPECT_EQ(numSamples / 100, odom.update(samples.data(), numSamples, trajectory.data(), 100));
+
+    EXPECT_NEAR(0.0, odom.pose.pos.X.get(), 1e-9);
+    EXPECT_NEAR(-radius, odom.pose.pos.Y.get(), 1e-9);
+    EXPECT_NEAR(2 * PI.get(), odom.pose.angle.get(), 1e-9);
+    EXPECT_NEAR(speed, odom.twist.speed.X.get(), 1e-9);
+    EXPECT_NEAR(0.0, odom.twist.speed.Y.get(), 1e-9);
+    EXPECT_EQ(rad_per_sec_t(speed / radius), odom.twist.ang_vel);
+
+    // every pose of the trajectory is on the circle, with the heading tangent to it
+    for (const Pose& p : trajectory) {
+        EXPECT_NEAR(radius, std::hypot(p.pos.X.get(), p.pos.Y.get()), 1e-9);
+        EXPECT_NEAR(-p.pos.Y.get() / radius, std::cos(p.angle.get()), 1e-9);
+        EXPECT_NEAR(p.pos.X.get() / radius, std::sin(p.angle.get()), 1e-9);
+    }
+}
+
+TEST(odometry, update_batch_large_angles) {
+    // samples with large rotations take the trigonometric path, straight samples are exact
+    const OdometrySample samples[] = {
+        { millisecond_t(500), m_per_sec_t(2), rad_per_sec_t(2 * PI.get()) },    // half circle of radius 1/PI
+        { millisecond_t(1000), m_per_sec_t(1), rad_per_sec_t(0) },
+        { millisecond_t(0), m_per_sec_t(5), rad_per_sec_t(3) }
+    };
+
+    Odometry odom;
+    odom.pose = { Point2m(meter_t(1), meter_t(1)), radian_t(0) };
+    odom.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+    EXPECT_EQ(0, odom.update(samples, 3));
+
+    EXPECT_NEAR(0.0, odom.pose.pos.X.get(), 1e-9);
+    EXPECT_NEAR(1.0 + 2.0 / PI.get(), odom.pose.pos.Y.get(), 1e-9);
+    EXPECT_NEAR(PI.get(), odom.pose.angle.get(), 1e-9);
+    EXPECT_NEAR(-5.0, odom.twist.speed.X.get(), 1e-9);
+}
+
+TEST(odometry, update_batch_matches_single) {
+    // with small enough steps the midpoint integration converges to the exact arc
+    const OdometrySample sample = { millisecond_t(1), m_per_sec_t(3), rad_per_sec_t(0.7) };
+    const std::vector<OdometrySample> samples(1000, sample);
+
+    Odometry batch, single;
+    batch.pose = single.pose = { Point2m(meter_t(0.5), meter_t(-1)), radian_t(0.4) };
+    single.twist = { Point2mps(m_per_sec_t(3), m_per_sec_t(0)).rotate(radian_t(0.4)), rad_per_sec_t(0.7) };
+    batch.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+
+    batch.update(samples.data(), 1000);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        single.update(millisecond_t(1));
+    }
+
+    EXPECT_NEAR(single.pose.pos.X.get(), batch.pose.pos.X.get(), 1e-6);
+    EXPECT_NEAR(single.pose.pos.Y.get(), batch.pose.pos.Y.get(), 1e-6);
+    EXPECT_NEAR(single.pose.angle.get(), batch.pose.angle.get(), 1e-9);
+    EXPECT_NEAR(single.twist.speed.X.get(), batch.twist.speed.X.get(), 1e-9);
+    EXPECT_NEAR(single.twist.speed.Y.get(), batch.twist.speed.Y.get(), 1e-9);
+}
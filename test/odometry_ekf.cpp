@@ -0,0 +1,96 @@
+#include <babocar-core/odometry_ekf.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+Odometry makeOdometry(meter_t x, meter_t y, radian_t angle, m_per_sec_t speed, rad_per_sec_t ang_vel) {
+    Odometry odom;
+    odom.pose = { Point2m(x, y), angle };
+    odom.twist = { Point2mps(speed, m_per_sec_t(0)).rotate(angle), ang_vel };
+    return odom;
+}
+
+OdometryEKFd::covariance_type diag(float64_t x, float64_t y, float64_t angle, float64_t speed, float64_t ang_vel) {
+    return OdometryEKFd::covariance_type::diagonal(OdometryEKFd::state_type(x, y, angle, speed, ang_vel));
+}
+
+} // namespace
+
+TEST(odometry_ekf, predict_matches_odometry) {
+    Odometry odom = makeOdometry(meter_t(1), meter_t(2), radian_t(0.3), m_per_sec_t(2), rad_per_sec_t(0.5));
+    OdometryEKFd ekf(odom, diag(0.01, 0.01, 0.01, 0.1, 0.1), 0.5, 0.5);
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        odom.update(millisecond_t(1));
+        ekf.predict(millisecond_t(1));
+    }
+
+    const Odometry result = ekf.odometry();
+    EXPECT_NEAR(odom.pose.pos.X.get(), result.pose.pos.X.get(), 1e-9);
+    EXPECT_NEAR(odom.pose.pos.Y.get(), result.pose.pos.Y.get(), 1e-9);
+    EXPECT_NEAR(odom.pose.angle.get(), result.pose.angle.get(), 1e-9);
+    EXPECT_NEAR(odom.twist.speed.X.get(), result.twist.speed.X.get(), 1e-9);
+    EXPECT_NEAR(odom.twist.speed.Y.get(), result.twist.speed.Y.get(), 1e-9);
+
+    // uncertainty of the heading and the speed grows the position uncertainty
+    EXPECT_GT(ekf.covariance()(OdometryEKFd::X, OdometryEKFd::X), 0.01);
+    EXPECT_GT(ekf.covariance()(OdometryEKFd::SPEED, OdometryEKFd::SPEED), 0.1);
+    EXPECT_EQ(ekf.covariance().transpose(), ekf.covariance());
+}
+
+TEST(odometry_ekf, angle_wrap) {
+    OdometryEKFd ekf(makeOdometry(meter_t(0), meter_t(0), radian_t(3.1), m_per_sec_t(0), rad_per_sec_t(1)),
+        diag(0.01, 0.01, 0.01, 0.01, 0.01), 0.1, 0.1);
+
+    ekf.predict(millisecond_t(100));
+    EXPECT_NEAR(3.2 - 2 * PI.get(), ekf.pose().angle.get(), 1e-9);
+
+    // the measured angle is close to the estimate across the wrap-around, the correction must be small
+    Pose fix = ekf.pose();
+    fix.angle = radian_t(3.15);
+    ASSERT_TRUE(ekf.updatePose(fix, mat3d::diagonal(mat<float64_t, 3, 1>(0.01, 0.01, 0.01))));
+    EXPECT_GT(std::abs(ekf.pose().angle.get()), 3.1);
+}
+
+TEST(odometry_ekf, sensor_updates) {
+    OdometryEKFd ekf(makeOdometry(meter_t(0), meter_t(0), radian_t(0), m_per_sec_t(1), rad_per_sec_t(0)),
+        diag(1, 1, 0.1, 1, 1), 0.1, 0.1);
+
+    // wheel encoders and gyroscope converge to the measured values
+    for (uint32_t i = 0; i < 100; ++i) {
+        ekf.predict(millisecond_t(10));
+        ekf.updateSpeed(m_per_sec_t(2), 0.01);
+        ekf.updateAngVel(rad_per_sec_t(0.2), 0.001);
+    }
+    EXPECT_NEAR(2.0, ekf.state()[OdometryEKFd::SPEED], 0.05);
+    EXPECT_NEAR(0.2, ekf.state()[OdometryEKFd::ANG_VEL], 0.01);
+
+    // absolute fix pulls the position towards the measurement, and reduces the position uncertainty
+    const float64_t varBefore = ekf.covariance()(OdometryEKFd::X, OdometryEKFd::X);
+    const Pose fix = { Point2m(meter_t(1.5), meter_t(0.2)), radian_t(0.2) };
+    ASSERT_TRUE(ekf.updatePose(fix, mat3d::diagonal(mat<float64_t, 3, 1>(1e-4, 1e-4, 1e-4))));
+    EXPECT_NEAR(1.5, ekf.pose().pos.X.get(), 0.01);
+    EXPECT_NEAR(0.2, ekf.pose().pos.Y.get(), 0.01);
+    EXPECT_NEAR(0.2, ekf.pose().angle.get(), 0.01);
+    EXPECT_LT(ekf.covariance()(OdometryEKFd::X, OdometryEKFd::X), varBefore);
+
+    // invalid measurement covariance is rejected
+    const OdometryEKFd::state_type stateBefore = ekf.state();
+    EXPECT_FALSE(ekf.updatePose(fix, -mat3d::identity() * 1e3));
+    EXPECT_EQ(stateBefore, ekf.state());
+}
+
+TEST(odometry_ekf, float) {
+    OdometryEKFf ekf(makeOdometry(meter_t(0), meter_t(0), radian_t(0), m_per_sec_t(1), rad_per_sec_t(0.1)),
+        OdometryEKFf::covariance_type::identity() * 0.01f, 0.1f, 0.1f);
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ekf.predict(millisecond_t(1));
+        ekf.updateAngVel(rad_per_sec_t(0.1), 0.001f);
+    }
+    EXPECT_NEAR(0.1, ekf.pose().angle.get(), 1e-4);
+    EXPECT_NEAR(std::sin(0.1) / 0.1, ekf.pose().pos.X.get(), 1e-3);
+}
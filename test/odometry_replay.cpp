@@ -0,0 +1,80 @@
+#include <babocar-core/odometry_replay.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace bcr;
+
+namespace {
+
+void expectNear(const Pose& expected, const Pose& actual, float64_t eps = 1e-9) {
+    EXPECT_NEAR(expected.pos.X.get(), actual.pos.X.get(), eps);
+    EXPECT_NEAR(expected.pos.Y.get(), actual.pos.Y.get(), eps);
+    EXPECT_NEAR(expected.angle.get(), actual.angle.get(), eps);
+}
+
+} // namespace
+
+TEST(odometry_replay, correct) {
+    OdometryReplay<1024, 16> replay(millisecond_t(800));
+    const std::vector<OdometrySample> samples(1000, { millisecond_t(1), m_per_sec_t(1), rad_per_sec_t(0) });
+    replay.update(samples.data(), 1000);
+    EXPECT_NEAR(1000.0, replay.time().get(), 1e-9);
+    expectNear({ Point2m(meter_t(1), meter_t(0)), radian_t(0) }, replay.odometry().pose);
+
+    // the fix at 500 ms is applied at its timestamp, then the later 500 samples are re-integrated with the corrected heading
+    ASSERT_TRUE(replay.correct(millisecond_t(500), { Point2m(meter_t(0.5), meter_t(0.1)), radian_t(0.1) }));
+    expectNear({ Point2m(meter_t(0.5 + 0.5 * std::cos(0.1)), meter_t(0.1 + 0.5 * std::sin(0.1))), radian_t(0.1) }, replay.odometry().pose);
+    EXPECT_NEAR(std::cos(0.1), replay.odometry().twist.speed.X.get(), 1e-9);
+    EXPECT_NEAR(std::sin(0.1), replay.odometry().twist.speed.Y.get(), 1e-9);
+
+    // a fix with zero gain does not change anything - the checkpoints have been rewritten by the previous correction
+    const Pose current = replay.odometry().pose;
+    ASSERT_TRUE(replay.correct(millisecond_t(700), { Point2m(meter_t(5), meter_t(5)), radian_t(1) }, 0.0));
+    expectNear(current, replay.odometry().pose);
+
+    // fixes older than the previous correction are rejected, the re-integration would overwrite the correction
+    EXPECT_FALSE(replay.correct(millisecond_t(600), { Point2m(meter_t(5), meter_t(5)), radian_t(1) }));
+    expectNear(current, replay.odometry().pose);
+
+    // half gain moves the pose at the timestamp halfway to the measurement
+    ASSERT_TRUE(replay.correct(millisecond_t(1000), { Point2m(meter_t(current.pos.X.get() + 0.2), current.pos.Y), current.angle }, 0.5));
+    EXPECT_NEAR(current.pos.X.get() + 0.1, replay.odometry().pose.pos.X.get(), 1e-9);
+}
+
+TEST(odometry_replay, split_sample) {
+    OdometryReplay<64, 8> replay(millisecond_t(1000));
+    const OdometrySample samples[] = {
+        { millisecond_t(100), m_per_sec_t(1), rad_per_sec_t(0) },
+        { millisecond_t(100), m_per_sec_t(2), rad_per_sec_t(0) },
+        { millisecond_t(100), m_per_sec_t(3), rad_per_sec_t(0) }
+    };
+    replay.update(samples, 3);
+    EXPECT_NEAR(0.6, replay.odometry().pose.pos.X.get(), 1e-9);
+
+    // the fix is in the middle of the second sample, the remaining 25 ms are integrated with its speed
+    ASSERT_TRUE(replay.correct(millisecond_t(175), { Point2m(meter_t(0), meter_t(0)), radian_t(PI_2.get()) }));
+    expectNear({ Point2m(meter_t(0), meter_t(0.05 + 0.3)), PI_2 }, replay.odometry().pose);
+}
+
+TEST(odometry_replay, reject) {
+    OdometryReplay<64, 8> replay(millisecond_t(50));
+    const Pose fix = { Point2m(meter_t(1), meter_t(1)), radian_t(0) };
+    EXPECT_FALSE(replay.correct(millisecond_t(0), fix));   // no samples
+
+    const std::vector<OdometrySample> samples(100, { millisecond_t(1), m_per_sec_t(1), rad_per_sec_t(0.1) });
+    replay.update(samples.data(), 100);
+    const Pose current = replay.odometry().pose;
+
+    EXPECT_FALSE(replay.correct(millisecond_t(101), fix));  // future
+    EXPECT_FALSE(replay.correct(millisecond_t(49), fix));   // older than the maximum delay
+    expectNear(current, replay.odometry().pose);
+
+    // the history covers the last 60 samples - the checkpoint interval of the oldest samples is partially overwritten
+    OdometryReplay<64, 8> longDelay(millisecond_t(1000));
+    longDelay.update(samples.data(), 100);
+    EXPECT_FALSE(longDelay.correct(millisecond_t(39.5), fix));
+    EXPECT_TRUE(longDelay.correct(millisecond_t(40), fix, 0.0));
+    expectNear(current, longDelay.odometry().pose);
+}
@@ -0,0 +1,40 @@
+#include <babocar-core/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace bcr;
+
+TEST(parallel, parallel_for) {
+    // every index is processed exactly once, the ranges of the threads are contiguous and aligned
+    std::atomic<uint32_t> counts[100];
+    for (std::atomic<uint32_t>& c : counts) {
+        c = 0;
+    }
+    uint32_t begins[detail::MAX_THREADS] = {}, ends[detail::MAX_THREADS] = {};
+
+    EXPECT_EQ(4, detail::parallel_for(100, 4, [&counts, &begins, &ends](uint32_t begin, uint32_t end, uint32_t t) {
+        begins[t] = begin;
+        ends[t] = end;
+        for (uint32_t i = begin; i < end; ++i) {
+            ++counts[i];
+        }
+    }, 16));
+
+    for (const std::atomic<uint32_t>& c : counts) {
+        EXPECT_EQ(1, c);
+    }
+    EXPECT_EQ(0, begins[0]);
+    EXPECT_EQ(32, ends[0]);
+    EXPECT_EQ(32, begins[1]);
+    EXPECT_EQ(96, ends[2]);
+    EXPECT_EQ(100, ends[3]);
+
+    // the number of threads is limited, and more threads than indices get empty ranges
+    EXPECT_EQ(1, detail::parallel_for(10, 0, [](uint32_t, uint32_t, uint32_t) {}));
+    EXPECT_EQ(detail::MAX_THREADS, detail::parallel_for(10, 100, [](uint32_t begin, uint32_t end, uint32_t) {
+        EXPECT_LE(begin, end);
+        EXPECT_LE(end, 10u);
+    }));
+}
@@ -0,0 +1,132 @@
+#include <babocar-core/odometry.hpp>
+#include <babocar-core/particle_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace bcr;
+
+namespace {
+
+// likelihood of a position measurement with gaussian noise
+struct PositionLikelihood {
+    float32_t x, y, sigma;
+
+    void operator()(const ParticleFilter<4096>::Particles& p) const {
+        const float32_t k = -0.5f / (this->sigma * this->sigma);
+        for (uint32_t i = 0; i < p.size; ++i) {
+            const float32_t dx = p.x[i] - this->x, dy = p.y[i] - this->y;
+            p.weight[i] *= std::exp(k * (dx * dx + dy * dy));
+        }
+    }
+};
+
+} // namespace
+
+TEST(particle_filter, reset) {
+    ParticleFilter<4096> pf(m_per_sec_t(0), rad_per_sec_t(0));
+    pf.reset({ Point2m(meter_t(1), meter_t(2)), radian_t(0.5) }, meter_t(0.1), radian_t(0.05), 4000);
+    ASSERT_EQ(4000, pf.size());
+
+    float64_t sum = 0.0, sum2 = 0.0;
+    for (uint32_t i = 0; i < pf.size(); ++i) {
+        sum += pf.x()[i];
+        sum2 += pf.x()[i] * pf.x()[i];
+        EXPECT_NEAR(1.0, pf.cos()[i] * pf.cos()[i] + pf.sin()[i] * pf.sin()[i], 1e-5);
+    }
+    const float64_t mean = sum / pf.size();
+    EXPECT_NEAR(1.0, mean, 0.01);
+    EXPECT_NEAR(0.1, std::sqrt(sum2 / pf.size() - mean * mean), 0.01);
+
+    const Pose estimate = pf.estimate();
+    EXPECT_NEAR(2.0, estimate.pos.Y.get(), 0.01);
+    EXPECT_NEAR(0.5, estimate.angle.get(), 0.01);
+    EXPECT_NEAR(4000.0f, pf.effectiveSize(), 1.0f);
+}
+
+TEST(particle_filter, predict) {
+    // without noise every particle follows the exact arc
+    ParticleFilter<4096> pf(m_per_sec_t(0), rad_per_sec_t(0));
+    pf.reset({ Point2m(meter_t(1), meter_t(2)), radian_t(0.5) }, meter_t(0), radian_t(0), 16);
+
+    Odometry odom;
+    odom.pose = { Point2m(meter_t(1), meter_t(2)), radian_t(0.5) };
+    const OdometrySample sample = { millisecond_t(10), m_per_sec_t(2), rad_per_sec_t(3) };
+    const Twist twist = { Point2mps(m_per_sec_t(2), m_per_sec_t(0)), rad_per_sec_t(3) };
+    for (uint32_t i = 0; i < 100; ++i) {
+        pf.predict(twist, millisecond_t(10));
+        odom.update(&sample, 1);
+    }
+
+    const Pose estimate = pf.estimate();
+    EXPECT_NEAR(odom.pose.pos.X.get(), estimate.pos.X.get(), 1e-4);
+    EXPECT_NEAR(odom.pose.pos.Y.get(), estimate.pos.Y.get(), 1e-4);
+    EXPECT_NEAR(std::atan2(std::sin(odom.pose.angle.get()), std::cos(odom.pose.angle.get())), estimate.angle.get(), 1e-4);
+    EXPECT_EQ(pf.x()[0], pf.x()[15]);
+
+    // lateral speed moves the particles sideways
+    pf.reset({ Point2m(meter_t(0), meter_t(0)), radian_t(0) }, meter_t(0), radian_t(0), 16);
+    pf.predict({ Point2mps(m_per_sec_t(0), m_per_sec_t(1)), rad_per_sec_t(0) }, millisecond_t(100));
+    EXPECT_NEAR(0.0, pf.estimate().pos.X.get(), 1e-6);
+    EXPECT_NEAR(0.1, pf.estimate().pos.Y.get(), 1e-6);
+
+    // noise spreads the particles
+    ParticleFilter<4096> noisy(m_per_sec_t(0.5), rad_per_sec_t(0.5));
+    noisy.reset({ Point2m(meter_t(0), meter_t(0)), radian_t(0) }, meter_t(0), radian_t(0), 4096);
+    for (uint32_t i = 0; i < 100; ++i) {
+        noisy.predict(twist, millisecond_t(10));
+    }
+    float64_t minX = 1e9, maxX = -1e9;
+    for (uint32_t i = 0; i < noisy.size(); ++i) {
+        minX = std::min<float64_t>(minX, noisy.x()[i]);
+        maxX = std::max<float64_t>(maxX, noisy.x()[i]);
+    }
+    EXPECT_GT(maxX - minX, 0.2);  // the random walk of the speed alone has 5 cm standard deviation
+}
+
+TEST(particle_filter, weight_resample) {
+    ParticleFilter<4096> pf(m_per_sec_t(0.1), rad_per_sec_t(0.1));
+    pf.reset({ Point2m(meter_t(0), meter_t(0)), radian_t(0) }, meter_t(1), radian_t(0.1), 4096);
+
+    ParticleFilter<4096> pf4 = pf;
+    ASSERT_TRUE(pf.weight(PositionLikelihood{ 0.5f, -0.3f, 0.2f }));
+    ASSERT_TRUE(pf4.weight(PositionLikelihood{ 0.5f, -0.3f, 0.2f }, 4));
+    for (uint32_t i = 0; i < pf.size(); ++i) {
+        ASSERT_NEAR(pf.weights()[i], pf4.weights()[i], pf.weights()[i] * 1e-5f + 1e-30f);  // only the summation order differs
+    }
+
+    // the posterior is the product of the N(0, 1) prior and the N(m, 0.2) likelihood: mean = m / (1 + 0.04)
+    EXPECT_NEAR(0.5 / 1.04, pf.estimate().pos.X.get(), 0.02);
+    EXPECT_NEAR(-0.3 / 1.04, pf.estimate().pos.Y.get(), 0.02);
+    const float32_t neff = pf.effectiveSize();
+    EXPECT_LT(neff, 400.0f);
+
+    const Pose before = pf.estimate();
+    pf.resample();
+    EXPECT_NEAR(4096.0f, pf.effectiveSize(), 1.0f);
+    EXPECT_NEAR(before.pos.X.get(), pf.estimate().pos.X.get(), 0.02);
+    EXPECT_NEAR(before.pos.Y.get(), pf.estimate().pos.Y.get(), 0.02);
+
+    // the likelihoods underflow everywhere - the weights are reset to uniform
+    EXPECT_FALSE(pf.weight(PositionLikelihood{ 100.0f, 100.0f, 0.01f }, 3));
+    EXPECT_NEAR(1.0f / 4096, pf.weights()[17], 1e-9f);
+}
+
+TEST(particle_filter, resample_single) {
+    ParticleFilter<4096> pf(m_per_sec_t(0), rad_per_sec_t(0));
+    pf.reset({ Point2m(meter_t(0), meter_t(0)), radian_t(0) }, meter_t(1), radian_t(1), 100);
+    const float32_t x = pf.x()[42], s = pf.sin()[42];
+
+    pf.weight([](const ParticleFilter<4096>::Particles& p) {
+        for (uint32_t i = 0; i < p.size; ++i) {
+            p.weight[i] *= i == 42 ? 1.0f : 0.0f;
+        }
+    });
+    EXPECT_NEAR(1.0f, pf.effectiveSize(), 1e-6f);
+    pf.resample();
+    for (uint32_t i = 0; i < pf.size(); ++i) {
+        EXPECT_EQ(x, pf.x()[i]);
+        EXPECT_EQ(s, pf.sin()[i]);
+    }
+}
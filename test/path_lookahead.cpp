@@ -0,0 +1,79 @@
+#include <babocar-core/path_lookahead.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+TEST(path_lookahead, find) {
+    // path: (0, 0) -> (10, 0) -> (10, 10) -> (0, 10)
+    const Point2f path[] = { { 0.0f, 0.0f }, { 10.0f, 0.0f }, { 10.0f, 10.0f }, { 0.0f, 10.0f } };
+    PathLookahead<float32_t> lookahead;
+    Point2f result;
+
+    EXPECT_TRUE(lookahead.find(path, 4, Point2f(0.0f, 0.0f), 2.0f, result));
+    EXPECT_NEAR(2.0f, result.X, 1e-5f);
+    EXPECT_NEAR(0.0f, result.Y, 1e-5f);
+    EXPECT_EQ(0, lookahead.segment());
+
+    // the exit point is on the second segment, the entry point on the first segment is skipped
+    EXPECT_TRUE(lookahead.find(path, 4, Point2f(9.0f, 0.0f), 2.0f, result));
+    EXPECT_NEAR(10.0f, result.X, 1e-5f);
+    EXPECT_NEAR(std::sqrt(3.0f), result.Y, 1e-5f);
+    EXPECT_EQ(1, lookahead.segment());
+
+    // the search continues from the current segment
+    EXPECT_TRUE(lookahead.find(path, 4, Point2f(3.0f, 9.0f), 2.0f, result));
+    EXPECT_NEAR(3.0f - std::sqrt(3.0f), result.X, 1e-5f);
+    EXPECT_NEAR(10.0f, result.Y, 1e-5f);
+    EXPECT_EQ(2, lookahead.segment());
+
+    // the end of the path is inside the circle
+    EXPECT_FALSE(lookahead.find(path, 4, Point2f(0.0f, 9.0f), 2.0f, result));
+    EXPECT_EQ(2, lookahead.segment());
+
+    lookahead.reset();
+    EXPECT_EQ(0, lookahead.segment());
+    EXPECT_TRUE(lookahead.find(path, 4, Point2f(3.0f, 9.0f), 2.0f, result));
+    EXPECT_EQ(2, lookahead.segment());
+}
+
+TEST(path_lookahead, follow) {
+    // vehicle follows a sampled circle arc - the lookahead point is always ahead, and the segment index never decreases
+    static constexpr uint32_t NUM_POINTS = 200;
+    Point2f path[NUM_POINTS];
+    for (uint32_t i = 0; i < NUM_POINTS; ++i) {
+        const float32_t a = 0.01f * i;
+        path[i] = { 20.0f * std::sin(a), 20.0f * (1.0f - std::cos(a)) };
+    }
+
+    PathLookahead<float32_t> lookahead;
+    uint32_t prevSegment = 0;
+    for (uint32_t i = 0; i + 10 < NUM_POINTS; ++i) {
+        Point2f result;
+        ASSERT_TRUE(lookahead.find(path, NUM_POINTS, path[i], 1.0f, result));
+        EXPECT_NEAR(1.0f, result.distance(path[i]), 1e-4f);
+        EXPECT_GE(lookahead.segment(), prevSegment);
+        EXPECT_GE(lookahead.segment(), i);
+        prevSegment = lookahead.segment();
+    }
+}
+
+TEST(path_lookahead, dense_path) {
+    // straight path sampled every 2 mm - the quadratic coefficients of the segments are small
+    static constexpr uint32_t NUM_POINTS = 1000;
+    Point2f path[NUM_POINTS];
+    for (uint32_t i = 0; i < NUM_POINTS; ++i) {
+        path[i] = { 0.002f * i, 0.0f };
+    }
+
+    PathLookahead<float32_t> lookahead;
+    Point2f result(0.0f, 0.0f);
+    EXPECT_TRUE(lookahead.find(path, NUM_POINTS, Point2f(0.0f, 0.0f), 0.501f, result));
+    EXPECT_NEAR(0.501f, result.X, 1e-5f);
+    EXPECT_NEAR(0.0f, result.Y, 1e-5f);
+    EXPECT_EQ(250, lookahead.segment());
+
+    EXPECT_TRUE(lookahead.find(path, NUM_POINTS, Point2f(0.1f, 0.0f), 0.501f, result));
+    EXPECT_NEAR(0.601f, result.X, 1e-5f);
+    EXPECT_EQ(300, lookahead.segment());
+}
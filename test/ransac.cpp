@@ -0,0 +1,67 @@
+#include <babocar-core/ransac.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+// generates points of y = 0.5 * x + 1 and x = 3 lines, with some outliers
+uint32_t generatePoints(Point2d *points) {
+    xorshift32 random(7);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < 200; ++i) {
+        const float64_t x = i * 0.05;
+        points[n++] = { x, 0.5 * x + 1.0 + (random.uniform01() - 0.5) * 0.01 };
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        points[n++] = { 3.0 + (random.uniform01() - 0.5) * 0.01, i * 0.05 };
+    }
+    for (uint32_t i = 0; i < 50; ++i) {
+        points[n++] = { random.uniform01() * 10.0, random.uniform01() * 10.0 };
+    }
+    return n;
+}
+
+} // namespace
+
+TEST(ransac, fit) {
+    Point2d points[400];
+    const uint32_t numPoints = generatePoints(points);
+
+    LineRansac<float64_t> ransac(0.02, 20);
+    Line2d line;
+    const uint32_t numInliers = ransac.fit(points, numPoints, line);
+
+    EXPECT_GE(numInliers, 200);
+    EXPECT_LT(numInliers, 210);
+    EXPECT_NEAR(1.0, line.getY(0.0), 0.01);
+    EXPECT_NEAR(3.5, line.getY(5.0), 0.01);
+}
+
+TEST(ransac, extract) {
+    Point2d points[400];
+    const uint32_t numPoints = generatePoints(points);
+
+    LineRansac<float64_t> ransac(0.02, 20);
+    Line2d lines[4];
+    uint32_t numInliers[4];
+    ASSERT_EQ(2, ransac.extract(points, numPoints, lines, numInliers, 4));
+
+    EXPECT_NEAR(1.0, lines[0].getY(0.0), 0.01);
+    EXPECT_NEAR(3.0, lines[1].getX(1.0), 0.01);
+    EXPECT_NEAR(3.0, lines[1].getX(4.0), 0.01);
+    EXPECT_GE(numInliers[1], 95);
+
+    // the inliers of the first line have been moved to the end
+    EXPECT_NEAR(0.0, distance(lines[0], points[numPoints - 1]), 0.02);
+}
+
+TEST(ransac, not_enough_inliers) {
+    Point2d points[400];
+    const uint32_t numPoints = generatePoints(points);
+
+    LineRansac<float64_t> ransac(0.02, 250);
+    Line2d line;
+    EXPECT_EQ(0, ransac.fit(points, numPoints, line));
+}
@@ -0,0 +1,76 @@
+#include <babocar-core/scan_geometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace bcr;
+
+namespace {
+
+constexpr uint32_t NUM_BEAMS = 360;
+
+const ScanGeometry<NUM_BEAMS>& geometry() {
+    static const ScanGeometry<NUM_BEAMS> g(-PI, radian_t(2 * PI.get() / NUM_BEAMS), NUM_BEAMS, meter_t(0.05), meter_t(10.0));
+    return g;
+}
+
+void fillRanges(float32_t *ranges) {
+    for (uint32_t i = 0; i < NUM_BEAMS; ++i) {
+        ranges[i] = 1.0f + 0.01f * i;
+    }
+    ranges[3] = std::numeric_limits<float32_t>::quiet_NaN();
+    ranges[10] = 0.01f;     // shorter than minimum range
+    ranges[20] = 10.0f;     // max range - no return
+    ranges[30] = std::numeric_limits<float32_t>::infinity();
+}
+
+} // namespace
+
+TEST(scan_geometry, points) {
+    float32_t ranges[NUM_BEAMS];
+    fillRanges(ranges);
+
+    Point2f points[NUM_BEAMS];
+    uint32_t beams[NUM_BEAMS];
+    const uint32_t n = geometry().toPoints(ranges, points, beams);
+    ASSERT_EQ(NUM_BEAMS - 4, n);
+
+    for (uint32_t k = 0; k < n; ++k) {
+        const uint32_t i = beams[k];
+        EXPECT_TRUE(i != 3 && i != 10 && i != 20 && i != 30);
+        const Point2f expected = Point2f::normVec(geometry().angle(i)) * ranges[i];
+        EXPECT_NEAR(expected.X, points[k].X, 1e-5f);
+        EXPECT_NEAR(expected.Y, points[k].Y, 1e-5f);
+    }
+
+    float32_t x[NUM_BEAMS], y[NUM_BEAMS];
+    ASSERT_EQ(n, geometry().toPoints(ranges, x, y));
+    for (uint32_t k = 0; k < n; ++k) {
+        EXPECT_EQ(points[k].X, x[k]);
+        EXPECT_EQ(points[k].Y, y[k]);
+    }
+}
+
+TEST(scan_geometry, transformed) {
+    float32_t ranges[NUM_BEAMS];
+    fillRanges(ranges);
+
+    const Pose pose = { Point2m(meter_t(2.0), meter_t(-1.0)), radian_t(0.7) };
+    const SE2m transform(pose);
+
+    Point2f local[NUM_BEAMS];
+    Point2m world[NUM_BEAMS];
+    meter_t x[NUM_BEAMS], y[NUM_BEAMS];
+    const uint32_t n = geometry().toPoints(ranges, local);
+    ASSERT_EQ(n, geometry().toPoints(ranges, pose, world));
+    ASSERT_EQ(n, geometry().toPoints(ranges, SE2f(pose), x, y));
+
+    for (uint32_t k = 0; k < n; ++k) {
+        const Point2m expected = transform.apply(Point2m(meter_t(local[k].X), meter_t(local[k].Y)));
+        EXPECT_NEAR(expected.X.get(), world[k].X.get(), 1e-5);
+        EXPECT_NEAR(expected.Y.get(), world[k].Y.get(), 1e-5);
+        EXPECT_NEAR(expected.X.get(), x[k].get(), 1e-5);
+        EXPECT_NEAR(expected.Y.get(), y[k].get(), 1e-5);
+    }
+}
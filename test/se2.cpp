@@ -0,0 +1,87 @@
+#include <babocar-core/se2.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+void expectNear(const Point2m& expected, const Point2m& actual, float64_t eps = 1e-9) {
+    EXPECT_NEAR(expected.X.get(), actual.X.get(), eps);
+    EXPECT_NEAR(expected.Y.get(), actual.Y.get(), eps);
+}
+
+} // namespace
+
+TEST(se2, apply) {
+    const SE2m t(Point2m(meter_t(1.0), meter_t(2.0)), PI_2);
+    expectNear(Point2m(meter_t(1.0), meter_t(3.0)), t.apply(Point2m(meter_t(1.0), meter_t(0.0))));
+    expectNear(Point2m(meter_t(0.0), meter_t(2.0)), t.apply(Point2m(meter_t(0.0), meter_t(1.0))));
+    EXPECT_NEAR(PI_2.get(), t.angle().get(), 1e-12);
+
+    const Pose pose = t.toPose();
+    expectNear(Point2m(meter_t(1.0), meter_t(2.0)), pose.pos);
+    EXPECT_NEAR(PI_2.get(), pose.angle.get(), 1e-12);
+
+    const SE2f f(pose);
+    EXPECT_NEAR(1.0f, f.translation().X, 1e-6f);
+    EXPECT_NEAR(0.0f, f.cos(), 1e-6f);
+    EXPECT_NEAR(1.0f, f.sin(), 1e-6f);
+}
+
+TEST(se2, compose_inverse) {
+    const SE2m a(Point2m(meter_t(0.5), meter_t(-1.0)), radian_t(0.3));
+    const SE2m b(Point2m(meter_t(-2.0), meter_t(0.25)), radian_t(-1.2));
+    const Point2m p(meter_t(0.7), meter_t(1.9));
+
+    expectNear(a.apply(b.apply(p)), (a * b).apply(p));
+    EXPECT_NEAR(-0.9, (a * b).angle().get(), 1e-12);
+
+    expectNear(p, a.inverse().apply(a.apply(p)));
+    expectNear(p, (a * a.inverse()).apply(p));
+    expectNear(Point2m(meter_t(0), meter_t(0)), (b.inverse() * b).translation());
+
+    const SE2m chain[3] = { a, b, a.inverse() };
+    expectNear(a.apply(b.apply(a.inverse().apply(p))), SE2m::chain(chain, 3).apply(p));
+    expectNear(p, SE2m::chain(chain, 0).apply(p));
+}
+
+TEST(se2, compose_drift) {
+    // repeated composition of small rotations (e.g. ICP iterations) - the rotation stays orthonormal
+    const SE2f delta(Point2f(0.001f, 0.0f), radian_t(0.001));
+    SE2f t;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        t = delta.compose(t);
+    }
+    EXPECT_NEAR(1.0f, t.cos() * t.cos() + t.sin() * t.sin(), 1e-6f);
+    EXPECT_NEAR(std::remainder(100.0, 2 * PI.get()), t.angle().get(), 1e-2);
+}
+
+TEST(se2, batch) {
+    const SE2m t(Point2m(meter_t(3.0), meter_t(-1.5)), radian_t(2.1));
+    Point2m points[10], result[10];
+    meter_t x[10], y[10];
+    for (uint32_t i = 0; i < 10; ++i) {
+        points[i] = Point2m(meter_t(0.1 * i), meter_t(1.0 - 0.3 * i));
+        x[i] = points[i].X;
+        y[i] = points[i].Y;
+    }
+
+    t.apply(points, result, 10);
+    t.apply(x, y, x, y, 10);
+    for (uint32_t i = 0; i < 10; ++i) {
+        expectNear(t.apply(points[i]), result[i]);
+        expectNear(t.apply(points[i]), Point2m(x[i], y[i]));
+    }
+}
+
+TEST(se2, line) {
+    const SE2d t(Point2d(1.0, -2.0), radian_t(0.8));
+    const Point2d p1(0.5, 0.5), p2(-1.5, 2.0);
+    const Line2d line = t.apply(Line2d(p1, p2));
+
+    for (const Point2d& p : { p1, p2 }) {
+        const Point2d q = t.apply(p);
+        EXPECT_NEAR(0.0, line.a * q.X + line.b * q.Y + line.c, 1e-12);
+    }
+}
@@ -0,0 +1,134 @@
+#include <babocar-core/random.hpp>
+#include <babocar-core/segment_extractor.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+typedef SegmentExtractor<float32_t> extractor_type;
+
+// samples the polyline between the corners with the given spacing, the corners are included
+uint32_t samplePolyline(const Point2f *corners, uint32_t numCorners, float32_t spacing, Point2f *points) {
+    uint32_t n = 0;
+    for (uint32_t c = 0; c + 1 < numCorners; ++c) {
+        const Point2f& a = corners[c];
+        const Point2f& b = corners[c + 1];
+        const uint32_t steps = static_cast<uint32_t>(std::round(std::hypot(b.X - a.X, b.Y - a.Y) / spacing));
+        for (uint32_t i = c == 0 ? 0 : 1; i <= steps; ++i) {
+            const float32_t t = static_cast<float32_t>(i) / steps;
+            points[n++] = Point2f(a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t);
+        }
+    }
+    return n;
+}
+
+} // namespace
+
+TEST(segment_extractor, corners) {
+    const Point2f corners[] = { { 0.0f, 0.0f }, { 2.0f, 0.0f }, { 2.0f, 1.0f }, { 4.0f, 3.0f } };
+    Point2f points[512];
+    const uint32_t numPoints = samplePolyline(corners, 4, 0.02f, points);
+    ASSERT_EQ(100 + 50 + 141 + 1, numPoints);
+
+    extractor_type extractor(0.02f, 0.01f, 0.1f);
+    extractor_type::Segment segments[8];
+    ASSERT_EQ(3, extractor.extract(points, numPoints, segments, 8));
+
+    // the corners belong to the first of the adjacent segments
+    const uint32_t last[] = { 100, 150, numPoints - 1 };
+    for (uint32_t s = 0; s < 3; ++s) {
+        EXPECT_EQ(s == 0 ? 0 : last[s - 1] + 1, segments[s].first);
+        EXPECT_EQ(last[s], segments[s].last);
+        EXPECT_NEAR(0.0f, segments[s].residual, 1e-4f);
+        EXPECT_NEAR(corners[s + 1].X, segments[s].end.X, 1e-4f);
+        EXPECT_NEAR(corners[s + 1].Y, segments[s].end.Y, 1e-4f);
+        EXPECT_NEAR(0.0f, segments[s].line.a * segments[s].start.X + segments[s].line.b * segments[s].start.Y + segments[s].line.c, 1e-4f);
+    }
+    EXPECT_NEAR(0.0f, segments[0].start.X, 1e-4f);
+    EXPECT_NEAR(0.0f, segments[0].start.Y, 1e-4f);
+    EXPECT_NEAR(1.0f, std::abs(segments[1].line.a), 1e-4f);   // vertical
+}
+
+TEST(segment_extractor, gaps) {
+    // two collinear walls with a gap between them
+    Point2f points[200];
+    for (uint32_t i = 0; i < 100; ++i) {
+        points[i] = Point2f(0.02f * i, 1.0f);
+        points[100 + i] = Point2f(3.0f + 0.02f * i, 1.0f);
+    }
+
+    extractor_type extractor(0.02f, 0.01f, 0.1f);
+    extractor_type::Segment segments[8];
+    ASSERT_EQ(2, extractor.extract(points, 200, segments, 8));
+    EXPECT_EQ(99, segments[0].last);
+    EXPECT_EQ(100, segments[1].first);
+
+    // without the gap limit, the walls form a single segment
+    extractor_type noGaps(0.02f, 0.01f, 10.0f);
+    ASSERT_EQ(1, noGaps.extract(points, 200, segments, 8));
+    EXPECT_EQ(0, segments[0].first);
+    EXPECT_EQ(199, segments[0].last);
+}
+
+TEST(segment_extractor, merge_noisy) {
+    // the noise makes the chord test split the wall, the pieces are merged back by the fit
+    const Point2f corners[] = { { 0.0f, 0.0f }, { 4.0f, 2.0f } };
+    Point2f points[512];
+    const uint32_t numPoints = samplePolyline(corners, 2, 0.01f, points);
+    xorshift32 random(5);
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        points[i].X += 0.005f * random.normal();
+        points[i].Y += 0.005f * random.normal();
+    }
+
+    extractor_type::Segment segments[32];
+    extractor_type noMerge(0.015f, 0.0f, 0.1f);
+    EXPECT_GT(noMerge.extract(points, numPoints, segments, 32), 1);
+
+    extractor_type extractor(0.015f, 0.01f, 0.1f);
+    ASSERT_EQ(1, extractor.extract(points, numPoints, segments, 32));
+    EXPECT_EQ(0, segments[0].first);
+    EXPECT_EQ(numPoints - 1, segments[0].last);
+    EXPECT_NEAR(0.005f, segments[0].residual, 0.001f);
+    EXPECT_NEAR(0.5f, -segments[0].line.a / segments[0].line.b, 0.01f);
+}
+
+TEST(segment_extractor, limits) {
+    // short clusters are dropped
+    Point2f points[64];
+    for (uint32_t i = 0; i < 3; ++i) {
+        points[i] = Point2f(0.01f * i, 0.0f);
+    }
+    for (uint32_t i = 3; i < 23; ++i) {
+        points[i] = Point2f(1.0f, 0.01f * i);
+    }
+
+    extractor_type extractor(0.02f, 0.01f, 0.1f);
+    extractor_type::Segment segments[8];
+    ASSERT_EQ(1, extractor.extract(points, 23, segments, 8));
+    EXPECT_EQ(3, segments[0].first);
+
+    // the number of segments is limited - a zigzag would give 8 segments
+    const Point2f corners[] = { { 0.0f, 0.0f }, { 1.0f, 1.0f }, { 2.0f, 0.0f }, { 3.0f, 1.0f }, { 4.0f, 0.0f },
+        { 5.0f, 1.0f }, { 6.0f, 0.0f }, { 7.0f, 1.0f }, { 8.0f, 0.0f } };
+    Point2f zigzag[1024];
+    const uint32_t numPoints = samplePolyline(corners, 9, 0.02f, zigzag);
+    EXPECT_EQ(8, extractor.extract(zigzag, numPoints, segments, 8));
+    EXPECT_EQ(5, extractor.extract(zigzag, numPoints, segments, 5));
+    EXPECT_EQ(0, extractor.extract(zigzag, 0, segments, 5));
+}
+
+TEST(segment_extractor, units) {
+    Point2m points[50];
+    for (uint32_t i = 0; i < 50; ++i) {
+        points[i] = Point2m(centimeter_t(2 * i), meter_t(1));
+    }
+
+    SegmentExtractor<meter_t> extractor(centimeter_t(2), centimeter_t(1), centimeter_t(10));
+    SegmentExtractor<meter_t>::Segment segments[2];
+    ASSERT_EQ(1, extractor.extract(points, 50, segments, 2));
+    EXPECT_NEAR(0.98, segments[0].end.X.get(), 1e-9);
+    EXPECT_NEAR(1.0, segments[0].end.Y.get(), 1e-9);
+}
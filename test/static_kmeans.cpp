@@ -0,0 +1,64 @@
+#include <babocar-core/static_kmeans.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+template <uint32_t capacity>
+void fillTwoClusters(vec<Point2m, capacity>& points) {
+    for (uint32_t i = 0; i < 5; ++i) {
+        points.append(Point2m(centimeter_t(i), centimeter_t(0)));
+        points.append(Point2m(centimeter_t(100 + i), centimeter_t(100)));
+    }
+}
+
+} // namespace
+
+TEST(static_kmeans, two_groups) {
+    vec<Point2m, 16> points;
+    fillTwoClusters(points);
+
+    StaticKMeans<16, 4> kmeans(points);
+    EXPECT_GT(20, kmeans.run(2));
+    ASSERT_EQ(2, kmeans.centers().size());
+
+    const uint8_t g0 = kmeans.label(0), g1 = kmeans.label(1);
+    EXPECT_NE(g0, g1);
+    EXPECT_EQ(5, kmeans.groupSize(g0));
+    EXPECT_EQ(5, kmeans.groupSize(g1));
+    EXPECT_NEAR(0.02, kmeans.centers()[g0].X.get(), 0.0001);
+    EXPECT_NEAR(1.02, kmeans.centers()[g1].X.get(), 0.0001);
+
+    vec<Point2m, 8> members;
+    EXPECT_EQ(5, kmeans.getMembers(g1, members));
+    EXPECT_EQ(points[1], members[0]);
+}
+
+TEST(static_kmeans2, threshold) {
+    vec<Point2m, 16> points;
+    fillTwoClusters(points);
+    points.append(Point2m(meter_t(5), meter_t(5)));
+
+    StaticKMeans2<16, 4> kmeans(points, centimeter_t(2));
+    ASSERT_EQ(3, kmeans.run());
+
+    const uint8_t g0 = kmeans.label(0), g1 = kmeans.label(1), g2 = kmeans.label(10);
+    EXPECT_EQ(5, kmeans.groupSize(g0));
+    EXPECT_EQ(5, kmeans.groupSize(g1));
+    EXPECT_EQ(1, kmeans.groupSize(g2));
+    EXPECT_NEAR(1.02, kmeans.center(g1).X.get(), 0.0001);
+}
+
+TEST(static_kmeans2, max_groups) {
+    vec<Point2m, 16> points;
+    fillTwoClusters(points);
+    points.append(Point2m(meter_t(5), meter_t(5)));
+
+    StaticKMeans2<16, 2> kmeans(points, centimeter_t(2));
+    EXPECT_EQ(2, kmeans.run());
+    EXPECT_EQ((StaticKMeans2<16, 2>::NO_GROUP), kmeans.label(10));
+    EXPECT_EQ(0, kmeans.groupSize(StaticKMeans2<16, 2>::NO_GROUP));
+    EXPECT_EQ(0.0, kmeans.center(StaticKMeans2<16, 2>::NO_GROUP).X.get());
+}
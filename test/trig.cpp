@@ -0,0 +1,73 @@
+#include <babocar-core/unit_utils.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+template <typename policy, typename T>
+void checkSinCos(T maxErr) {
+    T maxErrSin = 0, maxErrCos = 0;
+    for (int32_t i = -200000; i <= 200000; ++i) {
+        const T angle = static_cast<T>(i * 0.0005);
+        T s, c;
+        policy::sincos(angle, s, c);
+        maxErrSin = std::max(maxErrSin, std::abs(s - static_cast<T>(std::sin(static_cast<float64_t>(angle)))));
+        maxErrCos = std::max(maxErrCos, std::abs(c - static_cast<T>(std::cos(static_cast<float64_t>(angle)))));
+    }
+    EXPECT_LT(maxErrSin, maxErr);
+    EXPECT_LT(maxErrCos, maxErr);
+}
+
+template <typename policy, typename T>
+void checkAtan2(T maxErr) {
+    T maxErrAtan2 = 0;
+    for (int32_t i = 0; i < 100000; ++i) {
+        const float64_t angle = i * 0.0000628318530718 - 3.14159265358979;
+        for (float64_t r = 0.001; r < 1000.0; r *= 10.0) {
+            const T y = static_cast<T>(r * std::sin(angle)), x = static_cast<T>(r * std::cos(angle));
+            maxErrAtan2 = std::max(maxErrAtan2, std::abs(policy::atan2(y, x) - static_cast<T>(std::atan2(static_cast<float64_t>(y), static_cast<float64_t>(x)))));
+        }
+    }
+    EXPECT_LT(maxErrAtan2, maxErr);
+}
+
+} // namespace
+
+TEST(trig, fast_sincos) {
+    checkSinCos<fast_trig, float64_t>(5e-9);
+    checkSinCos<fast_trig, float32_t>(3e-7f);
+    checkSinCos<coarse_trig, float64_t>(1.2e-6);
+    checkSinCos<coarse_trig, float32_t>(1.5e-6f);
+}
+
+TEST(trig, fast_atan2) {
+    checkAtan2<fast_trig, float64_t>(2e-8);
+    checkAtan2<fast_trig, float32_t>(5e-7f);
+    checkAtan2<coarse_trig, float64_t>(1.2e-5);
+    checkAtan2<coarse_trig, float32_t>(1.5e-5f);
+}
+
+TEST(trig, special_values) {
+    EXPECT_EQ(0.0, fast_trig::atan2(0.0, 0.0));
+    EXPECT_NEAR(PI.get(), fast_trig::atan2(0.0, -1.0), 1e-12);
+    EXPECT_NEAR(PI_2.get(), fast_trig::atan2(1.0, 0.0), 1e-12);
+    EXPECT_NEAR(-PI_2.get(), fast_trig::atan2(-1.0, 0.0), 1e-12);
+    EXPECT_NEAR(1.0, fast_trig::sin(PI_2.get()), 1e-9);
+    EXPECT_NEAR(-1.0, fast_trig::cos(PI.get()), 1e-9);
+}
+
+TEST(trig, units) {
+    float64_t s, c;
+    bcr::sincos<fast_trig>(degree_t(30), s, c);
+    EXPECT_NEAR(0.5, s, 1e-8);
+    EXPECT_NEAR(std::sqrt(3.0) / 2, c, 1e-8);
+    EXPECT_NEAR(45.0, static_cast<degree_t>(bcr::atan2<fast_trig>(meter_t(1), centimeter_t(100))).get(), 1e-6);
+
+    const radian_t angles[] = { radian_t(0), PI_2, PI };
+    float64_t sins[3], coss[3];
+    bcr::sincos<coarse_trig>(angles, sins, coss, 3);
+    EXPECT_NEAR(1.0, sins[1], 1e-6);
+    EXPECT_NEAR(-1.0, coss[2], 1e-6);
+}
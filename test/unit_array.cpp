@@ -0,0 +1,82 @@
+#include <babocar-core/container/unit_array.hpp>
+#include <babocar-core/unit_utils.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+TEST(unit_array, elementwise) {
+    unit_array<meter_t, 5> a;
+    unit_array<centimeter_t, 5> b;
+    for (uint32_t i = 0; i < 5; ++i) {
+        a[i] = meter_t(i + 1.0);
+        b[i] = centimeter_t(10.0 * i);
+    }
+
+    const unit_array<meter_t, 5> sum = a + b;
+    const unit_array<meter_t, 5> diff = a - b;
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(i + 1.0 + 0.1 * i, sum[i].get(), detail::COMMON_EQ_ABS_EPS);
+        EXPECT_NEAR(i + 1.0 - 0.1 * i, diff[i].get(), detail::COMMON_EQ_ABS_EPS);
+    }
+
+    unit_array<second_t, 5> t(second_t(0.5));
+    const auto v = a / t;
+    static_assert(decltype(v)::value_type::dim == Dimension::speed, "Result must be speed");
+    const auto s = v * t;
+    static_assert(decltype(s)::value_type::dim == Dimension::distance, "Result must be distance");
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(2 * (i + 1.0), m_per_sec_t(v[i]).get(), detail::COMMON_EQ_ABS_EPS);
+        EXPECT_NEAR(i + 1.0, meter_t(s[i]).get(), detail::COMMON_EQ_ABS_EPS);
+    }
+
+    unit_array<meter_t, 5> c = 2 * a;
+    c -= a;
+    c += b;
+    c *= 0.5;
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(sum[i].get() / 2, c[i].get(), detail::COMMON_EQ_ABS_EPS);
+        EXPECT_NEAR(sum[i].get() / 4, (sum / 4)[i].get(), detail::COMMON_EQ_ABS_EPS);
+    }
+}
+
+TEST(unit_array, span_units) {
+    meter_t m[3] = { meter_t(1.0), meter_t(2.0), meter_t(3.0) };
+    cm_per_sec_t v[3] = { cm_per_sec_t(10.0), cm_per_sec_t(20.0), cm_per_sec_t(30.0) };
+    millisecond_t t[3];
+    centimeter_t cm[3];
+
+    // result units differ from the units of the operands
+    divide(unit_span<const meter_t>(m), unit_span<cm_per_sec_t>(v), unit_span<millisecond_t>(t));
+    multiply(unit_span<cm_per_sec_t>(v), unit_span<millisecond_t>(t), unit_span<centimeter_t>(cm));
+    scale(unit_span<meter_t>(m).subspan(0, 2), 2.0, unit_span<centimeter_t>(cm).subspan(1, 2));
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(10000.0, t[i].get(), 1e-6);
+    }
+    EXPECT_NEAR(100.0, cm[0].get(), 1e-6);
+    EXPECT_NEAR(200.0, cm[1].get(), 1e-6);
+    EXPECT_NEAR(400.0, cm[2].get(), 1e-6);
+
+    meter_f_t f[3];
+    add(unit_span<meter_f_t>(f), unit_span<meter_t>(m).subspan(0, 3), unit_span<meter_t>(m));
+    EXPECT_NEAR(3.0, m[2].get(), detail::COMMON_EQ_ABS_EPS);
+}
+
+TEST(unit_array, reductions) {
+    unit_array<meter_f_t, 11> a;
+    unit_array<radian_f_t, 11> b;
+    for (uint32_t i = 0; i < 11; ++i) {
+        a[i] = meter_f_t(static_cast<float32_t>(i) - 3.0f);
+        b[i] = radian_f_t(0.5f);
+    }
+
+    EXPECT_NEAR(22.0f, sum(a.span()).get(), detail::COMMON_EQ_ABS_EPS);
+    EXPECT_EQ(meter_f_t(-3.0f), min(a.span()));
+    EXPECT_EQ(meter_f_t(7.0f), max(a.span()));
+    EXPECT_EQ(meter_f_t(3.0f), max(a.span().subspan(2, 5)));
+
+    const auto d = dot(a.span(), b.span());
+    static_assert(decltype(d)::dim == Dimension::distance, "Result must be distance");
+    static_assert(std::is_same<decltype(d)::storage_type, float32_t>::value, "Result must be stored as float32_t");
+    EXPECT_NEAR(11.0f, meter_t(d).get(), detail::COMMON_EQ_ABS_EPS);
+}
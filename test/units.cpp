@@ -1,4 +1,4 @@
-#include <babocar-core/unit_utils.hpp>
+#include <babocar-core/point2.hpp>
 
 #include <gtest/gtest.h>
 
@@ -78,3 +78,40 @@ TEST(units, unit_mul) {
     constexpr meter_t s2 = v * t;
     EXPECT_NEAR(0.02f, s2.get(), detail::COMMON_EQ_ABS_EPS);
 }
+
+TEST(units, mixed_precision) {
+    static_assert(sizeof(meter_f_t) == sizeof(float32_t), "meter_f_t must be stored as float32_t");
+    static_assert(sizeof(Point2m_f) == 2 * sizeof(float32_t), "Point2m_f must be stored as two float32_t values");
+    static_assert(std::is_convertible<meter_f_t, meter_t>::value, "Widening conversion must be implicit");
+    static_assert(!std::is_convertible<meter_t, meter_f_t>::value, "Narrowing conversion must be explicit");
+
+    constexpr centimeter_f_t cm(150.0f);
+    constexpr meter_t m = cm;
+    EXPECT_NEAR(1.5, m.get(), detail::COMMON_EQ_ABS_EPS);
+    EXPECT_NEAR(1.5f, static_cast<meter_f_t>(m).get(), detail::COMMON_EQ_ABS_EPS);
+
+    // the result has the type of the first operand
+    const meter_t sum = meter_t(1.0) + cm;
+    EXPECT_NEAR(2.5, sum.get(), detail::COMMON_EQ_ABS_EPS);
+    const meter_f_t diff = meter_f_t(1.0f) - meter_f_t(meter_t(0.25));
+    EXPECT_NEAR(0.75f, diff.get(), detail::COMMON_EQ_ABS_EPS);
+    EXPECT_TRUE(meter_t(1.0) < cm);
+
+    // multiplication of different dimensions uses the wider storage type
+    const auto s = m_per_sec_f_t(2.0f) * second_t(0.5);
+    static_assert(std::is_same<decltype(s)::storage_type, float64_t>::value, "Result must be stored as float64_t");
+    EXPECT_NEAR(1.0, meter_t(s).get(), detail::COMMON_EQ_ABS_EPS);
+
+    const auto v = meter_f_t(3.0f) / second_f_t(2.0f);
+    static_assert(std::is_same<decltype(v)::storage_type, float32_t>::value, "Result must be stored as float32_t");
+    EXPECT_NEAR(1.5f, m_per_sec_f_t(v).get(), detail::COMMON_EQ_ABS_EPS);
+
+    // multiplication by a constant keeps the storage type
+    static_assert(std::is_same<decltype(meter_f_t(1.0f) * 2.0)::storage_type, float32_t>::value, "Result must be stored as float32_t");
+
+    const Point2m_f p(meter_f_t(1.0f), meter_f_t(2.0f));
+    const Point2m q = static_cast<Point2m>(p) + Point2m(meter_t(0.5), meter_t(0.5));
+    EXPECT_NEAR(1.5, q.X.get(), detail::COMMON_EQ_ABS_EPS);
+    EXPECT_NEAR(2.5, q.Y.get(), detail::COMMON_EQ_ABS_EPS);
+    EXPECT_NEAR(2.236068f, p.length().get(), detail::COMMON_EQ_ABS_EPS);
+}
@@ -0,0 +1,160 @@
+#include <babocar-core/vehicle_sim.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace bcr;
+
+namespace {
+
+Odometry origin() {
+    Odometry odom;
+    odom.pose = { Point2m(meter_t(0), meter_t(0)), radian_t(0) };
+    odom.twist = { Point2mps(m_per_sec_t(0), m_per_sec_t(0)), rad_per_sec_t(0) };
+    return odom;
+}
+
+} // namespace
+
+TEST(vehicle_sim, straight) {
+    VehicleSimParams params;
+    params.speedTimeConstant = millisecond_t(100);
+    VehicleSim sim(params, origin());
+
+    EXPECT_EQ(100, sim.run([](const VehicleMeasurement&) { return VehicleControl{ m_per_sec_t(1), radian_t(0) }; }, millisecond_t(100)));
+    EXPECT_NEAR(100.0, sim.time().get(), 1e-9);
+    EXPECT_NEAR(1.0 - std::exp(-1.0), sim.odometry().twist.speed.X.get(), 1e-9);
+    EXPECT_NEAR(0.0, sim.odometry().pose.pos.Y.get(), 1e-12);
+    EXPECT_NEAR(1.0 - std::exp(-1.0), sim.measurement().speed.get(), 1e-9);
+}
+
+TEST(vehicle_sim, circle) {
+    VehicleSimParams params;
+    params.wheelbase = meter_t(0.25);
+    params.maxSteeringAngle = degree_t(30);
+    params.maxSteeringRate = deg_per_sec_t(300);
+    VehicleSim sim(params, origin());
+
+    // the steering angle is rate limited, it reaches the 20 degree target in 67 ms, the command above the limit is clamped
+    sim.step({ m_per_sec_t(0), degree_t(20) });
+    EXPECT_NEAR(static_cast<radian_t>(degree_t(0.3)).get(), sim.steeringAngle().get(), 1e-12);
+    sim.run([](const VehicleMeasurement&) { return VehicleControl{ m_per_sec_t(0), degree_t(40) }; }, millisecond_t(200));
+    EXPECT_NEAR(static_cast<radian_t>(degree_t(30)).get(), sim.steeringAngle().get(), 1e-12);
+
+    // at constant steering angle the vehicle moves on a circle of radius wheelbase / tan(angle)
+    sim.reset(origin());
+    sim.run([](const VehicleMeasurement&) { return VehicleControl{ m_per_sec_t(1), degree_t(30) }; }, millisecond_t(1000));
+    const Point2m center = sim.odometry().pose.pos + Vec2m(meter_t(0), meter_t(0.25 / std::tan(PI.get() / 6))).rotate(sim.odometry().pose.angle);
+    const float64_t radius = 0.25 / std::tan(PI.get() / 6);
+    for (uint32_t i = 0; i < 10; ++i) {
+        sim.run([](const VehicleMeasurement&) { return VehicleControl{ m_per_sec_t(1), degree_t(30) }; }, millisecond_t(300));
+        EXPECT_NEAR(radius, sim.odometry().pose.pos.distance(center).get(), 1e-6);
+        EXPECT_NEAR(1.0 / radius, sim.odometry().twist.ang_vel.get(), 1e-4);   // speed is still converging
+    }
+}
+
+TEST(vehicle_sim, measurements) {
+    VehicleSimParams params;
+    params.speedNoise = m_per_sec_t(0.1);
+    params.angVelNoise = rad_per_sec_t(0.1);
+    params.sensorLatency = millisecond_t(5);
+    params.posePeriod = millisecond_t(20);
+    params.poseLatency = millisecond_t(30);
+    params.posePosNoise = meter_t(0.01);
+    params.poseAngleNoise = radian_t(0.01);
+    params.seed = 7;
+
+    VehicleSim sim1(params, origin()), sim2(params, origin());
+    uint32_t numPoses = 0;
+    for (uint32_t i = 0; i < 100; ++i) {
+        const VehicleControl control = { m_per_sec_t(1), degree_t(10) };
+        sim1.step(control);
+        sim2.step(control);
+
+        const VehicleMeasurement& m = sim1.measurement();
+        EXPECT_EQ(m.speed, sim2.measurement().speed);   // deterministic
+        if (i >= 5) {
+            EXPECT_NEAR(m.time.get() - 5.0, m.sensorTime.get(), 1e-9);
+        }
+        if (m.hasPose) {
+            ++numPoses;
+            EXPECT_NEAR(m.time.get() - 30.0, m.poseTime.get(), 1e-9);
+            EXPECT_EQ(m.pose.pos.X, sim2.measurement().pose.pos.X);
+        }
+    }
+    EXPECT_EQ(4, numPoses); // taken at 0, 20, 40 and 60 ms, delivered at 30, 50, 70 and 90 ms
+
+    params.seed = 8;
+    VehicleSim sim3(params, origin());
+    sim3.step({ m_per_sec_t(1), degree_t(10) });
+    sim1.reset(origin());
+    sim1.step({ m_per_sec_t(1), degree_t(10) });
+    EXPECT_NE(sim1.measurement().speed, sim3.measurement().speed);
+}
+
+TEST(vehicle_sim, long_latencies) {
+    // the sensor latency is 500 steps, and 51 pose measurements are waiting for delivery at the same time
+    VehicleSimParams params;
+    params.sensorLatency = millisecond_t(500);
+    params.posePeriod = millisecond_t(1);
+    params.poseLatency = millisecond_t(50);
+
+    VehicleSim sim(params, origin());
+    uint32_t numPoses = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        sim.step({ m_per_sec_t(1), degree_t(0) });
+
+        const VehicleMeasurement& m = sim.measurement();
+        if (i >= 500) {
+            EXPECT_NEAR(m.time.get() - 500.0, m.sensorTime.get(), 1e-9);
+        }
+        if (m.hasPose) {
+            ++numPoses;
+            EXPECT_NEAR(m.time.get() - 50.0, m.poseTime.get(), 1e-9);
+        }
+    }
+    EXPECT_EQ(951, numPoses);   // every pose taken from 0 to 950 ms is delivered
+}
+
+TEST(vehicle_sim, parseScenario) {
+    const char *text =
+        "# test track\n"
+        "seed 42\n"
+        "step_ms 2\n"
+        "duration_s 30   # half a minute\n"
+        "wheelbase_m 0.3\n"
+        "max_steering_deg 20\n"
+        "pose_period_ms 100\n"
+        "ang_vel_noise_deg_per_s 1\n"
+        "target_speed_mps 2.5\n"
+        "\n"
+        "start 1 2 90\n"
+        "point 0 0\n"
+        "point 10 0\n"
+        "point 10 5";
+
+    VehicleScenario scenario;
+    uint32_t errorLine;
+    ASSERT_EQ(Status::OK, parseScenario(text, scenario, &errorLine));
+    EXPECT_EQ(0, errorLine);
+    EXPECT_EQ(42, scenario.params.seed);
+    EXPECT_NEAR(2.0, scenario.params.step.get(), 1e-12);
+    EXPECT_NEAR(30000.0, scenario.duration.get(), 1e-9);
+    EXPECT_NEAR(0.3, scenario.params.wheelbase.get(), 1e-12);
+    EXPECT_NEAR(PI.get() / 9, scenario.params.maxSteeringAngle.get(), 1e-8);
+    EXPECT_NEAR(100.0, scenario.params.posePeriod.get(), 1e-12);
+    EXPECT_NEAR(PI.get() / 180, scenario.params.angVelNoise.get(), 1e-8);
+    EXPECT_NEAR(2.5, scenario.targetSpeed.get(), 1e-12);
+    EXPECT_NEAR(2.0, scenario.start.pose.pos.Y.get(), 1e-12);
+    EXPECT_NEAR(PI.get() / 2, scenario.start.pose.angle.get(), 1e-8);
+    ASSERT_EQ(3, scenario.path.size());
+    EXPECT_NEAR(5.0, scenario.path[2].Y.get(), 1e-12);
+    EXPECT_NEAR(0.0, scenario.params.speedNoise.get(), 1e-12); // default
+
+    VehicleScenario invalid;
+    EXPECT_EQ(Status::INVALID_DATA, parseScenario("seed 1\nwheelbase 0.3\n", invalid, &errorLine));
+    EXPECT_EQ(2, errorLine);
+    EXPECT_EQ(Status::INVALID_DATA, parseScenario("start 1 2\n", invalid, &errorLine));
+    EXPECT_EQ(1, errorLine);
+
+    EXPECT_EQ(Status::ERROR, loadScenario("/nonexistent/scenario.txt", invalid));
+}